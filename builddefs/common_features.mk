@@ -347,7 +347,7 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
 
     COMMON_VPATH += $(QUANTUM_DIR)/led_matrix
     COMMON_VPATH += $(QUANTUM_DIR)/led_matrix/animations
-    COMMON_VPATH += $(QUANTUM_DIR)/led_matrix/animations/runners
+    COMMON_VPATH += $(QUANTUM_DIR)/lighting
     POST_CONFIG_H += $(QUANTUM_DIR)/led_matrix/post_config.h
     SRC += $(QUANTUM_DIR)/process_keycode/process_led_matrix.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix.c
@@ -462,7 +462,7 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
 
     COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix
     COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix/animations
-    COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix/animations/runners
+    COMMON_VPATH += $(QUANTUM_DIR)/lighting
     POST_CONFIG_H += $(QUANTUM_DIR)/rgb_matrix/post_config.h
 
     # TODO: Remove this
@@ -639,6 +639,12 @@ ifeq ($(strip $(DYNAMIC_KEYMAP_ENABLE)), yes)
     SEND_STRING_ENABLE := yes
 endif
 
+ifeq ($(strip $(RAW_HID_STREAM_ENABLE)), yes)
+    RAW_ENABLE := yes
+    OPT_DEFS += -DRAW_HID_STREAM_ENABLE
+    SRC += $(QUANTUM_DIR)/raw_hid_stream.c
+endif
+
 VALID_CUSTOM_MATRIX_TYPES:= yes lite no
 
 CUSTOM_MATRIX ?= no
@@ -682,7 +688,8 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
     # Determine which (if any) transport files are required
     ifneq ($(strip $(SPLIT_TRANSPORT)), custom)
         QUANTUM_SRC += $(QUANTUM_DIR)/split_common/transport.c \
-                       $(QUANTUM_DIR)/split_common/transactions.c
+                       $(QUANTUM_DIR)/split_common/transactions.c \
+                       $(QUANTUM_DIR)/split_common/split_pointing.c
 
         OPT_DEFS += -DSPLIT_COMMON_TRANSACTIONS
 
@@ -907,7 +914,7 @@ endif
 
 ENCODER_ENABLE ?= no
 ENCODER_DRIVER ?= quadrature
-VALID_ENCODER_DRIVER_TYPES := quadrature custom
+VALID_ENCODER_DRIVER_TYPES := quadrature timer custom
 ifeq ($(strip $(ENCODER_ENABLE)), yes)
     ifeq ($(filter $(ENCODER_DRIVER),$(VALID_ENCODER_DRIVER_TYPES)),)
         $(call CATASTROPHIC_ERROR,Invalid ENCODER_DRIVER,ENCODER_DRIVER="$(ENCODER_DRIVER)" is not a valid encoder driver)
@@ -66,6 +66,7 @@ OTHER_OPTION_NAMES = \
   PS2_MOUSE_ENABLE \
   PS2_DRIVER \
   RAW_ENABLE \
+  RAW_HID_STREAM_ENABLE \
   SWAP_HANDS_ENABLE \
   WATCHDOG_ENABLE \
   ERGOINU \
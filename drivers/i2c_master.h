@@ -138,4 +138,62 @@ i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* dat
  */
 i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout);
 
+#if defined(I2C_ASYNC_ENABLE) || defined(__DOXYGEN__)
+
+#    include <stdbool.h>
+
+#    define I2C_STATUS_PENDING (-3)
+
+/**
+ * \brief A single transfer within an asynchronous transfer chain.
+ *
+ * Outgoing data is sent as `reg` (if `reg_length` is nonzero, big endian), followed by `tx_data`. If `rx_length` is nonzero, a repeated start is issued and `rx_data` is filled.
+ *
+ * Transfers, and the buffers they point to, must remain valid until the chain has completed.
+ */
+typedef struct i2c_async_transfer_t {
+    struct i2c_async_transfer_t* next;       /**< The next transfer in the chain, or `NULL`. */
+    uint8_t                      address;    /**< The 7-bit I2C address of the device, shifted left by one. */
+    uint8_t                      reg_length; /**< The number of register address bytes to send first: 0, 1 or 2. */
+    uint16_t                     reg;        /**< The register address. */
+    const uint8_t*               tx_data;    /**< A pointer to the data to transmit. */
+    uint16_t                     tx_length;  /**< The number of bytes to write. */
+    uint8_t*                     rx_data;    /**< A pointer to a buffer to read into. */
+    uint16_t                     rx_length;  /**< The number of bytes to read. */
+    uint16_t                     timeout;    /**< The time in milliseconds to wait for a response from the target device. */
+    volatile i2c_status_t        status;     /**< `I2C_STATUS_PENDING` until the transfer has been executed. */
+} i2c_async_transfer_t;
+
+/**
+ * \brief Queue a chain of transfers to be executed in the background.
+ *
+ * The transfers are executed back-to-back in order. If one fails, the remaining transfers in the chain are skipped and marked with the same status.
+ *
+ * \param chain The first transfer of the chain.
+ *
+ * \return `true` if the chain was queued, `false` if the queue is full.
+ */
+bool i2c_async_submit(i2c_async_transfer_t* chain);
+
+/**
+ * \brief Check whether every transfer in a previously submitted chain has been executed.
+ *
+ * \param chain The first transfer of the chain.
+ *
+ * \return `true` if the chain has completed (successfully or not).
+ */
+bool i2c_async_is_complete(const i2c_async_transfer_t* chain);
+
+/**
+ * \brief Wait for a previously submitted chain to complete.
+ *
+ * \param chain The first transfer of the chain.
+ * \param timeout The time in milliseconds to wait for the chain, or `I2C_TIMEOUT_INFINITE`.
+ *
+ * \return `I2C_STATUS_TIMEOUT` if the chain did not complete in time, otherwise the status of the first failed transfer, or `I2C_STATUS_SUCCESS`.
+ */
+i2c_status_t i2c_async_wait(const i2c_async_transfer_t* chain, uint16_t timeout);
+
+#endif // defined(I2C_ASYNC_ENABLE) || defined(__DOXYGEN__)
+
 /** \} */
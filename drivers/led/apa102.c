@@ -15,6 +15,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "apa102.h"
 #include "gpio.h"
 
@@ -134,6 +135,19 @@ void apa102_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     }
 }
 
+void apa102_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue) {
+    start = MAX(start, 0);
+    end   = MIN(end, APA102_LED_COUNT);
+    for (int i = start; i < end; i++) {
+        apa102_set_color(i, red, green, blue);
+    }
+}
+
+void apa102_write_frame(const rgb_t *colors, int count) {
+    // The buffer already holds rgb_t, so a frame is copied as is
+    memcpy(apa102_leds, colors, MIN(count, APA102_LED_COUNT) * sizeof(rgb_t));
+}
+
 void apa102_flush(void) {
     apa102_start_frame();
     for (uint8_t i = 0; i < APA102_LED_COUNT; i++) {
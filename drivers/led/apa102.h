@@ -34,6 +34,8 @@
 void apa102_init(void);
 void apa102_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void apa102_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+void apa102_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue);
+void apa102_write_frame(const rgb_t *colors, int count);
 void apa102_flush(void);
 
 void apa102_set_brightness(uint8_t brightness);
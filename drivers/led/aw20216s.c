@@ -136,7 +136,7 @@ void aw20216s_init(pin_t cs_pin) {
     aw20216s_auto_lowpower(cs_pin);
 }
 
-void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+static void set_led_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     aw20216s_led_t led;
     memcpy_P(&led, (&g_aw20216s_leds[index]), sizeof(led));
 
@@ -150,12 +150,31 @@ void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     driver_buffers[led.driver].pwm_buffer_dirty  = true;
 }
 
+void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    set_led_color(index, red, green, blue);
+}
+
 void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     for (uint8_t i = 0; i < AW20216S_LED_COUNT; i++) {
         aw20216s_set_color(i, red, green, blue);
     }
 }
 
+void aw20216s_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue) {
+    start = MAX(start, 0);
+    end   = MIN(end, AW20216S_LED_COUNT);
+    for (int i = start; i < end; i++) {
+        set_led_color(i, red, green, blue);
+    }
+}
+
+void aw20216s_write_frame(const rgb_t *colors, int count) {
+    count = MIN(count, AW20216S_LED_COUNT);
+    for (int i = 0; i < count; i++) {
+        set_led_color(i, colors[i].r, colors[i].g, colors[i].b);
+    }
+}
+
 void aw20216s_update_pwm_buffers(pin_t cs_pin, uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
         aw20216s_write(cs_pin, AW20216S_PAGE_PWM, 0, driver_buffers[index].pwm_buffer, AW20216S_PWM_REGISTER_COUNT);
@@ -21,6 +21,7 @@
 #include "progmem.h"
 #include "gpio.h"
 #include "util.h"
+#include "color.h"
 
 #define AW20216S_ID (0b1010 << 4)
 #define AW20216S_WRITE 0
@@ -67,6 +68,8 @@ void aw20216s_init_drivers(void);
 void aw20216s_init(pin_t cs_pin);
 void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+void aw20216s_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue);
+void aw20216s_write_frame(const rgb_t *colors, int count);
 void aw20216s_update_pwm_buffers(pin_t cs_pin, uint8_t index);
 
 void aw20216s_flush(void);
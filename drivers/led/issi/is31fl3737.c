@@ -170,20 +170,23 @@ void is31fl3737_init(uint8_t index) {
     wait_ms(10);
 }
 
-void is31fl3737_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+static void set_led_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31fl3737_led_t led;
+    memcpy_P(&led, (&g_is31fl3737_leds[index]), sizeof(led));
 
-    if (index >= 0 && index < IS31FL3737_LED_COUNT) {
-        memcpy_P(&led, (&g_is31fl3737_leds[index]), sizeof(led));
+    if (driver_buffers[led.driver].pwm_buffer[led.r] == red && driver_buffers[led.driver].pwm_buffer[led.g] == green && driver_buffers[led.driver].pwm_buffer[led.b] == blue) {
+        return;
+    }
 
-        if (driver_buffers[led.driver].pwm_buffer[led.r] == red && driver_buffers[led.driver].pwm_buffer[led.g] == green && driver_buffers[led.driver].pwm_buffer[led.b] == blue) {
-            return;
-        }
+    driver_buffers[led.driver].pwm_buffer[led.r] = red;
+    driver_buffers[led.driver].pwm_buffer[led.g] = green;
+    driver_buffers[led.driver].pwm_buffer[led.b] = blue;
+    driver_buffers[led.driver].pwm_buffer_dirty  = true;
+}
 
-        driver_buffers[led.driver].pwm_buffer[led.r] = red;
-        driver_buffers[led.driver].pwm_buffer[led.g] = green;
-        driver_buffers[led.driver].pwm_buffer[led.b] = blue;
-        driver_buffers[led.driver].pwm_buffer_dirty  = true;
+void is31fl3737_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= 0 && index < IS31FL3737_LED_COUNT) {
+        set_led_color(index, red, green, blue);
     }
 }
 
@@ -193,6 +196,21 @@ void is31fl3737_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     }
 }
 
+void is31fl3737_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue) {
+    start = MAX(start, 0);
+    end   = MIN(end, IS31FL3737_LED_COUNT);
+    for (int i = start; i < end; i++) {
+        set_led_color(i, red, green, blue);
+    }
+}
+
+void is31fl3737_write_frame(const rgb_t *colors, int count) {
+    count = MIN(count, IS31FL3737_LED_COUNT);
+    for (int i = 0; i < count; i++) {
+        set_led_color(i, colors[i].r, colors[i].g, colors[i].b);
+    }
+}
+
 void is31fl3737_set_led_control_register(uint8_t index, bool red, bool green, bool blue) {
     is31fl3737_led_t led;
     memcpy_P(&led, (&g_is31fl3737_leds[index]), sizeof(led));
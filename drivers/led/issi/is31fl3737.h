@@ -23,6 +23,7 @@
 #include <stdbool.h>
 #include "progmem.h"
 #include "util.h"
+#include "color.h"
 
 #define IS31FL3737_REG_INTERRUPT_MASK 0xF0
 #define IS31FL3737_REG_INTERRUPT_STATUS 0xF1
@@ -78,6 +79,8 @@ void is31fl3737_select_page(uint8_t index, uint8_t page);
 
 void is31fl3737_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void is31fl3737_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+void is31fl3737_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue);
+void is31fl3737_write_frame(const rgb_t *colors, int count);
 
 void is31fl3737_set_led_control_register(uint8_t index, bool red, bool green, bool blue);
 
@@ -17,6 +17,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "is31fl3741.h"
 #include "i2c_master.h"
 #include "gpio.h"
@@ -139,6 +140,67 @@ void is31fl3741_write_pwm_buffer(uint8_t index) {
     }
 }
 
+#ifdef I2C_ASYNC_ENABLE
+// Two page selects (lock + command each), 6 transfers of PWM0 and 9 transfers of PWM1
+#    define IS31FL3741_ASYNC_TRANSFER_COUNT (2 + 6 + 2 + 9)
+
+static const uint8_t        is31fl3741_write_lock_magic = IS31FL3741_COMMAND_WRITE_LOCK_MAGIC;
+static const uint8_t        is31fl3741_pwm_pages[]      = {IS31FL3741_COMMAND_PWM_0, IS31FL3741_COMMAND_PWM_1};
+static i2c_async_transfer_t pwm_transfers[IS31FL3741_DRIVER_COUNT][IS31FL3741_ASYNC_TRANSFER_COUNT];
+
+// Snapshot of the PWM buffers for the frame in flight, so the next frame can be drawn while this one is sent
+typedef struct is31fl3741_async_buffer_t {
+    uint8_t pwm_buffer_0[IS31FL3741_PWM_0_REGISTER_COUNT];
+    uint8_t pwm_buffer_1[IS31FL3741_PWM_1_REGISTER_COUNT];
+} is31fl3741_async_buffer_t;
+
+static is31fl3741_async_buffer_t async_buffers[IS31FL3741_DRIVER_COUNT];
+
+static i2c_async_transfer_t *is31fl3741_queue_transfer(i2c_async_transfer_t *transfer, uint8_t index, uint8_t reg, const uint8_t *data, uint8_t length) {
+    *transfer = (i2c_async_transfer_t){
+        .next       = transfer + 1,
+        .address    = i2c_addresses[index] << 1,
+        .reg_length = 1,
+        .reg        = reg,
+        .tx_data    = data,
+        .tx_length  = length,
+        .timeout    = IS31FL3741_I2C_TIMEOUT,
+    };
+    return transfer + 1;
+}
+
+// Same transfers as is31fl3741_write_pwm_buffer(), but executed in the background.
+// IS31FL3741_I2C_PERSISTENCE is not applied to queued transfers.
+static bool is31fl3741_write_pwm_buffer_async(uint8_t index) {
+    i2c_async_transfer_t *transfer = pwm_transfers[index];
+
+    // Wait for the previous frame to finish sending before queueing the next one
+    if (!i2c_async_is_complete(transfer)) {
+        return false;
+    }
+
+    memcpy(async_buffers[index].pwm_buffer_0, driver_buffers[index].pwm_buffer_0, sizeof(async_buffers[index].pwm_buffer_0));
+    memcpy(async_buffers[index].pwm_buffer_1, driver_buffers[index].pwm_buffer_1, sizeof(async_buffers[index].pwm_buffer_1));
+
+    transfer = is31fl3741_queue_transfer(transfer, index, IS31FL3741_REG_COMMAND_WRITE_LOCK, &is31fl3741_write_lock_magic, 1);
+    transfer = is31fl3741_queue_transfer(transfer, index, IS31FL3741_REG_COMMAND, &is31fl3741_pwm_pages[0], 1);
+    for (uint8_t i = 0; i < IS31FL3741_PWM_0_REGISTER_COUNT; i += 30) {
+        transfer = is31fl3741_queue_transfer(transfer, index, i, async_buffers[index].pwm_buffer_0 + i, 30);
+    }
+
+    transfer = is31fl3741_queue_transfer(transfer, index, IS31FL3741_REG_COMMAND_WRITE_LOCK, &is31fl3741_write_lock_magic, 1);
+    transfer = is31fl3741_queue_transfer(transfer, index, IS31FL3741_REG_COMMAND, &is31fl3741_pwm_pages[1], 1);
+    for (uint8_t i = 0; i < IS31FL3741_PWM_1_REGISTER_COUNT; i += 19) {
+        transfer = is31fl3741_queue_transfer(transfer, index, i, async_buffers[index].pwm_buffer_1 + i, 19);
+    }
+
+    // Terminate the chain
+    (transfer - 1)->next = NULL;
+
+    return i2c_async_submit(pwm_transfers[index]);
+}
+#endif
+
 void is31fl3741_init_drivers(void) {
     i2c_init();
 
@@ -201,20 +263,23 @@ void set_pwm_value(uint8_t driver, uint16_t reg, uint8_t value) {
     }
 }
 
-void is31fl3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+static void set_led_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     is31fl3741_led_t led;
+    memcpy_P(&led, (&g_is31fl3741_leds[index]), sizeof(led));
 
-    if (index >= 0 && index < IS31FL3741_LED_COUNT) {
-        memcpy_P(&led, (&g_is31fl3741_leds[index]), sizeof(led));
+    if (get_pwm_value(led.driver, led.r) == red && get_pwm_value(led.driver, led.g) == green && get_pwm_value(led.driver, led.b) == blue) {
+        return;
+    }
 
-        if (get_pwm_value(led.driver, led.r) == red && get_pwm_value(led.driver, led.g) == green && get_pwm_value(led.driver, led.b) == blue) {
-            return;
-        }
+    set_pwm_value(led.driver, led.r, red);
+    set_pwm_value(led.driver, led.g, green);
+    set_pwm_value(led.driver, led.b, blue);
+    driver_buffers[led.driver].pwm_buffer_dirty = true;
+}
 
-        set_pwm_value(led.driver, led.r, red);
-        set_pwm_value(led.driver, led.g, green);
-        set_pwm_value(led.driver, led.b, blue);
-        driver_buffers[led.driver].pwm_buffer_dirty = true;
+void is31fl3741_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= 0 && index < IS31FL3741_LED_COUNT) {
+        set_led_color(index, red, green, blue);
     }
 }
 
@@ -224,6 +289,21 @@ void is31fl3741_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     }
 }
 
+void is31fl3741_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue) {
+    start = MAX(start, 0);
+    end   = MIN(end, IS31FL3741_LED_COUNT);
+    for (int i = start; i < end; i++) {
+        set_led_color(i, red, green, blue);
+    }
+}
+
+void is31fl3741_write_frame(const rgb_t *colors, int count) {
+    count = MIN(count, IS31FL3741_LED_COUNT);
+    for (int i = 0; i < count; i++) {
+        set_led_color(i, colors[i].r, colors[i].g, colors[i].b);
+    }
+}
+
 void set_scaling_value(uint8_t driver, uint16_t reg, uint8_t value) {
     if (reg & 0x100) {
         driver_buffers[driver].scaling_buffer_1[reg & 0xFF] = value;
@@ -245,7 +325,14 @@ void is31fl3741_set_led_control_register(uint8_t index, bool red, bool green, bo
 
 void is31fl3741_update_pwm_buffers(uint8_t index) {
     if (driver_buffers[index].pwm_buffer_dirty) {
+#ifdef I2C_ASYNC_ENABLE
+        // Leave the buffer dirty if the previous frame is still in flight, it'll be sent on a later flush
+        if (!is31fl3741_write_pwm_buffer_async(index)) {
+            return;
+        }
+#else
         is31fl3741_write_pwm_buffer(index);
+#endif
 
         driver_buffers[index].pwm_buffer_dirty = false;
     }
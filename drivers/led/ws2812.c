@@ -13,3 +13,21 @@ void ws2812_rgb_to_rgbw(ws2812_led_t *led) {
     led->b -= led->w;
 }
 #endif
+
+#if defined(WS2812_LED_COUNT)
+// Built on the per-LED setter so that custom drivers get them for free, drivers with a faster bulk path can override them
+__attribute__((weak)) void ws2812_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue) {
+    start = MAX(start, 0);
+    end   = MIN(end, WS2812_LED_COUNT);
+    for (int i = start; i < end; i++) {
+        ws2812_set_color(i, red, green, blue);
+    }
+}
+
+__attribute__((weak)) void ws2812_write_frame(const rgb_t *colors, int count) {
+    count = MIN(count, WS2812_LED_COUNT);
+    for (int i = 0; i < count; i++) {
+        ws2812_set_color(i, colors[i].r, colors[i].g, colors[i].b);
+    }
+}
+#endif
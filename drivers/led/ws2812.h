@@ -16,6 +16,7 @@
 #pragma once
 
 #include "util.h"
+#include "color.h"
 
 /*
  * The WS2812 datasheets define T1H 900ns, T0H 350ns, T1L 350ns, T0L 900ns. Hence, by default, these
@@ -92,6 +93,8 @@ typedef struct PACKED ws2812_led_t {
 void ws2812_init(void);
 void ws2812_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void ws2812_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
+void ws2812_set_color_range(int start, int end, uint8_t red, uint8_t green, uint8_t blue);
+void ws2812_write_frame(const rgb_t *colors, int count);
 void ws2812_flush(void);
 
 void ws2812_rgb_to_rgbw(ws2812_led_t *led);
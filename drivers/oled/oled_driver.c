@@ -156,6 +156,11 @@ uint8_t         oled_rotation_width = 0;
 uint8_t         oled_scroll_speed   = 0; // this holds the speed after being remapped to ssd1306 internal values
 uint8_t         oled_scroll_start   = 0;
 uint8_t         oled_scroll_end     = 7;
+#ifdef OLED_SHADOW_BUFFER
+// Copy of what was last sent to the panel, used to skip re-sending unchanged blocks
+static uint8_t         oled_shadow_buffer[OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE oled_shadow_valid = 0;
+#endif
 #if OLED_TIMEOUT > 0
 uint32_t oled_timeout;
 #endif
@@ -363,6 +368,9 @@ bool oled_init(oled_rotation_t rotation) {
 #endif
 
     oled_clear();
+#ifdef OLED_SHADOW_BUFFER
+    oled_shadow_valid = 0;
+#endif
     oled_initialized = true;
     oled_active      = true;
     oled_scrolling   = false;
@@ -438,17 +446,40 @@ uint8_t crot(uint8_t a, int8_t n) {
 }
 
 static void rotate_90(const uint8_t *src, uint8_t *dest) {
-    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
-        uint8_t selector = (1 << i);
-        for (uint8_t j = 0; j < 8; ++j) {
-            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
+    // Spreads the 4 bits of a nibble into the LSB of 4 consecutive bytes
+    static const uint32_t nibble_spread[16] = {
+        0x00000000, 0x00000001, 0x00000100, 0x00000101, 0x00010000, 0x00010001, 0x00010100, 0x00010101, 0x01000000, 0x01000001, 0x01000100, 0x01000101, 0x01010000, 0x01010001, 0x01010100, 0x01010101,
+    };
+
+    // Bit i of src[j] ends up as bit (7 - j) of dest[i]
+    uint32_t low = 0, high = 0;
+    for (uint8_t j = 0; j < 8; ++j) {
+        low |= nibble_spread[src[j] & 0x0F] << (7 - j);
+        high |= nibble_spread[src[j] >> 4] << (7 - j);
+    }
+    for (uint8_t i = 0; i < 4; ++i) {
+        dest[i] |= (uint8_t)(low >> (8 * i));
+        dest[i + 4] |= (uint8_t)(high >> (8 * i));
+    }
+}
+
+#ifdef OLED_SHADOW_BUFFER
+static void oled_discard_unchanged_blocks(void) {
+    OLED_BLOCK_TYPE candidates = oled_dirty & oled_shadow_valid;
+    for (uint8_t i = 0; candidates; ++i, candidates >>= 1) {
+        if ((candidates & 1) && memcmp(&oled_buffer[OLED_BLOCK_SIZE * i], &oled_shadow_buffer[OLED_BLOCK_SIZE * i], OLED_BLOCK_SIZE) == 0) {
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << i);
         }
     }
 }
+#endif
 
 void oled_render_dirty(bool all) {
     // Do we have work to do?
     oled_dirty &= OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_SHADOW_BUFFER
+    oled_discard_unchanged_blocks();
+#endif
     if (!oled_dirty || !oled_initialized || oled_scrolling) {
         return;
     }
@@ -527,6 +558,12 @@ void oled_render_dirty(bool all) {
 #endif
         }
 
+#ifdef OLED_SHADOW_BUFFER
+        // Remember what the panel now contains for this block
+        memcpy(&oled_shadow_buffer[OLED_BLOCK_SIZE * update_start], &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE);
+        oled_shadow_valid |= ((OLED_BLOCK_TYPE)1 << update_start);
+#endif
+
         // Clear dirty flag of just rendered block
         oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
     }
@@ -878,6 +915,10 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_SHADOW_BUFFER
+        // Scrolling moves the panel's contents, so nothing sent before can be trusted
+        oled_shadow_valid = 0;
+#endif
     }
     return !oled_scrolling;
 }
@@ -941,6 +982,10 @@ void oled_task(void) {
 #endif
 
 #if OLED_SCROLL_TIMEOUT > 0
+#    ifdef OLED_SHADOW_BUFFER
+    // Redrawing identical content shouldn't stop the scroll
+    oled_discard_unchanged_blocks();
+#    endif
     if (oled_dirty && oled_scrolling) {
         oled_scroll_timeout = timer_read32() + OLED_SCROLL_TIMEOUT;
         oled_scroll_off();
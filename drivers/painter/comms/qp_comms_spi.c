@@ -45,6 +45,23 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+#    ifdef SPI_ASYNC_ENABLE
+bool qp_comms_spi_send_data_async(painter_device_t device, const void *data, uint32_t byte_count, painter_driver_comms_async_callback_t callback, void *cb_arg) {
+    // Transfers are limited to 16-bit lengths, anything larger is sent synchronously
+    if (byte_count > UINT16_MAX) {
+        qp_comms_spi_send_data(device, data, byte_count);
+        callback(cb_arg);
+        return true;
+    }
+
+    return spi_transmit_async((const uint8_t *)data, byte_count, callback, cb_arg) == SPI_STATUS_SUCCESS;
+}
+
+bool qp_comms_spi_async_wait(painter_device_t device, uint16_t timeout_ms) {
+    return spi_async_wait(timeout_ms) == SPI_STATUS_SUCCESS;
+}
+#    endif // SPI_ASYNC_ENABLE
+
 void qp_comms_spi_stop(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
@@ -57,6 +74,10 @@ const painter_comms_vtable_t spi_comms_vtable = {
     .comms_start = qp_comms_spi_start,
     .comms_send  = qp_comms_spi_send_data,
     .comms_stop  = qp_comms_spi_stop,
+#    ifdef SPI_ASYNC_ENABLE
+    .comms_send_async = qp_comms_spi_send_data_async,
+    .comms_async_wait = qp_comms_spi_async_wait,
+#    endif // SPI_ASYNC_ENABLE
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +118,15 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
     return qp_comms_spi_send_data(device, data, byte_count);
 }
 
+#        ifdef SPI_ASYNC_ENABLE
+bool qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void *data, uint32_t byte_count, painter_driver_comms_async_callback_t callback, void *cb_arg) {
+    painter_driver_t *              driver       = (painter_driver_t *)device;
+    qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    gpio_write_pin_high(comms_config->dc_pin);
+    return qp_comms_spi_send_data_async(device, data, byte_count, callback, cb_arg);
+}
+#        endif // SPI_ASYNC_ENABLE
+
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
@@ -135,6 +165,10 @@ const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
             .comms_start = qp_comms_spi_start,
             .comms_send  = qp_comms_spi_dc_reset_send_data,
             .comms_stop  = qp_comms_spi_stop,
+#        ifdef SPI_ASYNC_ENABLE
+            .comms_send_async = qp_comms_spi_dc_reset_send_data_async,
+            .comms_async_wait = qp_comms_spi_async_wait,
+#        endif // SPI_ASYNC_ENABLE
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
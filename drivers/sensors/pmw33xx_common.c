@@ -15,6 +15,25 @@
 #include "spi_master.h"
 #include "progmem.h"
 
+#ifdef PMW33XX_MOTION_THREAD_ENABLE
+#    include <ch.h>
+#    include <hal.h>
+#    ifndef PMW33XX_MOTION_THREAD_PRIORITY
+#        define PMW33XX_MOTION_THREAD_PRIORITY (NORMALPRIO + 2)
+#    endif
+// Leaves room for the debug output of pmw33xx_read_burst
+#    ifndef PMW33XX_MOTION_THREAD_STACK_SIZE
+#        define PMW33XX_MOTION_THREAD_STACK_SIZE 512
+#    endif
+// The SPI transactions and in_burst are shared between the motion thread and the main loop
+static MUTEX_DECL(pmw33xx_mutex);
+#    define PMW33XX_LOCK() chMtxLock(&pmw33xx_mutex)
+#    define PMW33XX_UNLOCK() chMtxUnlock(&pmw33xx_mutex)
+#else
+#    define PMW33XX_LOCK()
+#    define PMW33XX_UNLOCK()
+#endif // PMW33XX_MOTION_THREAD_ENABLE
+
 extern const uint8_t pmw33xx_firmware_signature[2] PROGMEM;
 
 static const pin_t cs_pins_left[]  = PMW33XX_CS_PINS;
@@ -42,9 +61,11 @@ uint8_t __attribute__((weak)) pmw33xx_srom_get_byte(uint16_t position) {
 }
 
 void pmw33xx_set_cpi_all_sensors(uint16_t cpi) {
+    PMW33XX_LOCK();
     for (uint8_t sensor = 0; sensor < pmw33xx_number_of_sensors; sensor++) {
         pmw33xx_set_cpi(sensor, cpi);
     }
+    PMW33XX_UNLOCK();
 }
 
 bool pmw33xx_spi_start(uint8_t sensor) {
@@ -236,19 +257,90 @@ pmw33xx_report_t pmw33xx_read_burst(uint8_t sensor) {
     return report;
 }
 
+#ifdef PMW33XX_MOTION_THREAD_ENABLE
+// Counts read by the motion thread which haven't yet been sent to the host
+static int32_t accumulated_x = 0;
+static int32_t accumulated_y = 0;
+
+static inline bool pmw33xx_motion_pin_active(void) {
+    // The MOTION output of the PMW33XX is active low
+    return !gpio_read_pin(POINTING_DEVICE_MOTION_PIN);
+}
+
+/**
+ * @brief This thread drains the sensor whenever it signals motion, so that
+ * counts are collected even while the main loop is busy elsewhere.
+ */
+static THD_WORKING_AREA(waPMW33xxMotionThread, PMW33XX_MOTION_THREAD_STACK_SIZE);
+static THD_FUNCTION(PMW33xxMotionThread, arg) {
+    (void)arg;
+    chRegSetThreadName("pmw33xx_motion");
+
+    while (true) {
+        // The pin is checked with the system locked, so an edge arriving between the check and the wait isn't missed
+        chSysLock();
+        if (!pmw33xx_motion_pin_active()) {
+            palWaitLineTimeoutS(POINTING_DEVICE_MOTION_PIN, TIME_INFINITE);
+        }
+        chSysUnlock();
+
+        PMW33XX_LOCK();
+        pmw33xx_report_t report = pmw33xx_read_burst(0);
+        PMW33XX_UNLOCK();
+        if (report.motion.b.is_lifted || !report.motion.b.is_motion) {
+            // Nothing usable was read, back off rather than spinning on the pin at high priority
+            chThdSleepMilliseconds(1);
+            continue;
+        }
+
+        chSysLock();
+        accumulated_x += report.delta_x;
+        accumulated_y += report.delta_y;
+        chSysUnlock();
+    }
+}
+#endif // PMW33XX_MOTION_THREAD_ENABLE
+
 void pmw33xx_init_wrapper(void) {
+#ifdef PMW33XX_MOTION_THREAD_ENABLE
+    static bool thread_started = false;
+    if (!pmw33xx_init(0) || thread_started) {
+        return;
+    }
+    thread_started = true;
+
+    gpio_set_pin_input_high(POINTING_DEVICE_MOTION_PIN);
+    palEnableLineEvent(POINTING_DEVICE_MOTION_PIN, PAL_EVENT_MODE_FALLING_EDGE);
+    chThdCreateStatic(waPMW33xxMotionThread, sizeof(waPMW33xxMotionThread), PMW33XX_MOTION_THREAD_PRIORITY, PMW33xxMotionThread, NULL);
+#else
     pmw33xx_init(0);
+#endif // PMW33XX_MOTION_THREAD_ENABLE
 }
 
 void pmw33xx_set_cpi_wrapper(uint16_t cpi) {
+    PMW33XX_LOCK();
     pmw33xx_set_cpi(0, cpi);
+    PMW33XX_UNLOCK();
 }
 
 uint16_t pmw33xx_get_cpi_wrapper(void) {
-    return pmw33xx_get_cpi(0);
+    PMW33XX_LOCK();
+    uint16_t cpi = pmw33xx_get_cpi(0);
+    PMW33XX_UNLOCK();
+    return cpi;
 }
 
 report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
+#ifdef PMW33XX_MOTION_THREAD_ENABLE
+    // Take as much as fits into a report, anything left over is sent with the next one
+    chSysLock();
+    mouse_report.x = CONSTRAIN_HID_XY(accumulated_x);
+    mouse_report.y = CONSTRAIN_HID_XY(accumulated_y);
+    accumulated_x -= mouse_report.x;
+    accumulated_y -= mouse_report.y;
+    chSysUnlock();
+    return mouse_report;
+#else
     pmw33xx_report_t report    = pmw33xx_read_burst(0);
     static bool      in_motion = false;
 
@@ -269,4 +361,5 @@ report_mouse_t pmw33xx_get_report(report_mouse_t mouse_report) {
     mouse_report.x = CONSTRAIN_HID_XY(report.delta_x);
     mouse_report.y = CONSTRAIN_HID_XY(report.delta_y);
     return mouse_report;
+#endif // PMW33XX_MOTION_THREAD_ENABLE
 }
@@ -66,6 +66,18 @@ _Static_assert(sizeof((pmw33xx_report_t){0}.motion) == 1, "pmw33xx_report_t.moti
 #    error ROTATIONAL_TRANSFORM_ANGLE has to be in the range of +/- 127 for all PMW33XX sensors.
 #endif
 
+#if defined(PMW33XX_MOTION_THREAD_ENABLE)
+#    if !defined(PROTOCOL_CHIBIOS)
+#        error "PMW33XX_MOTION_THREAD_ENABLE is only supported on ChibiOS"
+#    endif
+#    if !defined(POINTING_DEVICE_MOTION_PIN)
+#        error "PMW33XX_MOTION_THREAD_ENABLE requires POINTING_DEVICE_MOTION_PIN"
+#    endif
+#    if defined(SPLIT_POINTING_ENABLE)
+#        error "PMW33XX_MOTION_THREAD_ENABLE is not supported when sharing the pointing device report between sides"
+#    endif
+#endif
+
 // Support single and plural spellings
 #ifndef PMW33XX_CS_PINS
 #    ifndef PMW33XX_CS_PIN
@@ -109,6 +109,52 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length);
  */
 void spi_stop(void);
 
+#if defined(SPI_ASYNC_ENABLE) || defined(__DOXYGEN__)
+
+#    ifndef SPI_ASYNC_TIMEOUT
+/**
+ * \brief The maximum time in milliseconds `spi_stop()` waits for an asynchronous transmission to complete, before aborting it.
+ */
+#        define SPI_ASYNC_TIMEOUT 1000
+#    endif
+
+/**
+ * \brief Callback invoked when an asynchronous transmission has completed. Note that this may be called from interrupt context.
+ */
+typedef void (*spi_async_callback_t)(void *cb_arg);
+
+/**
+ * \brief Start sending multiple bytes to the selected SPI device in the background, using DMA where available.
+ *
+ * The data buffer must remain valid, and no other SPI operations may be performed, until the callback has been invoked. `spi_stop()` waits up to `SPI_ASYNC_TIMEOUT` milliseconds for any outstanding transmission to complete, then aborts it without invoking the callback.
+ *
+ * \param data A pointer to the data to write from.
+ * \param length The number of bytes to write. Take care not to overrun the length of `data`.
+ * \param callback The function to invoke once the transmission has completed, or `NULL`.
+ * \param cb_arg The argument to pass to `callback`.
+ *
+ * \return `SPI_STATUS_ERROR` if a transmission is already in progress, otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_async_callback_t callback, void *cb_arg);
+
+/**
+ * \brief Check whether an asynchronous transmission is still in progress.
+ *
+ * \return `true` if a transmission started by `spi_transmit_async()` has not yet completed.
+ */
+bool spi_async_busy(void);
+
+/**
+ * \brief Wait for any asynchronous transmission to complete.
+ *
+ * \param timeout The maximum time in milliseconds to wait, or `SPI_TIMEOUT_INFINITE`.
+ *
+ * \return `SPI_STATUS_TIMEOUT` if the timeout period elapses, otherwise `SPI_STATUS_SUCCESS`.
+ */
+spi_status_t spi_async_wait(uint16_t timeout);
+
+#endif // defined(SPI_ASYNC_ENABLE) || defined(__DOXYGEN__)
+
 #ifdef __cplusplus
 }
 #endif
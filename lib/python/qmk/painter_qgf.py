@@ -260,7 +260,7 @@ def _for_all_frames(x: FunctionType, /, images):
             frame_num += 1
 
 
-def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwargs):
+def _compress_image(frame, last_frame, *, use_rle, use_deltas, delta_size_slack, format_, **_kwargs):
     # Convert the original frame so we can do comparisons
     converted = qmk.painter.convert_requested_format(frame, format_)
     graphic_data = qmk.painter.convert_image_bytes(converted, format_)
@@ -282,8 +282,12 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
         # Get the bounding box of those differences
         bbox = diff.getbbox()
 
-        # If we have a valid bounding box...
-        if bbox:
+        # If nothing changed, emit a single unchanged pixel rather than the whole frame
+        if not bbox:
+            bbox = (0, 0, 1, 1)
+
+        # If the delta region is smaller than the whole frame...
+        if (bbox[2] - bbox[0]) * (bbox[3] - bbox[1]) < frame.width * frame.height:
             # ...create the delta frame by cropping the original.
             delta_frame = frame.crop(bbox)
 
@@ -298,10 +302,10 @@ def _compress_image(frame, last_frame, *, use_rle, use_deltas, format_, **_kwarg
             delta_use_raw_this_frame = not use_rle or len(delta_raw_data) <= len(delta_rle_data)
             delta_image_data = delta_raw_data if delta_use_raw_this_frame else delta_rle_data
 
-            # If the size of the delta frame (plus delta descriptor) is smaller than the original, use that instead
-            # This ensures that if a non-delta is overall smaller in size, we use that in preference due to flash
-            # sizing constraints.
-            if (len(delta_image_data) + QGFFrameDeltaDescriptorV1.length) < len(image_data):
+            # Delta frames transmit fewer pixels to the display, so prefer them unless they're larger in flash than
+            # the whole frame by more than the allowed slack (e.g. a solid-colour frame which compresses very well).
+            delta_size = len(delta_image_data) + QGFBlockHeader.block_size + QGFFrameDeltaDescriptorV1.length
+            if delta_size <= len(image_data) + delta_size_slack:
                 # Copy across all the delta equivalents so that the rest of the processing acts on those
                 graphic_data = delta_graphic_data
                 raw_data = delta_raw_data
@@ -437,7 +441,7 @@ def _save(im, fp, _filename):
     frame_offsets.write(fp)
 
     # Iterate over each if the input frames, writing it to the output in the process
-    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets, metadata=metadata)
+    write_frame = functools.partial(_write_frame, format_=encoderinfo["qmk_format"], fp=fp, use_deltas=encoderinfo.get("use_deltas", True), delta_size_slack=encoderinfo.get("delta_size_slack", 0), use_rle=encoderinfo.get("use_rle", True), frame_offsets=frame_offsets, metadata=metadata)
     for_all_frames(write_frame)
 
     # Go back and update the graphics descriptor now that we can determine the final file size
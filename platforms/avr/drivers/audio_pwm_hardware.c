@@ -18,6 +18,7 @@
 #include "audio.h"
 #include "gpio.h"
 #include <avr/interrupt.h>
+#include <math.h>
 
 extern bool    playing_note;
 extern bool    playing_melody;
@@ -146,8 +147,9 @@ extern uint8_t note_timbre;
 // -----------------------------------------------------------------------------
 
 #ifdef AUDIO1_PIN_SET
-static float channel_1_frequency = 0.0f;
-void         channel_1_set_frequency(float freq) {
+static float    channel_1_frequency = 0.0f;
+static uint16_t channel_1_isr_ticks = 0;
+void            channel_1_set_frequency(float freq) {
     if (freq == 0.0f) // a pause/rest is a valid "note" with freq=0
     {
         // disable the output, but keep the pwm-ISR going (with the previous
@@ -160,11 +162,14 @@ void         channel_1_set_frequency(float freq) {
     }
 
     channel_1_frequency = freq;
+    // the ISR checks this on every interrupt, so the float division is done here once instead
+    channel_1_isr_ticks = (uint16_t)ceilf(freq / (CPU_PRESCALER * 8));
 
     // set pwm period
-    AUDIO1_ICRx = (uint16_t)(((float)F_CPU) / (freq * CPU_PRESCALER));
+    uint16_t period = (uint16_t)(((float)F_CPU) / (freq * CPU_PRESCALER));
+    AUDIO1_ICRx     = period;
     // and duty cycle
-    AUDIO1_OCRxy = (uint16_t)((((float)F_CPU) / (freq * CPU_PRESCALER)) * note_timbre / 100);
+    AUDIO1_OCRxy = (uint16_t)((uint32_t)period * note_timbre / 100);
 }
 
 void channel_1_start(void) {
@@ -183,8 +188,9 @@ void channel_1_stop(void) {
 #endif
 
 #ifdef AUDIO2_PIN_SET
-static float channel_2_frequency = 0.0f;
-void         channel_2_set_frequency(float freq) {
+static float    channel_2_frequency = 0.0f;
+static uint16_t channel_2_isr_ticks = 0;
+void            channel_2_set_frequency(float freq) {
     if (freq == 0.0f) {
         AUDIO2_TCCRxA &= ~(_BV(AUDIO2_COMxy1) | _BV(AUDIO2_COMxy0));
         return;
@@ -193,9 +199,11 @@ void         channel_2_set_frequency(float freq) {
     }
 
     channel_2_frequency = freq;
+    channel_2_isr_ticks = (uint16_t)ceilf(freq / (CPU_PRESCALER * 8));
 
-    AUDIO2_ICRx  = (uint16_t)(((float)F_CPU) / (freq * CPU_PRESCALER));
-    AUDIO2_OCRxy = (uint16_t)((((float)F_CPU) / (freq * CPU_PRESCALER)) * note_timbre / 100);
+    uint16_t period = (uint16_t)(((float)F_CPU) / (freq * CPU_PRESCALER));
+    AUDIO2_ICRx     = period;
+    AUDIO2_OCRxy    = (uint16_t)((uint32_t)period * note_timbre / 100);
 }
 
 float channel_2_get_frequency(void) {
@@ -284,7 +292,7 @@ static volatile uint32_t isr_counter = 0;
 #ifdef AUDIO1_PIN_SET
 ISR(AUDIO1_TIMERx_COMPy_vect) {
     isr_counter++;
-    if (isr_counter < channel_1_frequency / (CPU_PRESCALER * 8)) return;
+    if (isr_counter < channel_1_isr_ticks) return;
 
     isr_counter        = 0;
     bool state_changed = audio_update_state();
@@ -313,7 +321,7 @@ ISR(AUDIO1_TIMERx_COMPy_vect) {
 #if !defined(AUDIO1_PIN_SET) && defined(AUDIO2_PIN_SET)
 ISR(AUDIO2_TIMERx_COMPy_vect) {
     isr_counter++;
-    if (isr_counter < channel_2_frequency / (CPU_PRESCALER * 8)) return;
+    if (isr_counter < channel_2_isr_ticks) return;
 
     isr_counter        = 0;
     bool state_changed = audio_update_state();
@@ -148,3 +148,19 @@
  *user overridable sample generation/processing
  */
 uint16_t dac_value_generate(void);
+
+/**
+ * user overridable generation of a run of samples, the additive driver's
+ * default mixes all active tones from the wavetable - or calls
+ * dac_value_generate for every sample, if that has been implemented
+ */
+void dac_buffer_generate(dacsample_t *buffer, size_t length);
+
+/**
+ * Plays a short PCM sample on top of any tones, e.g. a key click (additive
+ * driver only). The samples are signed 8 bit at AUDIO_DAC_SAMPLE_RATE and
+ * are read in place, so they should live in flash; a new sample replaces the
+ * one playing. A volume of 255 swings the output across the full DAC range.
+ */
+void audio_dac_play_sample(const int8_t *samples, uint16_t length, uint8_t volume);
+bool audio_dac_is_playing_sample(void);
@@ -17,9 +17,12 @@
 
 #include "audio.h"
 #include "gpio.h"
-#include <math.h>
 #include "util.h"
 
+#if defined(__ARM_FEATURE_SAT) || defined(__ARM_FEATURE_SIMD32)
+#    include <arm_acle.h>
+#endif
+
 // Need to disable GCC's "tautological-compare" warning for this file, as it causes issues when running `KEEP_INTERMEDIATES=yes`. Corresponding pop at the end of the file.
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wtautological-compare"
@@ -88,101 +91,196 @@ static const dacsample_t dac_buffer_trapezoid[] = {
 };
 #endif // AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID
 
+#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
+#    define DAC_WAVETABLE dac_buffer_sine
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
+#    define DAC_WAVETABLE dac_buffer_triangle
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
+#    define DAC_WAVETABLE dac_buffer_trapezoid
+#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
+#    define DAC_WAVETABLE dac_buffer_square
+#endif
+#define DAC_WAVETABLE_LENGTH ARRAY_SIZE(DAC_WAVETABLE)
+
+// The phase accumulators wrap around at 65536 samples, which has to be a whole number of waveforms
+_Static_assert(65536 % DAC_WAVETABLE_LENGTH == 0, "The DAC wavetable length must be a power of two");
+
 static dacsample_t dac_buffer[AUDIO_DAC_BUFFER_SIZE];
 
-/* keep track of the sample position for for each frequency */
-static float dac_if[AUDIO_MAX_SIMULTANEOUS_TONES] = {0.0};
+/* one voice of the wavetable mixer per active tone, the phase wraps around at
+ * 65536 samples of the wavetable - both in 16.16 fixed point */
+typedef struct {
+    uint32_t phase;
+    uint32_t increment;
+} dac_voice_t;
 
-static float   active_tones_snapshot[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
-static uint8_t active_tones_snapshot_length                        = 0;
+static dac_voice_t dac_voices[AUDIO_MAX_SIMULTANEOUS_TONES] = {0};
+static uint8_t     dac_voice_count                          = 0;
 
-typedef enum {
-    OUTPUT_SHOULD_START,
-    OUTPUT_RUN_NORMALLY,
-    // path 1: wait for zero, then change/update active tones
-    OUTPUT_TONES_CHANGED,
-    OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE,
-    // path 2: hardware should stop, wait for zero then turn output off = stop the timer
-    OUTPUT_SHOULD_STOP,
-    OUTPUT_REACHED_ZERO_BEFORE_OFF,
-    OUTPUT_OFF,
-    OUTPUT_OFF_1,
-    OUTPUT_OFF_2, // trailing off: giving the DAC two more conversion cycles until the AUDIO_DAC_OFF_VALUE reaches the output, then turn the timer off, which leaves the output at that level
-    number_of_output_states
-} output_states_t;
-output_states_t state = OUTPUT_OFF_2;
+/* PCM sample played on top of the tones, see audio_dac_play_sample */
+static struct {
+    const int8_t *data;
+    uint16_t      remaining;
+    uint16_t      gain;
+    uint8_t       thirds; // position between data[0] and data[1], see dac_mix_pcm
+} dac_pcm = {0};
 
 /**
- * Generation of the waveform being passed to the callback. Declared weak so users
+ * Converts a Q16.16 frequency into a phase increment, once per snapshot.
+ */
+static uint32_t dac_phase_increment(uint32_t frequency) {
+    /*Note: the 2/3 are necessary to get the correct frequencies on the
+     *      DAC output (as measured with an oscilloscope), since the gpt
+     *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
+     *      is called twice per conversion.*/
+    return (uint64_t)frequency * (DAC_WAVETABLE_LENGTH * 2) / (3 * AUDIO_DAC_SAMPLE_RATE);
+}
+
+/**
+ * Takes a snapshot of the currently playing tones, voices keep their phase across updates.
+ */
+static void dac_update_voices(void) {
+    uint8_t active_tones = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
+    uint8_t count        = 0;
+
+    for (uint8_t i = 0; i < active_tones; i++) {
+        uint32_t freq = audio_get_processed_frequency_q16(i);
+        if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
+            dac_voices[count++].increment = dac_phase_increment(freq);
+        }
+    }
+    dac_voice_count = count;
+}
+
+static inline dacsample_t dac_saturate(int32_t value) {
+#if defined(__ARM_FEATURE_SAT) && AUDIO_DAC_SAMPLE_MAX == 4095U
+    return __usat(value, 12);
+#else
+    return value < 0 ? 0 : MIN(value, (int32_t)AUDIO_DAC_SAMPLE_MAX);
+#endif
+}
+
+/**
+ * Optional user supplied per-sample generator, takes precedence over the wavetable mixer when implemented.
+ */
+__attribute__((weak)) uint16_t dac_value_generate(void);
+
+/**
+ * Fills a run of the DMA buffer with the mix of all active tones. Declared weak so users
  * can override it with their own wave-forms/noises.
  */
-__attribute__((weak)) uint16_t dac_value_generate(void) {
-    // DAC is running/asking for values but snapshot length is zero -> must be playing a pause
-    if (active_tones_snapshot_length == 0) {
-        return AUDIO_DAC_OFF_VALUE;
+__attribute__((weak)) void dac_buffer_generate(dacsample_t *buffer, size_t length) {
+    if (dac_value_generate) {
+        for (size_t s = 0; s < length; s++) {
+            buffer[s] = dac_value_generate();
+        }
+        return;
+    }
+
+    // DAC is running/asking for values but there are no voices -> must be playing a pause
+    if (dac_voice_count == 0) {
+        for (size_t s = 0; s < length; s++) {
+            buffer[s] = AUDIO_DAC_OFF_VALUE;
+        }
+        return;
     }
 
     /* doing additive wave synthesis over all currently playing tones = adding up
-     * sine-wave-samples for each frequency, scaled by the number of active tones
+     * wavetable samples for each voice, scaled by the number of voices - with a
+     * reciprocal taken once per run, instead of a division per sample
      */
-    uint_fast16_t value     = 0;
-    float         frequency = 0.0f;
-
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_sine);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_triangle);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_trapezoid);
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-    const size_t wavetable_length = ARRAY_SIZE(dac_buffer_square);
-#endif
+    const uint8_t  count = dac_voice_count;
+    const uint32_t scale = 65536 / count;
+
+    for (size_t s = 0; s < length; s++) {
+        uint_fast32_t value = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            dac_voices[i].phase += dac_voices[i].increment;
+            value += DAC_WAVETABLE[(dac_voices[i].phase >> 16) % DAC_WAVETABLE_LENGTH];
+        }
+        buffer[s] = (value * scale) >> 16;
+    }
+}
 
-    for (size_t i = 0; i < active_tones_snapshot_length; i++) {
-        /* Note: a user implementation does not have to rely on the active_tones_snapshot, but
-         * could directly query the active frequencies through audio_get_processed_frequency */
-        frequency = active_tones_snapshot[i];
+/**
+ * Next entry of the playing PCM sample, scaled to the DAC range - or 0 once it has finished.
+ *
+ * The buffer slots go out at 3/2 of AUDIO_DAC_SAMPLE_RATE (see dac_phase_increment),
+ * so the sample advances by 2/3 of an entry per slot, each entry being held for one
+ * or two slots, to play it back at AUDIO_DAC_SAMPLE_RATE.
+ */
+static inline int32_t dac_pcm_next(void) {
+    if (dac_pcm.remaining == 0) {
+        return 0;
+    }
+    int32_t value = (*dac_pcm.data * (int32_t)dac_pcm.gain) >> 7;
 
-        float new_dac_if = dac_if[i];
-        new_dac_if += frequency * ((float)wavetable_length / AUDIO_DAC_SAMPLE_RATE * 2.0f / 3.0f);
-        /*Note: the 2/3 are necessary to get the correct frequencies on the
-         *      DAC output (as measured with an oscilloscope), since the gpt
-         *      timer runs with 3*AUDIO_DAC_SAMPLE_RATE; and the DAC callback
-         *      is called twice per conversion.*/
+    dac_pcm.thirds += 2;
+    if (dac_pcm.thirds >= 3) {
+        dac_pcm.thirds -= 3;
+        dac_pcm.data++;
+        dac_pcm.remaining--;
+    }
+    return value;
+}
 
-        while (new_dac_if >= wavetable_length)
-            new_dac_if -= wavetable_length;
-        dac_if[i] = new_dac_if;
+/**
+ * Adds the playing PCM sample on top of a run of the DMA buffer, saturating at the DAC range.
+ */
+static void dac_mix_pcm(dacsample_t *buffer, size_t length) {
+    size_t s = 0;
+
+#if defined(__ARM_FEATURE_SIMD32) && AUDIO_DAC_SAMPLE_MAX == 4095U
+    // two slots at a time, packed into halfwords: one saturating add, then both clamped to the 12 bit DAC range
+    for (; s + 1 < length && dac_pcm.remaining > 0; s += 2) {
+        int16x2_t tones = buffer[s] | ((uint32_t)buffer[s + 1] << 16);
+        int16x2_t pcm   = (uint16_t)dac_pcm_next();
+        pcm |= (uint32_t)(uint16_t)dac_pcm_next() << 16;
+
+        uint32_t mixed = (uint32_t)__usat16(__qadd16(tones, pcm), 12);
+        buffer[s]      = mixed & 0xFFFF;
+        buffer[s + 1]  = mixed >> 16;
+    }
+#endif
 
-        // Wavetable generation/lookup
-        size_t dac_i = (size_t)new_dac_if;
+    for (; s < length && dac_pcm.remaining > 0; s++) {
+        buffer[s] = dac_saturate((int32_t)buffer[s] + dac_pcm_next());
+    }
+}
 
-#if defined(AUDIO_DAC_SAMPLE_WAVEFORM_SINE)
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRIANGLE)
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_TRAPEZOID)
-        value += dac_buffer_trapezoid[dac_i] / active_tones_snapshot_length;
-#elif defined(AUDIO_DAC_SAMPLE_WAVEFORM_SQUARE)
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length;
-#endif
-        /*
-        // SINE
-        value += dac_buffer_sine[dac_i] / active_tones_snapshot_length / 3;
-        // TRIANGLE
-        value += dac_buffer_triangle[dac_i] / active_tones_snapshot_length / 3;
-        // SQUARE
-        value += dac_buffer_square[dac_i] / active_tones_snapshot_length / 3;
-        //NOTE: combination of these three wave-forms is more exemplary - and doesn't sound particularly good :-P
-        */
-
-        // STAIRS (mostly usefully as test-pattern)
-        // value_avg = dac_buffer_staircase[dac_i] / active_tones_snapshot_length;
+void audio_dac_play_sample(const int8_t *samples, uint16_t length, uint8_t volume) {
+    chSysLock();
+    dac_pcm.data      = samples;
+    dac_pcm.remaining = length;
+    dac_pcm.gain      = (volume * (AUDIO_DAC_SAMPLE_MAX / 2)) >> 8;
+    dac_pcm.thirds    = 0;
+    // the timer is stopped whenever no tones are playing
+    if (GPTD6.state != GPT_CONTINUOUS) {
+        gptStartContinuousI(&GPTD6, 2U);
     }
+    chSysUnlock();
+}
 
-    return value;
+bool audio_dac_is_playing_sample(void) {
+    return dac_pcm.remaining > 0;
 }
 
+typedef enum {
+    OUTPUT_SHOULD_START,
+    OUTPUT_RUN_NORMALLY,
+    // path 1: wait for zero, then change/update active tones
+    OUTPUT_TONES_CHANGED,
+    OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE,
+    // path 2: hardware should stop, wait for zero then turn output off = stop the timer
+    OUTPUT_SHOULD_STOP,
+    OUTPUT_REACHED_ZERO_BEFORE_OFF,
+    OUTPUT_OFF,
+    OUTPUT_OFF_1,
+    OUTPUT_OFF_2, // trailing off: giving the DAC two more conversion cycles until the AUDIO_DAC_OFF_VALUE reaches the output, then turn the timer off, which leaves the output at that level
+    number_of_output_states
+} output_states_t;
+output_states_t state = OUTPUT_OFF_2;
+
 /**
  * DAC streaming callback. Does all of the main computing for playing songs.
  *
@@ -196,66 +294,69 @@ static void dac_end(DACDriver *dacp) {
         sample_p += AUDIO_DAC_BUFFER_SIZE / 2; // 'half_index'
     }
 
-    for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
-        if (OUTPUT_OFF <= state) {
-            sample_p[s] = AUDIO_DAC_OFF_VALUE;
-            continue;
-        } else {
-            sample_p[s] = dac_value_generate();
-        }
-
-        /* zero crossing (or approach, whereas zero == DAC_OFF_VALUE, which can be configured to anything from 0 to DAC_SAMPLE_MAX)
-         * ============================*=*========================== AUDIO_DAC_SAMPLE_MAX
-         *                          *       *
-         *                        *           *
-         * ---------------------------------------------------------
-         *                     *                 *                  } AUDIO_DAC_SAMPLE_MAX/100
-         * --------------------------------------------------------- AUDIO_DAC_OFF_VALUE
-         *                  *                       *               } AUDIO_DAC_SAMPLE_MAX/100
-         * ---------------------------------------------------------
-         *               *
-         * *           *
-         *   *       *
-         * =====*=*================================================= 0x0
-         */
-        if (((sample_p[s] + (AUDIO_DAC_SAMPLE_MAX / 100)) > AUDIO_DAC_OFF_VALUE) && // value approaches from below
-            (sample_p[s] < (AUDIO_DAC_OFF_VALUE + (AUDIO_DAC_SAMPLE_MAX / 100)))    // or above
-        ) {
-            if ((OUTPUT_SHOULD_START == state) && (active_tones_snapshot_length > 0)) {
-                state = OUTPUT_RUN_NORMALLY;
-            } else if (OUTPUT_TONES_CHANGED == state) {
-                state = OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE;
-            } else if (OUTPUT_SHOULD_STOP == state) {
-                state = OUTPUT_REACHED_ZERO_BEFORE_OFF;
+    if (OUTPUT_RUN_NORMALLY == state) {
+        // nothing waits for a zero crossing, so the whole half buffer can be mixed in one go
+        dac_buffer_generate(sample_p, AUDIO_DAC_BUFFER_SIZE / 2);
+    } else {
+        for (uint8_t s = 0; s < AUDIO_DAC_BUFFER_SIZE / 2; s++) {
+            if (OUTPUT_OFF <= state) {
+                sample_p[s] = AUDIO_DAC_OFF_VALUE;
+                continue;
+            } else {
+                dac_buffer_generate(&sample_p[s], 1);
             }
-        }
 
-        // still 'ramping up', reset the output to OFF_VALUE until the generated values reach that value, to do a smooth handover
-        if (OUTPUT_SHOULD_START == state) {
-            sample_p[s] = AUDIO_DAC_OFF_VALUE;
-        }
-
-        if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
-            uint8_t active_tones         = MIN(AUDIO_MAX_SIMULTANEOUS_TONES, audio_get_number_of_active_tones());
-            active_tones_snapshot_length = 0;
-            // update the snapshot - once, and only on occasion that something changed;
-            // -> saves cpu cycles (?)
-            for (uint8_t i = 0; i < active_tones; i++) {
-                float freq = audio_get_processed_frequency(i);
-                if (freq > 0) { // disregard 'rest' notes, with valid frequency 0.0f; which would only lower the resulting waveform volume during the additive synthesis step
-                    active_tones_snapshot[active_tones_snapshot_length++] = freq;
+            /* zero crossing (or approach, whereas zero == DAC_OFF_VALUE, which can be configured to anything from 0 to DAC_SAMPLE_MAX)
+             * ============================*=*========================== AUDIO_DAC_SAMPLE_MAX
+             *                          *       *
+             *                        *           *
+             * ---------------------------------------------------------
+             *                     *                 *                  } AUDIO_DAC_SAMPLE_MAX/100
+             * --------------------------------------------------------- AUDIO_DAC_OFF_VALUE
+             *                  *                       *               } AUDIO_DAC_SAMPLE_MAX/100
+             * ---------------------------------------------------------
+             *               *
+             * *           *
+             *   *       *
+             * =====*=*================================================= 0x0
+             */
+            if (((sample_p[s] + (AUDIO_DAC_SAMPLE_MAX / 100)) > AUDIO_DAC_OFF_VALUE) && // value approaches from below
+                (sample_p[s] < (AUDIO_DAC_OFF_VALUE + (AUDIO_DAC_SAMPLE_MAX / 100)))    // or above
+            ) {
+                if ((OUTPUT_SHOULD_START == state) && (dac_voice_count > 0)) {
+                    state = OUTPUT_RUN_NORMALLY;
+                } else if (OUTPUT_TONES_CHANGED == state) {
+                    state = OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE;
+                } else if (OUTPUT_SHOULD_STOP == state) {
+                    state = OUTPUT_REACHED_ZERO_BEFORE_OFF;
                 }
             }
 
-            if ((0 == active_tones_snapshot_length) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
-                state = OUTPUT_OFF;
+            // still 'ramping up', reset the output to OFF_VALUE until the generated values reach that value, to do a smooth handover
+            if (OUTPUT_SHOULD_START == state) {
+                sample_p[s] = AUDIO_DAC_OFF_VALUE;
             }
-            if (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state) {
-                state = OUTPUT_RUN_NORMALLY;
+
+            if ((OUTPUT_SHOULD_START == state) || (OUTPUT_REACHED_ZERO_BEFORE_OFF == state) || (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state)) {
+                // update the snapshot - once, and only on occasion that something changed;
+                // -> saves cpu cycles (?)
+                dac_update_voices();
+
+                if ((0 == dac_voice_count) && (OUTPUT_REACHED_ZERO_BEFORE_OFF == state)) {
+                    state = OUTPUT_OFF;
+                }
+                if (OUTPUT_REACHED_ZERO_BEFORE_TONE_CHANGE == state) {
+                    state = OUTPUT_RUN_NORMALLY;
+                }
             }
         }
     }
 
+    bool pcm_mixed = dac_pcm.remaining > 0;
+    if (pcm_mixed) {
+        dac_mix_pcm(sample_p, AUDIO_DAC_BUFFER_SIZE / 2);
+    }
+
     // update audio internal state (note position, current_note, ...)
     if (audio_update_state()) {
         if (OUTPUT_SHOULD_STOP != state) {
@@ -264,7 +365,10 @@ static void dac_end(DACDriver *dacp) {
     }
 
     if (OUTPUT_OFF <= state) {
-        if (OUTPUT_OFF_2 == state) {
+        if (pcm_mixed) {
+            // a sample played on top of AUDIO_DAC_OFF_VALUE, trail off again once it has finished
+            state = OUTPUT_OFF;
+        } else if (OUTPUT_OFF_2 == state) {
             // stopping timer6 = stopping the DAC at whatever value it is currently pushing to the output = AUDIO_DAC_OFF_VALUE
             gptStopTimer(&GPTD6);
         } else {
@@ -355,14 +459,17 @@ void audio_driver_stop_impl(void) {
 }
 
 void audio_driver_start_impl(void) {
-    gptStartContinuous(&GPTD6, 2U);
+    // a PCM sample may have kept the timer running
+    if (GPTD6.state != GPT_CONTINUOUS) {
+        gptStartContinuous(&GPTD6, 2U);
+    }
 
     for (uint8_t i = 0; i < AUDIO_MAX_SIMULTANEOUS_TONES; i++) {
-        dac_if[i]                = 0.0f;
-        active_tones_snapshot[i] = 0.0f;
+        dac_voices[i].phase     = 0;
+        dac_voices[i].increment = 0;
     }
-    active_tones_snapshot_length = 0;
-    state                        = OUTPUT_SHOULD_START;
+    dac_voice_count = 0;
+    state           = OUTPUT_SHOULD_START;
 }
 
 #pragma GCC diagnostic pop
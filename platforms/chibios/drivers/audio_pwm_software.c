@@ -53,8 +53,10 @@ static PWMConfig pwmCFG = {
 };
 
 static float channel_1_frequency = 0.0f;
+static bool  channel_1_playing   = false; // checked from the pwm interrupt, which should not need to compare floats
 void         channel_1_set_frequency(float freq) {
     channel_1_frequency = freq;
+    channel_1_playing   = freq > 0.0f;
 
     if (freq <= 0.0) // a pause/rest has freq=0
         return;
@@ -100,7 +102,7 @@ static void pwm_audio_period_callback(PWMDriver *pwmp) {
 }
 static void pwm_audio_channel_interrupt_callback(PWMDriver *pwmp) {
     (void)pwmp;
-    if (channel_1_frequency > 0) {
+    if (channel_1_playing) {
         palSetLine(AUDIO_PIN); // generate a PWM signal on any pin, not necessarily the one connected to the timer
 #if defined(AUDIO_PIN_ALT) && defined(AUDIO_PIN_ALT_AS_NEGATIVE)
         palClearLine(AUDIO_PIN_ALT);
@@ -0,0 +1,227 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdint.h>
+#include <hal.h>
+#include "encoder.h"
+#include "gpio.h"
+#include "keyboard.h"
+
+/* Decodes quadrature encoders in hardware, using STM32 general purpose timers
+ * configured in encoder interface mode. The timer counts every edge of both
+ * channels, so the CPU only reads the counter once per scan and converts the
+ * difference to encoder events -- no steps are lost however long the main loop
+ * takes, as long as the knob isn't turned more than 32767 counts in between.
+ */
+
+#if !defined(ENCODER_RESOLUTIONS) && !defined(ENCODER_RESOLUTION)
+#    define ENCODER_RESOLUTION 4
+#endif
+
+#if !defined(ENCODER_TIMERS)
+#    error "No timers defined -- missing ENCODER_TIMERS"
+#endif
+
+#if defined(SPLIT_KEYBOARD) && !defined(ENCODER_TIMERS_RIGHT)
+#    define ENCODER_TIMERS_RIGHT ENCODER_TIMERS
+#endif
+
+#ifndef ENCODER_TIMER_PAL_MODE
+#    define ENCODER_TIMER_PAL_MODE 2 // Alternate function of the timer's CH1/CH2 pins
+#endif
+
+// Input capture filter applied to both channels (0-15), the default samples 8 times at fDTS/32 to reject contact bounce
+#ifndef ENCODER_TIMER_FILTER
+#    define ENCODER_TIMER_FILTER 0xF
+#endif
+
+#if defined(USE_GPIOV1)
+#    define ENCODER_TIMER_PIN_MODE PAL_MODE_INPUT_PULLUP
+#else
+#    define ENCODER_TIMER_PIN_MODE (PAL_MODE_ALTERNATE(ENCODER_TIMER_PAL_MODE) | PAL_STM32_PUPDR_PULLUP)
+#endif
+
+#ifndef ENCODER_DIRECTION_FLIP
+#    define ENCODER_CLOCKWISE true
+#    define ENCODER_COUNTER_CLOCKWISE false
+#else
+#    define ENCODER_CLOCKWISE false
+#    define ENCODER_COUNTER_CLOCKWISE true
+#endif
+
+extern volatile bool isLeftHand;
+
+static pin_t   encoders_pad_a[NUM_ENCODERS_MAX_PER_SIDE] = ENCODER_A_PINS;
+static pin_t   encoders_pad_b[NUM_ENCODERS_MAX_PER_SIDE] = ENCODER_B_PINS;
+static uint8_t encoder_timers[NUM_ENCODERS_MAX_PER_SIDE] = ENCODER_TIMERS;
+
+#ifdef ENCODER_RESOLUTIONS
+static uint8_t encoder_resolutions[NUM_ENCODERS] = ENCODER_RESOLUTIONS;
+#endif
+
+static stm32_tim_t *encoder_tim[NUM_ENCODERS_MAX_PER_SIDE]      = {0};
+static uint16_t     encoder_last_count[NUM_ENCODERS_MAX_PER_SIDE] = {0};
+static int16_t      encoder_pulses[NUM_ENCODERS_MAX_PER_SIDE]     = {0};
+static int32_t      encoder_position[NUM_ENCODERS_MAX_PER_SIDE]   = {0};
+
+static uint8_t thisCount;
+#ifdef SPLIT_KEYBOARD
+static uint8_t thisHand;
+#endif
+
+static stm32_tim_t *encoder_timer_enable(uint8_t timer) {
+    switch (timer) {
+#if STM32_HAS_TIM1
+        case 1:
+            rccEnableTIM1(true);
+            return STM32_TIM1;
+#endif
+#if STM32_HAS_TIM2
+        case 2:
+            rccEnableTIM2(true);
+            return STM32_TIM2;
+#endif
+#if STM32_HAS_TIM3
+        case 3:
+            rccEnableTIM3(true);
+            return STM32_TIM3;
+#endif
+#if STM32_HAS_TIM4
+        case 4:
+            rccEnableTIM4(true);
+            return STM32_TIM4;
+#endif
+#if STM32_HAS_TIM5
+        case 5:
+            rccEnableTIM5(true);
+            return STM32_TIM5;
+#endif
+#if STM32_HAS_TIM8
+        case 8:
+            rccEnableTIM8(true);
+            return STM32_TIM8;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+void encoder_driver_init(void) {
+#ifdef SPLIT_KEYBOARD
+    thisHand  = isLeftHand ? 0 : NUM_ENCODERS_LEFT;
+    thisCount = isLeftHand ? NUM_ENCODERS_LEFT : NUM_ENCODERS_RIGHT;
+
+    if (!isLeftHand) {
+#    if defined(ENCODER_A_PINS_RIGHT) && defined(ENCODER_B_PINS_RIGHT)
+        const pin_t encoders_pad_a_right[] = ENCODER_A_PINS_RIGHT;
+        const pin_t encoders_pad_b_right[] = ENCODER_B_PINS_RIGHT;
+        for (uint8_t i = 0; i < thisCount; i++) {
+            encoders_pad_a[i] = encoders_pad_a_right[i];
+            encoders_pad_b[i] = encoders_pad_b_right[i];
+        }
+#    endif
+        const uint8_t encoder_timers_right[] = ENCODER_TIMERS_RIGHT;
+        for (uint8_t i = 0; i < thisCount; i++) {
+            encoder_timers[i] = encoder_timers_right[i];
+        }
+    }
+#else
+    thisCount = NUM_ENCODERS;
+#endif
+
+#if defined(SPLIT_KEYBOARD) && defined(ENCODER_RESOLUTIONS)
+#    if defined(ENCODER_RESOLUTIONS_RIGHT)
+    static const uint8_t encoder_resolutions_right[NUM_ENCODERS_RIGHT] = ENCODER_RESOLUTIONS_RIGHT;
+#    else
+    static const uint8_t encoder_resolutions_right[NUM_ENCODERS_RIGHT] = ENCODER_RESOLUTIONS;
+#    endif
+    for (uint8_t i = 0; i < NUM_ENCODERS_RIGHT; i++) {
+        encoder_resolutions[NUM_ENCODERS_LEFT + i] = encoder_resolutions_right[i];
+    }
+#endif
+
+    for (uint8_t i = 0; i < thisCount; i++) {
+        stm32_tim_t *tim = encoder_timer_enable(encoder_timers[i]);
+        encoder_tim[i]   = tim;
+        if (!tim) {
+            continue;
+        }
+
+        palSetLineMode(encoders_pad_a[i], ENCODER_TIMER_PIN_MODE);
+        palSetLineMode(encoders_pad_b[i], ENCODER_TIMER_PIN_MODE);
+
+        tim->CR1   = 0;
+        tim->SMCR  = STM32_TIM_SMCR_SMS(3); // Count on both edges of both TI1 and TI2
+        tim->CCMR1 = STM32_TIM_CCMR1_CC1S(1) | STM32_TIM_CCMR1_IC1F(ENCODER_TIMER_FILTER) | STM32_TIM_CCMR1_CC2S(1) | STM32_TIM_CCMR1_IC2F(ENCODER_TIMER_FILTER);
+        tim->CCER  = 0; // Non-inverted inputs
+        tim->PSC   = 0;
+        tim->ARR   = 0xFFFF;
+        tim->CNT   = 0;
+        tim->EGR   = STM32_TIM_EGR_UG;
+        tim->CR1   = STM32_TIM_CR1_CEN;
+
+        encoder_last_count[i] = 0;
+        encoder_pulses[i]     = 0;
+        encoder_position[i]   = 0;
+    }
+}
+
+void encoder_driver_task(void) {
+    for (uint8_t i = 0; i < thisCount; i++) {
+        if (!encoder_tim[i]) {
+            continue;
+        }
+
+        uint8_t index = i;
+#ifdef SPLIT_KEYBOARD
+        index += thisHand;
+#endif
+
+#ifdef ENCODER_TIMER_HIGH_RESOLUTION
+        const int16_t resolution = 1;
+#elif defined(ENCODER_RESOLUTIONS)
+        const int16_t resolution = encoder_resolutions[index];
+#else
+        const int16_t resolution = ENCODER_RESOLUTION;
+#endif
+
+        // The timer counts up when A leads B, which the software decoder treats as negative
+        uint16_t count        = (uint16_t)encoder_tim[i]->CNT;
+        int16_t  delta        = (int16_t)(encoder_last_count[i] - count);
+        encoder_last_count[i] = count;
+        encoder_position[i] += delta;
+        encoder_pulses[i] += delta;
+
+        // Anything that doesn't fit into the event queue stays accumulated until the next scan
+        while (encoder_pulses[i] >= resolution && encoder_queue_event(index, ENCODER_COUNTER_CLOCKWISE)) {
+            encoder_pulses[i] -= resolution;
+        }
+        while (encoder_pulses[i] <= -resolution && encoder_queue_event(index, ENCODER_CLOCKWISE)) {
+            encoder_pulses[i] += resolution;
+        }
+
+#ifdef ENCODER_DEFAULT_POS
+        // Like the software decoder, a partial step is completed once the encoder comes to rest in its default position
+        uint8_t state = (gpio_read_pin(encoders_pad_a[i]) ? 1 : 0) | (gpio_read_pin(encoders_pad_b[i]) ? 2 : 0);
+        if (state == ENCODER_DEFAULT_POS && encoder_pulses[i] != 0) {
+            if (encoder_queue_event(index, encoder_pulses[i] > 0 ? ENCODER_COUNTER_CLOCKWISE : ENCODER_CLOCKWISE)) {
+                encoder_pulses[i] = 0;
+            }
+        }
+#endif
+    }
+}
+
+int32_t encoder_timer_get_position(uint8_t index) {
+#ifdef SPLIT_KEYBOARD
+    if (index < thisHand || index >= thisHand + thisCount) {
+        return 0;
+    }
+    index -= thisHand;
+#else
+    if (index >= thisCount) {
+        return 0;
+    }
+#endif
+    return encoder_position[index];
+}
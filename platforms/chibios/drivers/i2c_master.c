@@ -90,6 +90,30 @@
 #    endif
 #endif
 
+#ifdef I2C_ASYNC_ENABLE
+#    ifndef I2C_ASYNC_QUEUE_SIZE
+#        define I2C_ASYNC_QUEUE_SIZE 8
+#    endif
+#    ifndef I2C_ASYNC_SCRATCH_SIZE
+#        define I2C_ASYNC_SCRATCH_SIZE 64
+#    endif
+#    ifndef I2C_ASYNC_THREAD_PRIORITY
+#        define I2C_ASYNC_THREAD_PRIORITY (NORMALPRIO + 1)
+#    endif
+// Leaves room for the HAL's error path, which stops and restarts the driver
+#    ifndef I2C_ASYNC_THREAD_STACK_SIZE
+#        define I2C_ASYNC_THREAD_STACK_SIZE 512
+#    endif
+
+// Serialises access to the bus between the blocking API and the async worker thread
+static MUTEX_DECL(i2c_bus_mutex);
+#    define i2c_bus_lock() chMtxLock(&i2c_bus_mutex)
+#    define i2c_bus_unlock() chMtxUnlock(&i2c_bus_mutex)
+#else
+#    define i2c_bus_lock()
+#    define i2c_bus_unlock()
+#endif
+
 static const I2CConfig i2cconfig = {
 #if defined(USE_I2CV1_CONTRIB)
     I2C1_CLOCK_SPEED,
@@ -149,33 +173,39 @@ __attribute__((weak)) void i2c_init(void) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t ret = i2c_epilogue(status);
+    i2c_bus_unlock();
+    return ret;
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (address >> 1), data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t ret = i2c_epilogue(status);
+    i2c_bus_unlock();
+    return ret;
 }
 
 i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
-
     uint8_t complete_packet[length + 1];
     for (uint16_t i = 0; i < length; i++) {
         complete_packet[i + 1] = data[i];
     }
     complete_packet[0] = regaddr;
 
+    i2c_bus_lock();
+    i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), complete_packet, length + 1, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t ret = i2c_epilogue(status);
+    i2c_bus_unlock();
+    return ret;
 }
 
 i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
-
     uint8_t complete_packet[length + 2];
     for (uint16_t i = 0; i < length; i++) {
         complete_packet[i + 2] = data[i];
@@ -183,21 +213,31 @@ i2c_status_t i2c_write_register16(uint8_t devaddr, uint16_t regaddr, const uint8
     complete_packet[0] = regaddr >> 8;
     complete_packet[1] = regaddr & 0xFF;
 
+    i2c_bus_lock();
+    i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), complete_packet, length + 2, 0, 0, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t ret = i2c_epilogue(status);
+    i2c_bus_unlock();
+    return ret;
 }
 
 i2c_status_t i2c_read_register(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_bus_lock();
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_status_t ret = i2c_epilogue(status);
+    i2c_bus_unlock();
+    return ret;
 }
 
 i2c_status_t i2c_read_register16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
-    i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
-    msg_t   status             = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
-    return i2c_epilogue(status);
+    i2c_bus_lock();
+    i2cStart(&I2C_DRIVER, &i2cconfig);
+    msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (devaddr >> 1), register_packet, 2, data, length, TIME_MS2I(timeout));
+    i2c_status_t ret = i2c_epilogue(status);
+    i2c_bus_unlock();
+    return ret;
 }
 
 __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t timeout) {
@@ -206,4 +246,157 @@ __attribute__((weak)) i2c_status_t i2c_ping_address(uint8_t address, uint16_t ti
     // This approach may produce false negative results for I2C devices that do not respond to a register 0 read request.
     uint8_t data = 0;
     return i2c_read_register(address, 0, &data, sizeof(data), timeout);
-}
\ No newline at end of file
+}
+
+#ifdef I2C_ASYNC_ENABLE
+
+static i2c_async_transfer_t* volatile i2c_async_queue[I2C_ASYNC_QUEUE_SIZE];
+static uint8_t                         i2c_async_queue_head = 0;
+static uint8_t                         i2c_async_queue_tail = 0;
+static SEMAPHORE_DECL(i2c_async_pending, 0);
+static THREADS_QUEUE_DECL(i2c_async_waiters);
+
+/**
+ * @brief Executes a single transfer from a chain, prepending the register
+ * address to any outgoing data.
+ */
+static i2c_status_t i2c_async_execute(i2c_async_transfer_t* transfer) {
+    static uint8_t scratch[I2C_ASYNC_SCRATCH_SIZE];
+    const uint8_t* tx_data   = transfer->tx_data;
+    size_t         tx_length = transfer->tx_length;
+
+    if (transfer->reg_length > 0) {
+        if (transfer->reg_length > 2 || transfer->reg_length + tx_length > sizeof(scratch)) {
+            return I2C_STATUS_ERROR;
+        }
+        if (transfer->reg_length == 2) {
+            scratch[0] = transfer->reg >> 8;
+            scratch[1] = transfer->reg & 0xFF;
+        } else {
+            scratch[0] = transfer->reg & 0xFF;
+        }
+        for (size_t i = 0; i < tx_length; i++) {
+            scratch[transfer->reg_length + i] = tx_data[i];
+        }
+        tx_data = scratch;
+        tx_length += transfer->reg_length;
+    }
+
+    i2cStart(&I2C_DRIVER, &i2cconfig);
+    msg_t status;
+    if (tx_length > 0) {
+        status = i2cMasterTransmitTimeout(&I2C_DRIVER, (transfer->address >> 1), tx_data, tx_length, transfer->rx_data, transfer->rx_length, TIME_MS2I(transfer->timeout));
+    } else {
+        status = i2cMasterReceiveTimeout(&I2C_DRIVER, (transfer->address >> 1), transfer->rx_data, transfer->rx_length, TIME_MS2I(transfer->timeout));
+    }
+    return i2c_epilogue(status);
+}
+
+/**
+ * @brief This thread executes submitted transfer chains back-to-back, leaving
+ * the main loop free while the bus is busy.
+ */
+static THD_WORKING_AREA(waI2CAsyncThread, I2C_ASYNC_THREAD_STACK_SIZE);
+static THD_FUNCTION(I2CAsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("i2c_async");
+
+    while (true) {
+        chSemWait(&i2c_async_pending);
+
+        chSysLock();
+        i2c_async_transfer_t* transfer = i2c_async_queue[i2c_async_queue_tail];
+        i2c_async_queue_tail           = (i2c_async_queue_tail + 1) % I2C_ASYNC_QUEUE_SIZE;
+        chSysUnlock();
+
+        i2c_bus_lock();
+        i2c_status_t status = I2C_STATUS_SUCCESS;
+        for (; transfer; transfer = transfer->next) {
+            // Once a transfer fails, the rest of the chain is abandoned
+            if (status == I2C_STATUS_SUCCESS) {
+                status = i2c_async_execute(transfer);
+            }
+            transfer->status = status;
+        }
+        i2c_bus_unlock();
+
+        chSysLock();
+        chThdDequeueAllI(&i2c_async_waiters, MSG_OK);
+        chSchRescheduleS();
+        chSysUnlock();
+    }
+}
+
+bool i2c_async_submit(i2c_async_transfer_t* chain) {
+    static bool thread_started = false;
+    if (!thread_started) {
+        thread_started = true;
+        chThdCreateStatic(waI2CAsyncThread, sizeof(waI2CAsyncThread), I2C_ASYNC_THREAD_PRIORITY, I2CAsyncThread, NULL);
+    }
+
+    if (!chain) {
+        return false;
+    }
+
+    for (i2c_async_transfer_t* transfer = chain; transfer; transfer = transfer->next) {
+        transfer->status = I2C_STATUS_PENDING;
+    }
+
+    chSysLock();
+    uint8_t next_head = (i2c_async_queue_head + 1) % I2C_ASYNC_QUEUE_SIZE;
+    if (next_head == i2c_async_queue_tail) {
+        chSysUnlock();
+        for (i2c_async_transfer_t* transfer = chain; transfer; transfer = transfer->next) {
+            transfer->status = I2C_STATUS_ERROR;
+        }
+        return false;
+    }
+    i2c_async_queue[i2c_async_queue_head] = chain;
+    i2c_async_queue_head                  = next_head;
+    chSemSignalI(&i2c_async_pending);
+    chSchRescheduleS();
+    chSysUnlock();
+    return true;
+}
+
+bool i2c_async_is_complete(const i2c_async_transfer_t* chain) {
+    for (; chain; chain = chain->next) {
+        if (chain->status == I2C_STATUS_PENDING) {
+            return false;
+        }
+    }
+    return true;
+}
+
+i2c_status_t i2c_async_wait(const i2c_async_transfer_t* chain, uint16_t timeout) {
+    sysinterval_t wait_time = (timeout == I2C_TIMEOUT_INFINITE) ? TIME_INFINITE : TIME_MS2I(timeout);
+    systime_t     start     = chVTGetSystemTimeX();
+
+    chSysLock();
+    while (!i2c_async_is_complete(chain)) {
+        // The worker wakes every waiter after each chain, so the timeout runs from the start of the call rather than the last wakeup
+        sysinterval_t remaining = TIME_INFINITE;
+        if (wait_time != TIME_INFINITE) {
+            sysinterval_t elapsed = chVTTimeElapsedSinceX(start);
+            if (elapsed >= wait_time) {
+                chSysUnlock();
+                return I2C_STATUS_TIMEOUT;
+            }
+            remaining = wait_time - elapsed;
+        }
+        if (chThdEnqueueTimeoutS(&i2c_async_waiters, remaining) == MSG_TIMEOUT) {
+            chSysUnlock();
+            return I2C_STATUS_TIMEOUT;
+        }
+    }
+    chSysUnlock();
+
+    for (; chain; chain = chain->next) {
+        if (chain->status != I2C_STATUS_SUCCESS) {
+            return chain->status;
+        }
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+#endif // I2C_ASYNC_ENABLE
@@ -16,6 +16,9 @@
 
 #include "spi_master.h"
 #include "chibios_config.h"
+#ifdef SPI_ASYNC_ENABLE
+#    include "timer.h"
+#endif
 #include <ch.h>
 #include <hal.h>
 
@@ -67,6 +70,23 @@ static bool  current_cs_active_low = true;
 
 static SPIConfig spiConfig;
 
+#ifdef SPI_ASYNC_ENABLE
+static volatile bool        spi_async_in_progress = false;
+static spi_async_callback_t spi_async_callback    = NULL;
+static void *               spi_async_cb_arg      = NULL;
+
+// Invoked from the SPI interrupt at the end of every transfer, including synchronous ones
+static void spi_async_end_cb(SPIDriver *spip) {
+    (void)spip;
+    if (spi_async_in_progress) {
+        spi_async_in_progress = false;
+        if (spi_async_callback) {
+            spi_async_callback(spi_async_cb_arg);
+        }
+    }
+}
+#endif // SPI_ASYNC_ENABLE
+
 static inline void spi_select(void) {
     spiSelect(&SPI_DRIVER);
 
@@ -405,6 +425,14 @@ bool spi_start_extended(spi_start_config_t *start_config) {
 #    error "Unsupported SPI_SELECT_MODE"
 #endif
 
+#ifdef SPI_ASYNC_ENABLE
+#    ifdef HAL_LLD_SELECT_SPI_V2
+    spiConfig.data_cb = spi_async_end_cb;
+#    else
+    spiConfig.end_cb = spi_async_end_cb;
+#    endif
+#endif // SPI_ASYNC_ENABLE
+
     spiStart(&SPI_DRIVER, &spiConfig);
     spi_select();
 
@@ -445,13 +473,52 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+#ifdef SPI_ASYNC_ENABLE
+spi_status_t spi_transmit_async(const uint8_t *data, uint16_t length, spi_async_callback_t callback, void *cb_arg) {
+    if (spi_async_in_progress) {
+        return SPI_STATUS_ERROR;
+    }
+
+    spi_async_callback    = callback;
+    spi_async_cb_arg      = cb_arg;
+    spi_async_in_progress = true;
+    spiStartSend(&SPI_DRIVER, length, data);
+    return SPI_STATUS_SUCCESS;
+}
+
+bool spi_async_busy(void) {
+    return spi_async_in_progress;
+}
+
+spi_status_t spi_async_wait(uint16_t timeout) {
+    uint16_t timeout_timer = timer_read();
+    while (spi_async_in_progress) {
+        if ((timeout != SPI_TIMEOUT_INFINITE) && (timer_elapsed(timeout_timer) >= timeout)) {
+            return SPI_STATUS_TIMEOUT;
+        }
+    }
+    return SPI_STATUS_SUCCESS;
+}
+#endif // SPI_ASYNC_ENABLE
+
 void spi_stop(void) {
+#ifdef SPI_ASYNC_ENABLE
+    // Give an outstanding transmission the chance to complete -- if its completion was lost, spiStop() aborts it
+    if (spi_async_wait(SPI_ASYNC_TIMEOUT) != SPI_STATUS_SUCCESS) {
+        spi_async_callback = NULL;
+    }
+#endif // SPI_ASYNC_ENABLE
+
     if (spiStarted) {
         spi_unselect();
         spiStop(&SPI_DRIVER);
         spiStarted = false;
     }
 
+#ifdef SPI_ASYNC_ENABLE
+    spi_async_in_progress = false;
+#endif // SPI_ASYNC_ENABLE
+
 #if (SPI_USE_MUTUAL_EXCLUSION == TRUE)
     spiReleaseBus(&SPI_DRIVER);
 #endif // (SPI_USE_MUTUAL_EXCLUSION == TRUE)
@@ -347,6 +347,12 @@ void register_mouse(uint8_t mouse_keycode, bool pressed) {
             pointing_device_keycode_handler(mouse_keycode, pressed);
 #        endif
             break;
+#    endif
+#    ifdef MOUSEKEY_FRAME_INTEGRATION
+        case QK_MOUSE_CURSOR_UP ... QK_MOUSE_CURSOR_RIGHT:
+        case QK_MOUSE_WHEEL_UP ... QK_MOUSE_ACCELERATION_2:
+            // motion is integrated by mousekey_task, and goes out with the next frame
+            break;
 #    endif
         default:
             mousekey_send();
@@ -304,10 +304,21 @@ void send_nkro_report(void) {
     nkro_report->mods = get_mods_for_report();
 
     static report_nkro_t last_report;
+    bool                 changed = nkro_report->mods != last_report.mods;
+
+    /* Only compare the bytes touched since the last report, rather than the whole bitmap. */
+    last_report.mods = nkro_report->mods;
+    for (uint32_t bytes = take_nkro_bits_changed(); bytes;) {
+        uint8_t i = biton32(bytes);
+        bytes &= ~((uint32_t)1 << i);
+        if (nkro_report->bits[i] != last_report.bits[i]) {
+            last_report.bits[i] = nkro_report->bits[i];
+            changed             = true;
+        }
+    }
 
     /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(nkro_report, &last_report, sizeof(report_nkro_t)) != 0) {
-        memcpy(&last_report, nkro_report, sizeof(report_nkro_t));
+    if (changed) {
         host_nkro_send(nkro_report);
     }
 }
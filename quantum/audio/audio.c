@@ -21,6 +21,7 @@
 #include "wait.h"
 #include "util.h"
 #include "gpio.h"
+#include "progmem.h"
 
 /* audio system:
  *
@@ -77,6 +78,9 @@
 uint8_t        active_tones = 0;            // number of tones pushed onto the stack by audio_play_tone - might be more than the hardware is able to reproduce at any single time
 musical_tone_t tones[AUDIO_TONE_STACKSIZE]; // stack of currently active tones
 
+// pitch of the unused entries on the tones stack, and of no note at all; distinct from 0, which is a rest
+#define TONE_PITCH_NONE UINT32_MAX
+
 bool playing_melody = false; // playing a SONG?
 bool playing_note   = false; // or (possibly multiple simultaneous) tones
 bool state_changed  = false; // global flag, which is set if anything changes with the active_tones
@@ -91,6 +95,19 @@ uint16_t current_note                 = 0;             // index into the array a
 bool     note_resting                 = false;         // if a short pause was introduced between two notes with the same frequency while playing a melody
 uint16_t last_timestamp               = 0;
 
+static const audio_compact_note_t *compact_notes_pointer = NULL; // or a precompiled SONG, used instead of notes_pointer if set
+
+#ifndef AUDIO_SONG_QUEUE_SIZE
+#    define AUDIO_SONG_QUEUE_SIZE 4
+#endif
+// ring buffer of precompiled SONGs waiting to be played; the tail is only moved by audio_queue_compact_song, the head by the melody playback and audio_stop_all
+static struct {
+    const audio_compact_note_t *notes;
+    uint16_t                    count;
+} song_queue[AUDIO_SONG_QUEUE_SIZE + 1]; // one entry stays free, to tell a full queue from an empty one
+static uint8_t song_queue_head = 0;
+static uint8_t song_queue_tail = 0;
+
 #ifdef AUDIO_ENABLE_TONE_MULTIPLEXING
 #    ifndef AUDIO_MAX_SIMULTANEOUS_TONES
 #        define AUDIO_MAX_SIMULTANEOUS_TONES 3
@@ -114,9 +131,9 @@ extern uint16_t voices_timer;
 #ifndef AUDIO_OFF_SONG
 #    define AUDIO_OFF_SONG SONG(AUDIO_OFF_SOUND)
 #endif
-float startup_song[][2]   = STARTUP_SONG;
-float audio_on_song[][2]  = AUDIO_ON_SONG;
-float audio_off_song[][2] = AUDIO_OFF_SONG;
+const audio_compact_note_t startup_song[] PROGMEM   = STARTUP_SONG;
+const audio_compact_note_t audio_on_song[] PROGMEM  = AUDIO_ON_SONG;
+const audio_compact_note_t audio_off_song[] PROGMEM = AUDIO_OFF_SONG;
 
 static bool    audio_initialized    = false;
 static bool    audio_driver_stopped = true;
@@ -171,7 +188,7 @@ void audio_init(void) {
     }
 
     for (uint8_t i = 0; i < AUDIO_TONE_STACKSIZE; i++) {
-        tones[i] = (musical_tone_t){.time_started = 0, .pitch = -1.0f, .duration = 0};
+        tones[i] = (musical_tone_t){.time_started = 0, .pitch = TONE_PITCH_NONE, .duration = 0};
     }
 
     audio_driver_initialize();
@@ -185,7 +202,7 @@ void audio_init(void) {
 
 void audio_startup(void) {
     if (audio_config.enable) {
-        PLAY_SONG(startup_song);
+        PLAY_COMPACT_SONG(startup_song);
     }
 
     last_timestamp = timer_read();
@@ -208,11 +225,11 @@ void audio_on(void) {
     audio_config.enable = 1;
     eeconfig_update_audio(audio_config.raw);
     audio_on_user();
-    PLAY_SONG(audio_on_song);
+    PLAY_COMPACT_SONG(audio_on_song);
 }
 
 void audio_off(void) {
-    PLAY_SONG(audio_off_song);
+    PLAY_COMPACT_SONG(audio_off_song);
     audio_off_user();
     wait_ms(100);
     audio_stop_all();
@@ -224,7 +241,8 @@ bool audio_is_on(void) {
     return (audio_config.enable != 0);
 }
 
-void audio_stop_all(void) {
+// Stops whatever is sounding right now, leaving the song queue alone
+static void audio_stop_playback(void) {
     if (audio_driver_stopped) {
         return;
     }
@@ -239,17 +257,18 @@ void audio_stop_all(void) {
     melody_current_note_duration = 0;
 
     for (uint8_t i = 0; i < AUDIO_TONE_STACKSIZE; i++) {
-        tones[i] = (musical_tone_t){.time_started = 0, .pitch = -1.0f, .duration = 0};
+        tones[i] = (musical_tone_t){.time_started = 0, .pitch = TONE_PITCH_NONE, .duration = 0};
     }
 
     audio_driver_stopped = true;
 }
 
-void audio_stop_tone(float pitch) {
-    if (pitch < 0.0f) {
-        pitch = -1 * pitch;
-    }
+void audio_stop_all(void) {
+    song_queue_head = song_queue_tail;
+    audio_stop_playback();
+}
 
+static void audio_stop_tone_q16(uint32_t pitch) {
     if (playing_note) {
         if (!audio_initialized) {
             audio_init();
@@ -261,7 +280,7 @@ void audio_stop_tone(float pitch) {
                 for (int j = i; (j < AUDIO_TONE_STACKSIZE - 1); j++) {
                     tones[j] = tones[j + 1];
                 }
-                tones[AUDIO_TONE_STACKSIZE - 1] = (musical_tone_t){.time_started = 0, .pitch = -1.0f, .duration = 0};
+                tones[AUDIO_TONE_STACKSIZE - 1] = (musical_tone_t){.time_started = 0, .pitch = TONE_PITCH_NONE, .duration = 0};
                 break;
             }
         }
@@ -285,7 +304,11 @@ void audio_stop_tone(float pitch) {
     }
 }
 
-void audio_play_note(float pitch, uint16_t duration) {
+void audio_stop_tone(float pitch) {
+    audio_stop_tone_q16(audio_pitch_to_q16(pitch));
+}
+
+static void audio_play_note_q16(uint32_t pitch, uint16_t duration) {
     if (!audio_config.enable) {
         return;
     }
@@ -294,10 +317,6 @@ void audio_play_note(float pitch, uint16_t duration) {
         audio_init();
     }
 
-    if (pitch < 0.0f) {
-        pitch = -1 * pitch;
-    }
-
     // round-robin: shifting out old tones, keeping only unique ones
     // if the new frequency is already amongst the active tones, shift it to the top of the stack
     bool found = false;
@@ -334,11 +353,31 @@ void audio_play_note(float pitch, uint16_t duration) {
     }
 }
 
+void audio_play_note(float pitch, uint16_t duration) {
+    audio_play_note_q16(audio_pitch_to_q16(pitch), duration);
+}
+
 void audio_play_tone(float pitch) {
     audio_play_note(pitch, 0xffff);
 }
 
-void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+// in Q16.16 fixed point Hz
+static uint32_t melody_pitch(uint16_t note) {
+    if (compact_notes_pointer) {
+        return AUDIO_HZ_Q16(pgm_read_word(&compact_notes_pointer[note].pitch));
+    }
+    return audio_pitch_to_q16((*notes_pointer)[note][0]);
+}
+
+// in 64ths of a beat
+static uint16_t melody_duration(uint16_t note) {
+    if (compact_notes_pointer) {
+        return pgm_read_word(&compact_notes_pointer[note].duration);
+    }
+    return (*notes_pointer)[note][1];
+}
+
+static void melody_start(float (*np)[][2], const audio_compact_note_t *cnp, uint16_t n_count, bool n_repeat) {
     if (!audio_config.enable) {
         audio_stop_all();
         return;
@@ -352,27 +391,83 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
         audio_init();
     }
 
-    // Cancel note if a note is playing
-    if (playing_note) audio_stop_all();
+    // Cancel note if a note is playing, songs already queued still follow
+    if (playing_note) audio_stop_playback();
 
     playing_melody = true;
     note_resting   = false;
 
-    notes_pointer = np;
-    notes_count   = n_count;
-    notes_repeat  = n_repeat;
+    notes_pointer         = np;
+    compact_notes_pointer = cnp;
+    notes_count           = n_count;
+    notes_repeat          = n_repeat;
 
     current_note = 0; // note in the melody-array/list at note_pointer
 
     // start first note manually, which also starts the audio_driver
     // all following/remaining notes are played by 'audio_update_state'
-    audio_play_note((*notes_pointer)[current_note][0], audio_duration_to_ms((*notes_pointer)[current_note][1]));
+    audio_play_note_q16(melody_pitch(current_note), audio_duration_to_ms(melody_duration(current_note)));
     last_timestamp               = timer_read();
-    melody_current_note_duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+    melody_current_note_duration = audio_duration_to_ms(melody_duration(current_note));
+}
+
+void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat) {
+    melody_start(np, NULL, n_count, n_repeat);
+}
+
+void audio_play_compact_song(const audio_compact_note_t *notes, uint16_t n_count, bool n_repeat) {
+    melody_start(NULL, notes, n_count, n_repeat);
+}
+
+bool audio_queue_compact_song(const audio_compact_note_t *notes, uint16_t n_count) {
+    if (!audio_config.enable) {
+        return false;
+    }
+
+    if (!playing_melody) {
+        audio_play_compact_song(notes, n_count, false);
+        return true;
+    }
+
+    uint8_t tail = (song_queue_tail + 1) % (AUDIO_SONG_QUEUE_SIZE + 1);
+    if (tail == song_queue_head) {
+        return false;
+    }
+    song_queue[song_queue_tail].notes = notes;
+    song_queue[song_queue_tail].count = n_count;
+    song_queue_tail                   = tail;
+    return true;
+}
+
+/**
+ * Switches the melody over to the next queued SONG, without stopping the driver in between.
+ */
+static bool melody_next_queued(void) {
+    while (song_queue_head != song_queue_tail) {
+        const audio_compact_note_t *notes = song_queue[song_queue_head].notes;
+        uint16_t                    count = song_queue[song_queue_head].count;
+        song_queue_head                   = (song_queue_head + 1) % (AUDIO_SONG_QUEUE_SIZE + 1);
+
+        if (count > 0) {
+            notes_pointer         = NULL;
+            compact_notes_pointer = notes;
+            notes_count           = count;
+            notes_repeat          = false;
+            current_note          = 0;
+            return true;
+        }
+    }
+    return false;
 }
 
 float click[2][2];
 void  audio_play_click(uint16_t delay, float pitch, uint16_t duration) {
+    if (playing_melody && delay == 0) {
+        // mixed into the melody, which keeps playing underneath
+        audio_play_note(pitch, duration);
+        return;
+    }
+
     uint16_t duration_tone  = audio_ms_to_duration(duration);
     uint16_t duration_delay = audio_ms_to_duration(delay);
 
@@ -409,12 +504,16 @@ float audio_get_frequency(uint8_t tone_index) {
     if (tone_index >= active_tones) {
         return 0.0f;
     }
-    return tones[active_tones - tone_index - 1].pitch;
+    return tones[active_tones - tone_index - 1].pitch / 65536.0f;
 }
 
 float audio_get_processed_frequency(uint8_t tone_index) {
+    return audio_get_processed_frequency_q16(tone_index) / 65536.0f;
+}
+
+uint32_t audio_get_processed_frequency_q16(uint8_t tone_index) {
     if (tone_index >= active_tones) {
-        return 0.0f;
+        return 0;
     }
 
     int8_t index = active_tones - tone_index - 1;
@@ -426,8 +525,8 @@ float audio_get_processed_frequency(uint8_t tone_index) {
         index += active_tones;
 #endif
 
-    if (tones[index].pitch <= 0.0f) {
-        return 0.0f;
+    if (tones[index].pitch == 0) {
+        return 0;
     }
 
     return voice_envelope(tones[index].pitch);
@@ -444,27 +543,30 @@ bool audio_update_state(void) {
     if (playing_melody) {
         goto_next_note = timer_elapsed(last_timestamp) >= melody_current_note_duration;
         if (goto_next_note) {
-            uint16_t delta         = timer_elapsed(last_timestamp) - melody_current_note_duration;
-            last_timestamp         = current_time;
-            uint16_t previous_note = current_note;
+            uint16_t delta          = timer_elapsed(last_timestamp) - melody_current_note_duration;
+            last_timestamp          = current_time;
+            uint16_t previous_note  = current_note;
+            uint32_t previous_pitch = melody_pitch(current_note);
             current_note++;
             voices_timer = timer_read(); // reset to zero, for the effects added by voices.c
 
             if (current_note >= notes_count) {
                 if (notes_repeat) {
                     current_note = 0;
+                } else if (melody_next_queued()) {
+                    previous_pitch = TONE_PITCH_NONE; // previous_note belongs to the last song, so no pause can be inserted to separate the two
                 } else {
                     audio_stop_all();
                     return false;
                 }
             }
 
-            if (!note_resting && (*notes_pointer)[previous_note][0] == (*notes_pointer)[current_note][0]) {
+            if (!note_resting && previous_pitch == melody_pitch(current_note)) {
                 note_resting = true;
 
                 // special handling for successive notes of the same frequency:
                 // insert a short pause to separate them audibly
-                audio_play_note(0.0f, audio_duration_to_ms(2));
+                audio_play_note_q16(0, audio_duration_to_ms(2));
                 current_note                 = previous_note;
                 melody_current_note_duration = audio_duration_to_ms(2);
 
@@ -483,13 +585,13 @@ bool audio_update_state(void) {
 
                 // '- delta': Skip forward in the next note's length if we've over shot
                 //            the last, so the overall length of the song is the same
-                uint16_t duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                uint16_t duration = audio_duration_to_ms(melody_duration(current_note));
 
                 // Skip forward past any completely missed notes
                 while (delta > duration && current_note < notes_count - 1) {
                     delta -= duration;
                     current_note++;
-                    duration = audio_duration_to_ms((*notes_pointer)[current_note][1]);
+                    duration = audio_duration_to_ms(melody_duration(current_note));
                 }
 
                 if (delta < duration) {
@@ -500,7 +602,7 @@ bool audio_update_state(void) {
                     duration = 1;
                 }
 
-                audio_play_note((*notes_pointer)[current_note][0], duration);
+                audio_play_note_q16(melody_pitch(current_note), duration);
                 melody_current_note_duration = duration;
             }
         }
@@ -522,7 +624,7 @@ bool audio_update_state(void) {
                 && (tones[i].duration != 0)   // 'uninitialized'
             ) {
                 if (timer_elapsed(tones[i].time_started) >= tones[i].duration) {
-                    audio_stop_tone(tones[i].pitch); // also sets 'state_changed=true'
+                    audio_stop_tone_q16(tones[i].pitch); // also sets 'state_changed=true'
                 }
             }
         }
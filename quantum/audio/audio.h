@@ -40,6 +40,17 @@ typedef union {
 
 _Static_assert(sizeof(audio_config_t) == sizeof(uint8_t), "Audio EECONFIG out of spec.");
 
+/*
+ * Frequencies are kept in Q16.16 fixed point Hz internally, so that the
+ * effects applied on each state update need no floating point math; the
+ * float pitches of the public interface are converted once per note.
+ */
+#define AUDIO_HZ_Q16(hz) ((uint32_t)(hz) << 16)
+
+static inline uint32_t audio_pitch_to_q16(float pitch) {
+    return (uint32_t)((pitch < 0.0f ? -pitch : pitch) * 65536.0f);
+}
+
 /*
  * a 'musical note' is represented by pitch and duration; a 'musical tone' adds intensity and timbre
  * https://en.wikipedia.org/wiki/Musical_tone
@@ -47,7 +58,7 @@ _Static_assert(sizeof(audio_config_t) == sizeof(uint8_t), "Audio EECONFIG out of
  */
 typedef struct {
     uint16_t time_started; // timestamp the tone/note was started, system time runs with 1ms resolution -> 16bit timer overflows every ~64 seconds, long enough under normal circumstances; but might be too soon for long-duration notes when the note_tempo is set to a very low value
-    float    pitch;        // aka frequency, in Hz
+    uint32_t pitch;        // aka frequency, in Hz as Q16.16 fixed point
     uint16_t duration;     // in ms, converted from the musical_notes.h unit which has 64parts to a beat, factoring in the current tempo in beats-per-minute
     // float intensity;    // aka volume [0,1] TODO: not used at the moment; pwm drivers can't handle it
     // uint8_t timbre;     // range: [0,100] TODO: this currently kept track of globally, should we do this per tone instead?
@@ -145,6 +156,8 @@ void audio_play_melody(float (*np)[][2], uint16_t n_count, bool n_repeat);
  * @details constructs a two-note melody (one pause plus a note) and plays it through
  *          audio_play_melody. very short durations might not quite work due to
  *          hardware limitations (DAC: added pulses from zero-crossing feature;...)
+ *          without a delay, a click during a melody is played as a tone on top of
+ *          it, instead of replacing the melody
  *
  * @param[in] delay in milliseconds, length for the pause before the pulses, can be zero
  * @param[in] pitch
@@ -170,6 +183,41 @@ bool audio_is_playing_note(void);
  */
 bool audio_is_playing_melody(void);
 
+/**
+ * @brief a note of a precompiled SONG
+ *
+ * @details the same SONG/MUSICAL_NOTE definitions initialize an array of these
+ *          instead of float-tuples, at a quarter of the size - with the pitch
+ *          rounded down to whole Hz, and the duration in 64ths of a beat:
+ *              const audio_compact_note_t my_song[] PROGMEM = SONG(STARTUP_SOUND);
+ */
+typedef struct {
+    uint16_t pitch;
+    uint16_t duration;
+} audio_compact_note_t;
+
+/**
+ * @brief play a precompiled melody
+ *
+ * @details like audio_play_melody, but for a SONG stored as audio_compact_note_t
+ *          in PROGMEM; songs already queued still play after it
+ *
+ * @param[in] notes the SONG array
+ * @param[in] n_count number of notes of the SONG
+ * @param[in] n_repeat false for onetime, true for looped playback
+ */
+void audio_play_compact_song(const audio_compact_note_t *notes, uint16_t n_count, bool n_repeat);
+
+/**
+ * @brief queue a precompiled melody, to be played after the current one ends
+ *
+ * @details starts playback right away if no melody is playing; queued songs are
+ *          dropped by audio_stop_all
+ *
+ * @return false if the queue is full, or audio is off
+ */
+bool audio_queue_compact_song(const audio_compact_note_t *notes, uint16_t n_count);
+
 // These macros are used to allow audio_play_melody to play an array of indeterminate
 // length. This works around the limitation of C's sizeof operation on pointers.
 // The global float array for the song must be used here.
@@ -185,6 +233,13 @@ bool audio_is_playing_melody(void);
  */
 #define PLAY_LOOP(note_array) audio_play_melody(&note_array, NOTE_ARRAY_SIZE((note_array)), true)
 
+/**
+ * @brief convenience macros, to play or queue a precompiled melody/SONG
+ */
+#define PLAY_COMPACT_SONG(note_array) audio_play_compact_song(note_array, NOTE_ARRAY_SIZE((note_array)), false)
+#define PLAY_COMPACT_LOOP(note_array) audio_play_compact_song(note_array, NOTE_ARRAY_SIZE((note_array)), true)
+#define QUEUE_COMPACT_SONG(note_array) audio_queue_compact_song(note_array, NOTE_ARRAY_SIZE((note_array)))
+
 // Tone-Multiplexing functions
 // this feature only makes sense for hardware setups which can't do proper
 // audio-wave synthesis = have no DAC and need to use PWM for tone generation
@@ -249,6 +304,12 @@ float audio_get_frequency(uint8_t tone_index);
  */
 float audio_get_processed_frequency(uint8_t tone_index);
 
+/**
+ * @brief like audio_get_processed_frequency, without the conversion from fixed point
+ * @return a positive frequency, in Hz as Q16.16 fixed point; or zero if the tone is a pause
+ */
+uint32_t audio_get_processed_frequency_q16(uint8_t tone_index);
+
 /**
  * @brief   update audio internal state: currently playing and active tones,...
  * @details This function is intended to be called by the audio-hardware
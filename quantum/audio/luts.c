@@ -16,8 +16,25 @@
 
 #include "luts.h"
 
-const float vibrato_lut[VIBRATO_LUT_LENGTH] = {
-    1.0022336811487, 1.0042529943610, 1.0058584256028, 1.0068905285205, 1.0072464122237, 1.0068905285205, 1.0058584256028, 1.0042529943610, 1.0022336811487, 1.0000000000000, 0.9977712970630, 0.9957650169978, 0.9941756956510, 0.9931566259436, 0.9928057204913, 0.9931566259436, 0.9941756956510, 0.9957650169978, 0.9977712970630, 1.0000000000000,
+// Frequency factors in Q16.16 fixed point, 1.0072464122237 at the peak
+const uint32_t vibrato_lut[VIBRATO_LUT_LENGTH] = {
+    65682, 65815, 65920, 65988, 66011, 65988, 65920, 65815, 65682, 65536, 65390, 65258, 65154, 65088, 65065, 65088, 65154, 65258, 65390, 65536,
+};
+
+// 2^(n/12) and 2^(-n/12) for n semitones, in Q16.16 fixed point
+const uint32_t semitone_up_lut[SEMITONE_LUT_LENGTH] = {
+    65536, 69433, 73562, 77936, 82570, 87480, 92682, 98193, 104032, 110218, 116772, 123715, 131072,
+};
+const uint32_t semitone_down_lut[SEMITONE_LUT_LENGTH] = {
+    65536, 61858, 58386, 55109, 52016, 49097, 46341, 43740, 41285, 38968, 36781, 34716, 32768,
+};
+
+// 2^(n/96) and 2^(-n/96) for n eighths of a semitone, in Q16.16 fixed point
+const uint32_t semitone_fraction_up_lut[SEMITONE_FRACTION_LUT_LENGTH] = {
+    65536, 66011, 66489, 66971, 67456, 67945, 68438, 68933,
+};
+const uint32_t semitone_fraction_down_lut[SEMITONE_FRACTION_LUT_LENGTH] = {
+    65536, 65065, 64596, 64132, 63670, 63212, 62757, 62306,
 };
 
 const uint16_t frequency_lut[FREQUENCY_LUT_LENGTH] = {
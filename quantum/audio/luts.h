@@ -21,7 +21,14 @@
 
 #define VIBRATO_LUT_LENGTH 20
 
+#define SEMITONE_LUT_LENGTH 13
+#define SEMITONE_FRACTION_LUT_LENGTH 8
+
 #define FREQUENCY_LUT_LENGTH 349
 
-extern const float    vibrato_lut[VIBRATO_LUT_LENGTH];
+extern const uint32_t vibrato_lut[VIBRATO_LUT_LENGTH];
+extern const uint32_t semitone_up_lut[SEMITONE_LUT_LENGTH];
+extern const uint32_t semitone_down_lut[SEMITONE_LUT_LENGTH];
+extern const uint32_t semitone_fraction_up_lut[SEMITONE_FRACTION_LUT_LENGTH];
+extern const uint32_t semitone_fraction_down_lut[SEMITONE_FRACTION_LUT_LENGTH];
 extern const uint16_t frequency_lut[FREQUENCY_LUT_LENGTH];
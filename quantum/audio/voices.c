@@ -17,6 +17,7 @@
 #include "voices.h"
 #include "audio.h"
 #include "timer.h"
+#include "util.h"
 #include <stdlib.h>
 #include <math.h>
 
@@ -47,31 +48,66 @@ void voice_deiterate(void) {
 }
 
 #ifdef AUDIO_VOICES
-float mod(float a, int b) {
-    float r = fmod(a, b);
-    return r < 0 ? r + b : r;
+// Scales a Q16.16 frequency by a Q16.16 factor
+static inline uint32_t voice_scale_frequency(uint32_t frequency, uint32_t factor) {
+    return ((uint64_t)frequency * factor) >> 16;
+}
+
+/* The vibrato is evaluated on every state update, which runs from the audio
+ * timer interrupt, so the pow() and division by the rate are done up front
+ * whenever the strength or rate change instead:
+ * vibrato_factors holds vibrato_lut raised to vibrato_strength in Q16.16, and
+ * vibrato_interval the time per table entry in 1/16 ms.
+ */
+static uint32_t vibrato_factors[VIBRATO_LUT_LENGTH];
+static uint16_t vibrato_interval      = 0;
+static bool     vibrato_factors_dirty = true;
+
+static void voice_update_vibrato(void) {
+    for (uint8_t i = 0; i < VIBRATO_LUT_LENGTH; i++) {
+        vibrato_factors[i] = powf(vibrato_lut[i] / 65536.0f, vibrato_strength) * 65536.0f;
+    }
+    // Clamped before the conversion, anything above the range of vibrato_interval would wrap around
+    float interval        = 1600 * vibrato_rate;
+    vibrato_interval      = interval < 1 ? 1 : interval > UINT16_MAX ? UINT16_MAX : (uint16_t)interval;
+    vibrato_factors_dirty = false;
 }
 
 // Effect: 'vibrate' a given target frequency slightly above/below its initial value
-float voice_add_vibrato(float average_freq) {
-    float vibrato_counter = mod(timer_read() / (100 * vibrato_rate), VIBRATO_LUT_LENGTH);
+uint32_t voice_add_vibrato(uint32_t average_freq) {
+    if (vibrato_factors_dirty) {
+        voice_update_vibrato();
+    }
+
+    uint8_t vibrato_counter = ((uint32_t)timer_read() * 16 / vibrato_interval) % VIBRATO_LUT_LENGTH;
 
-    return average_freq * pow(vibrato_lut[(int)vibrato_counter], vibrato_strength);
+    return voice_scale_frequency(average_freq, vibrato_factors[vibrato_counter]);
 }
 
 // Effect: 'slides' the 'frequency' from the starting-point, to the target frequency
-float voice_add_glissando(float from_freq, float to_freq) {
-    if (to_freq != 0 && from_freq < to_freq && from_freq < to_freq * pow(2, -440 / to_freq / 12 / 2)) {
-        return from_freq * pow(2, 440 / from_freq / 12 / 2);
-    } else if (to_freq != 0 && from_freq > to_freq && from_freq > to_freq * pow(2, 440 / to_freq / 12 / 2)) {
-        return from_freq * pow(2, -440 / from_freq / 12 / 2);
-    } else {
+uint32_t voice_add_glissando(uint32_t from_freq, uint32_t to_freq) {
+    if (to_freq == 0 || from_freq == 0 || from_freq == to_freq) {
         return to_freq;
     }
+
+    // Each step is 220Hz / from_freq semitones - half a semitone at 440Hz - in eighths of a semitone, at most an octave
+    uint32_t step = ((uint32_t)(220 * SEMITONE_FRACTION_LUT_LENGTH) << 16) / from_freq;
+    step          = MIN(MAX(step, 1), (SEMITONE_LUT_LENGTH - 1) * SEMITONE_FRACTION_LUT_LENGTH);
+
+    uint8_t semitones = step / SEMITONE_FRACTION_LUT_LENGTH;
+    uint8_t fraction  = step % SEMITONE_FRACTION_LUT_LENGTH;
+
+    if (from_freq < to_freq) {
+        uint32_t freq = voice_scale_frequency(voice_scale_frequency(from_freq, semitone_up_lut[semitones]), semitone_fraction_up_lut[fraction]);
+        return MIN(freq, to_freq);
+    } else {
+        uint32_t freq = voice_scale_frequency(voice_scale_frequency(from_freq, semitone_down_lut[semitones]), semitone_fraction_down_lut[fraction]);
+        return MAX(freq, to_freq);
+    }
 }
 #endif
 
-float voice_envelope(float frequency) {
+uint32_t voice_envelope(uint32_t frequency) {
     // envelope_index ranges from 0 to 0xFFFF, which is preserved at 880.0 Hz
 //    __attribute__((unused)) uint16_t compensated_index = (uint16_t)((float)envelope_index * (880.0 / frequency));
 #ifdef AUDIO_VOICES
@@ -128,10 +164,10 @@ float voice_envelope(float frequency) {
             // }
             // frequency = (rand() % (int)(frequency * 1.2 - frequency)) + (frequency * 0.8);
 
-            if (frequency < 80.0) {
-            } else if (frequency < 160.0) {
+            if (frequency < AUDIO_HZ_Q16(80)) {
+            } else if (frequency < AUDIO_HZ_Q16(160)) {
                 // Bass drum: 60 - 100 Hz
-                frequency = (rand() % (int)(40)) + 60;
+                frequency = AUDIO_HZ_Q16((rand() % (int)(40)) + 60);
                 switch (envelope_index) {
                     case 0 ... 10:
                         note_timbre = 50;
@@ -144,9 +180,9 @@ float voice_envelope(float frequency) {
                         break;
                 }
 
-            } else if (frequency < 320.0) {
+            } else if (frequency < AUDIO_HZ_Q16(320)) {
                 // Snare drum: 1 - 2 KHz
-                frequency = (rand() % (int)(1000)) + 1000;
+                frequency = AUDIO_HZ_Q16((rand() % (int)(1000)) + 1000);
                 switch (envelope_index) {
                     case 0 ... 5:
                         note_timbre = 50;
@@ -159,9 +195,9 @@ float voice_envelope(float frequency) {
                         break;
                 }
 
-            } else if (frequency < 640.0) {
+            } else if (frequency < AUDIO_HZ_Q16(640)) {
                 // Closed Hi-hat: 3 - 5 KHz
-                frequency = (rand() % (int)(2000)) + 3000;
+                frequency = AUDIO_HZ_Q16((rand() % (int)(2000)) + 3000);
                 switch (envelope_index) {
                     case 0 ... 15:
                         note_timbre = 50;
@@ -174,9 +210,9 @@ float voice_envelope(float frequency) {
                         break;
                 }
 
-            } else if (frequency < 1280.0) {
+            } else if (frequency < AUDIO_HZ_Q16(1280)) {
                 // Open Hi-hat: 3 - 5 KHz
-                frequency = (rand() % (int)(2000)) + 3000;
+                frequency = AUDIO_HZ_Q16((rand() % (int)(2000)) + 3000);
                 switch (envelope_index) {
                     case 0 ... 35:
                         note_timbre = 50;
@@ -204,7 +240,8 @@ float voice_envelope(float frequency) {
                     break;
 
                 case 20 ... 200:
-                    note_timbre = 12 - (uint8_t)(pow(((float)compensated_index - 20) / (200 - 20), 2) * 12.5);
+                    // 12.5 * ((index - 20) / 180)^2, in integer math
+                    note_timbre = 12 - (uint8_t)((uint32_t)(compensated_index - 20) * (compensated_index - 20) * 25 / (2 * (200 - 20) * (200 - 20)));
                     break;
 
                 default:
@@ -241,18 +278,18 @@ float voice_envelope(float frequency) {
             switch (compensated_index) {
                 default:
 #    define OCS_SPEED 10
-#    define OCS_AMP .25
+#    define OCS_AMP 25 // in percent
                     // sine wave is slow
                     // note_timbre = (sin((float)compensated_index/10000*OCS_SPEED) * OCS_AMP / 2) + .5;
                     // triangle wave is a bit faster
-                    note_timbre = (uint8_t)abs((compensated_index * OCS_SPEED % 3000) - 1500) * (OCS_AMP / 1500) + (1 - OCS_AMP) / 2;
+                    note_timbre = abs((compensated_index * OCS_SPEED % 3000) - 1500) * OCS_AMP / (1500 * 100) + (100 - OCS_AMP) / 200;
                     break;
             }
             break;
 
         case duty_octave_down:
             glissando   = true;
-            note_timbre = (uint8_t)(100 * (envelope_index % 2) * .125 + .375 * 2);
+            note_timbre = (envelope_index % 2) ? 13 : 0; // 12.5 + 0.75, truncated
             if ((envelope_index % 4) == 0) note_timbre = 50;
             if ((envelope_index % 8) == 0) note_timbre = 0;
             break;
@@ -266,7 +303,7 @@ float voice_envelope(float frequency) {
                     break;
                 default:
                     // TODO: merge/replace with voice_add_vibrato above
-                    frequency = frequency * vibrato_lut[(int)fmod((((float)compensated_index - (VOICE_VIBRATO_DELAY + 1)) / 1000 * VOICE_VIBRATO_SPEED), VIBRATO_LUT_LENGTH)];
+                    frequency = voice_scale_frequency(frequency, vibrato_lut[((compensated_index - (VOICE_VIBRATO_DELAY + 1)) * VOICE_VIBRATO_SPEED / 1000) % VIBRATO_LUT_LENGTH]);
                     break;
             }
             break;
@@ -333,23 +370,35 @@ float voice_envelope(float frequency) {
 
 // Vibrato functions
 
+#ifdef AUDIO_VOICES
+#    define VIBRATO_CHANGED() vibrato_factors_dirty = true
+#else
+#    define VIBRATO_CHANGED()
+#endif
+
 void voice_set_vibrato_rate(float rate) {
     vibrato_rate = rate;
+    VIBRATO_CHANGED();
 }
 void voice_increase_vibrato_rate(float change) {
     vibrato_rate *= change;
+    VIBRATO_CHANGED();
 }
 void voice_decrease_vibrato_rate(float change) {
     vibrato_rate /= change;
+    VIBRATO_CHANGED();
 }
 void voice_set_vibrato_strength(float strength) {
     vibrato_strength = strength;
+    VIBRATO_CHANGED();
 }
 void voice_increase_vibrato_strength(float change) {
     vibrato_strength *= change;
+    VIBRATO_CHANGED();
 }
 void voice_decrease_vibrato_strength(float change) {
     vibrato_strength /= change;
+    VIBRATO_CHANGED();
 }
 
 // Timbre functions
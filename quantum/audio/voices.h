@@ -21,7 +21,13 @@
 #include "wait.h"
 #include "luts.h"
 
-float voice_envelope(float frequency);
+// Applies the current voice to a frequency, both in Q16.16 fixed point Hz
+uint32_t voice_envelope(uint32_t frequency);
+
+#ifdef AUDIO_VOICES
+uint32_t voice_add_vibrato(uint32_t average_freq);
+uint32_t voice_add_glissando(uint32_t from_freq, uint32_t to_freq);
+#endif
 
 typedef enum {
     default_voice,
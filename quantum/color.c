@@ -18,6 +18,7 @@
 #include "led_tables.h"
 #include "progmem.h"
 #include "util.h"
+#include "usb_device_state.h"
 
 rgb_t hsv_to_rgb_impl(hsv_t hsv, bool use_cie) {
     rgb_t    rgb;
@@ -108,3 +109,36 @@ rgb_t hsv_to_rgb(hsv_t hsv) {
 rgb_t hsv_to_rgb_nocie(hsv_t hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
+
+uint16_t rgb_current_scale(const rgb_t *colors, uint16_t count, uint8_t red_ma, uint8_t green_ma, uint8_t blue_ma, uint16_t limit_ma) {
+    uint32_t red = 0, green = 0, blue = 0;
+
+    // Summing each channel first leaves only three multiplications per frame
+    for (uint16_t i = 0; i < count; i++) {
+        red += colors[i].r;
+        green += colors[i].g;
+        blue += colors[i].b;
+    }
+
+    // Both are in 1/255 mA
+    uint32_t current = red * red_ma + green * green_ma + blue * blue_ma;
+    uint32_t limit   = (uint32_t)limit_ma * 255;
+
+    if (current <= limit) {
+        return 256;
+    }
+    return (limit << 8) / current;
+}
+
+uint16_t rgb_current_budget(uint8_t usb_state, uint16_t limit_ma, uint16_t unconfigured_ma, uint16_t suspend_ma) {
+    switch (usb_state) {
+        // USB grants 100mA until the host configures the device...
+        case USB_DEVICE_STATE_INIT:
+            return MIN(limit_ma, unconfigured_ma);
+        // ...and only 2.5mA for the whole device while suspended
+        case USB_DEVICE_STATE_SUSPEND:
+            return MIN(limit_ma, suspend_ma);
+        default:
+            return limit_ma;
+    }
+}
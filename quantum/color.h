@@ -95,3 +95,14 @@ typedef hsv_t HSV;
 
 rgb_t hsv_to_rgb(hsv_t hsv);
 rgb_t hsv_to_rgb_nocie(hsv_t hsv);
+
+// Estimates the current drawn by a frame, given the current of a single channel at full brightness,
+// and returns the factor to dim it by to stay within limit_ma: 256 leaves the frame as is
+uint16_t rgb_current_scale(const rgb_t *colors, uint16_t count, uint8_t red_ma, uint8_t green_ma, uint8_t blue_ma, uint16_t limit_ma);
+
+// Picks the current budget for the LEDs allowed in the given USB configure state
+uint16_t rgb_current_budget(uint8_t usb_state, uint16_t limit_ma, uint16_t unconfigured_ma, uint16_t suspend_ma);
+
+static inline rgb_t rgb_scale(rgb_t rgb, uint16_t scale) {
+    return (rgb_t){(rgb.r * scale) >> 8, (rgb.g * scale) >> 8, (rgb.b * scale) >> 8};
+}
@@ -18,6 +18,10 @@ void via_eeprom_set_valid(bool valid);
 void eeconfig_init_via(void);
 #endif
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+void eeconfig_init_dynamic_macro(void);
+#endif
+
 _Static_assert((intptr_t)EECONFIG_HANDEDNESS == 14, "EEPROM handedness offset is incorrect");
 
 /** \brief eeconfig enable
@@ -82,6 +86,10 @@ void eeconfig_init_quantum(void) {
     eeconfig_init_via();
 #endif
 
+#if defined(DYNAMIC_MACRO_ENABLE) && defined(DYNAMIC_MACRO_EEPROM_STORAGE)
+    eeconfig_init_dynamic_macro();
+#endif
+
     eeconfig_init_kb();
 }
 
@@ -4,21 +4,53 @@
 #include <string.h>
 #include "action.h"
 #include "encoder.h"
-#include "wait.h"
+#include "timer.h"
 
 #ifndef ENCODER_MAP_KEY_DELAY
 #    define ENCODER_MAP_KEY_DELAY TAP_CODE_DELAY
 #endif
 
+// Changes of direction kept per encoder while its encoder map taps are still being emitted
+#ifndef ENCODER_MAP_PENDING_RUNS
+#    define ENCODER_MAP_PENDING_RUNS 4
+#endif
+
+// Batches further apart than this are considered to be separate movements when calculating velocity
+#ifndef ENCODER_VELOCITY_TIMEOUT
+#    define ENCODER_VELOCITY_TIMEOUT 250
+#endif
+
 __attribute__((weak)) bool should_process_encoder(void) {
     return is_keyboard_master();
 }
 
 static encoder_events_t encoder_events;
 static bool             signal_queue_drain = false;
+static uint32_t         encoder_last_batch[NUM_ENCODERS];
+
+#ifdef ENCODER_MAP_ENABLE
+// Detents still to be emitted as encoder map key taps, as runs in one direction in the order they were turned,
+// positive is clockwise
+static int16_t  encoder_map_runs[NUM_ENCODERS][ENCODER_MAP_PENDING_RUNS];
+static uint8_t  encoder_map_run_count[NUM_ENCODERS];
+static int8_t   encoder_map_held = -1;
+static bool     encoder_map_held_clockwise;
+static uint8_t  encoder_map_next;
+static uint16_t encoder_map_last_action;
+#endif // ENCODER_MAP_ENABLE
 
 void encoder_init(void) {
     memset(&encoder_events, 0, sizeof(encoder_events));
+    // Start every encoder a whole timeout in the past so its first batch counts as a new movement
+    for (uint8_t i = 0; i < NUM_ENCODERS; i++) {
+        encoder_last_batch[i] = timer_read32() - ENCODER_VELOCITY_TIMEOUT;
+    }
+#ifdef ENCODER_MAP_ENABLE
+    memset(encoder_map_runs, 0, sizeof(encoder_map_runs));
+    memset(encoder_map_run_count, 0, sizeof(encoder_map_run_count));
+    encoder_map_held = -1;
+    encoder_map_next = 0;
+#endif // ENCODER_MAP_ENABLE
     encoder_driver_init();
 }
 
@@ -27,34 +59,133 @@ static void encoder_queue_drain(void) {
     encoder_events.dequeued = encoder_events.enqueued;
 }
 
+static uint16_t encoder_batch_velocity(uint8_t index, int16_t steps) {
+    uint32_t elapsed          = timer_elapsed32(encoder_last_batch[index]);
+    encoder_last_batch[index] = timer_read32();
+
+    // The first batch of a movement has no reference point, so it's treated as having taken the whole timeout period.
+    // Batches within the same millisecond are treated as 1ms apart.
+    if (elapsed == 0) {
+        elapsed = 1;
+    } else if (elapsed > ENCODER_VELOCITY_TIMEOUT) {
+        elapsed = ENCODER_VELOCITY_TIMEOUT;
+    }
+
+    uint32_t velocity = (uint32_t)(steps < 0 ? -steps : steps) * 1000 / elapsed;
+    return velocity > UINT16_MAX ? UINT16_MAX : velocity;
+}
+
+#ifdef ENCODER_MAP_ENABLE
+static void encoder_map_queue_batch(uint8_t index, int16_t steps) {
+    int16_t *runs  = encoder_map_runs[index];
+    uint8_t  count = encoder_map_run_count[index];
+
+    if (count > 0 && (runs[count - 1] > 0) == (steps > 0)) {
+        runs[count - 1] += steps;
+    } else if (count < ENCODER_MAP_PENDING_RUNS) {
+        runs[count]                  = steps;
+        encoder_map_run_count[index] = count + 1;
+    } else {
+        // Out of runs, so the reversal is netted against the last one: some taps are lost, but not the final position
+        runs[count - 1] += steps;
+        if (runs[count - 1] == 0) {
+            encoder_map_run_count[index] = count - 1;
+        } else if ((runs[count - 1] > 0) == (runs[count - 2] > 0)) {
+            runs[count - 2] += runs[count - 1];
+            encoder_map_run_count[index] = count - 1;
+        }
+    }
+}
+#endif // ENCODER_MAP_ENABLE
+
+static void encoder_handle_batch(uint8_t index, int16_t steps) {
+    if (!encoder_update_batch_kb(index, steps, encoder_batch_velocity(index, steps))) {
+        return;
+    }
+
+#ifdef ENCODER_MAP_ENABLE
+    encoder_map_queue_batch(index, steps);
+#else  // ENCODER_MAP_ENABLE
+    for (; steps > 0; steps--) {
+        encoder_update_kb(index, true);
+    }
+    for (; steps < 0; steps++) {
+        encoder_update_kb(index, false);
+    }
+#endif // ENCODER_MAP_ENABLE
+}
+
 static bool encoder_handle_queue(void) {
     bool    changed = false;
     uint8_t index;
     bool    clockwise;
-    while (encoder_dequeue_event(&index, &clockwise)) {
-#ifdef ENCODER_MAP_ENABLE
+    int16_t steps       = 0;
+    uint8_t batch_index = 0;
 
-        // The delays below cater for Windows and its wonderful requirements.
-        action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
-#    if ENCODER_MAP_KEY_DELAY > 0
-        wait_ms(ENCODER_MAP_KEY_DELAY);
-#    endif // ENCODER_MAP_KEY_DELAY > 0
+    // Consecutive events from the same encoder in the same direction are combined into a single batch, preserving the
+    // order between encoders and direction changes
+    while (encoder_dequeue_event(&index, &clockwise)) {
+        if (steps != 0 && (index != batch_index || (steps > 0) != clockwise)) {
+            encoder_handle_batch(batch_index, steps);
+            steps = 0;
+        }
+        batch_index = index;
+        steps += clockwise ? 1 : -1;
+        changed = true;
+    }
+    if (steps != 0) {
+        encoder_handle_batch(batch_index, steps);
+    }
+    return changed;
+}
 
-        action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, false) : MAKE_ENCODER_CCW_EVENT(index, false));
+#ifdef ENCODER_MAP_ENABLE
+// Emits the pending encoder map taps one key event at a time, spacing them out by ENCODER_MAP_KEY_DELAY without
+// blocking the rest of the keyboard.
+static bool encoder_map_task(void) {
+    bool changed = false;
+    while (true) {
+        // The delays cater for Windows and its wonderful requirements.
 #    if ENCODER_MAP_KEY_DELAY > 0
-        wait_ms(ENCODER_MAP_KEY_DELAY);
+        if (timer_elapsed(encoder_map_last_action) < ENCODER_MAP_KEY_DELAY) {
+            break;
+        }
 #    endif // ENCODER_MAP_KEY_DELAY > 0
 
-#else // ENCODER_MAP_ENABLE
-
-        encoder_update_kb(index, clockwise);
-
-#endif // ENCODER_MAP_ENABLE
+        if (encoder_map_held >= 0) {
+            action_exec(encoder_map_held_clockwise ? MAKE_ENCODER_CW_EVENT(encoder_map_held, false) : MAKE_ENCODER_CCW_EVENT(encoder_map_held, false));
+            encoder_map_held = -1;
+        } else {
+            // Round-robin between encoders so a long spin of one doesn't starve the others
+            uint8_t index = encoder_map_next;
+            uint8_t i     = 0;
+            while (i < NUM_ENCODERS && encoder_map_run_count[index] == 0) {
+                index = (index + 1) % NUM_ENCODERS;
+                i++;
+            }
+            if (i == NUM_ENCODERS) {
+                break;
+            }
+            encoder_map_next = (index + 1) % NUM_ENCODERS;
+
+            int16_t *runs      = encoder_map_runs[index];
+            bool     clockwise = runs[0] > 0;
+            runs[0] += clockwise ? -1 : 1;
+            if (runs[0] == 0) {
+                encoder_map_run_count[index]--;
+                memmove(runs, runs + 1, encoder_map_run_count[index] * sizeof(runs[0]));
+            }
+            action_exec(clockwise ? MAKE_ENCODER_CW_EVENT(index, true) : MAKE_ENCODER_CCW_EVENT(index, true));
+            encoder_map_held           = index;
+            encoder_map_held_clockwise = clockwise;
+        }
 
-        changed = true;
+        encoder_map_last_action = timer_read();
+        changed                 = true;
     }
     return changed;
 }
+#endif // ENCODER_MAP_ENABLE
 
 bool encoder_task(void) {
     bool changed = false;
@@ -79,6 +210,10 @@ bool encoder_task(void) {
         changed |= encoder_handle_queue();
     }
 
+#ifdef ENCODER_MAP_ENABLE
+    changed |= encoder_map_task();
+#endif // ENCODER_MAP_ENABLE
+
     return changed;
 }
 
@@ -148,6 +283,14 @@ void encoder_signal_queue_drain(void) {
     signal_queue_drain = true;
 }
 
+__attribute__((weak)) bool encoder_update_batch_user(uint8_t index, int16_t steps, uint16_t velocity) {
+    return true;
+}
+
+__attribute__((weak)) bool encoder_update_batch_kb(uint8_t index, int16_t steps, uint16_t velocity) {
+    return encoder_update_batch_user(index, steps, velocity);
+}
+
 __attribute__((weak)) bool encoder_update_user(uint8_t index, bool clockwise) {
     return true;
 }
@@ -49,6 +49,11 @@ bool encoder_dequeue_event(uint8_t *index, bool *clockwise);
 bool encoder_update_kb(uint8_t index, bool clockwise);
 bool encoder_update_user(uint8_t index, bool clockwise);
 
+// Called once per scan with all detents turned since the last scan (positive is clockwise) and the speed in detents per
+// second. Returning true passes the detents on to encoder_update_kb/encoder_update_user or the encoder map.
+bool encoder_update_batch_kb(uint8_t index, int16_t steps, uint16_t velocity);
+bool encoder_update_batch_user(uint8_t index, int16_t steps, uint16_t velocity);
+
 #    ifdef SPLIT_KEYBOARD
 
 #        if defined(ENCODER_A_PINS_RIGHT)
@@ -120,4 +125,9 @@ extern const uint16_t encoder_map[][NUM_ENCODERS][NUM_DIRECTIONS];
 void encoder_driver_init(void);
 void encoder_driver_task(void);
 
+#    ifdef ENCODER_DRIVER_TIMER
+// Total number of counts seen by the hardware timer since initialisation, for high resolution consumers
+int32_t encoder_timer_get_position(uint8_t index);
+#    endif // ENCODER_DRIVER_TIMER
+
 #endif // ENCODER_ENABLE
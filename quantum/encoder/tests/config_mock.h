@@ -12,6 +12,9 @@
 #define ENCODER_B_PINS \
     { 1 }
 
+// Room for several detents and reversals within a single scan
+#define MAX_QUEUED_ENCODER_EVENTS 16
+
 #ifdef __cplusplus
 extern "C" {
 #endif
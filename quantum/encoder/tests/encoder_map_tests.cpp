@@ -0,0 +1,85 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <vector>
+
+extern "C" {
+#include "action.h"
+#include "encoder.h"
+#include "encoder/tests/mock.h"
+
+void advance_time(uint32_t ms);
+}
+
+struct tap {
+    uint8_t index;
+    bool    clockwise;
+};
+
+std::vector<tap> taps;
+
+void action_exec(keyevent_t event) {
+    // Only the presses, every one is followed by its release on the next run of the task
+    if (event.pressed) {
+        taps.push_back({event.key.col, event.type == ENCODER_CW_EVENT});
+    }
+}
+
+static void queue_detents(uint8_t index, int steps) {
+    for (; steps > 0; steps--) {
+        encoder_queue_event(index, true);
+    }
+    for (; steps < 0; steps++) {
+        encoder_queue_event(index, false);
+    }
+}
+
+// Runs the encoder task until all pending taps have been emitted, well past any key delay
+static void drain_taps(void) {
+    for (int i = 0; i < 100; i++) {
+        advance_time(20);
+        encoder_task();
+    }
+}
+
+static std::vector<bool> tap_directions(void) {
+    std::vector<bool> directions;
+    for (auto &t : taps) {
+        directions.push_back(t.clockwise);
+    }
+    return directions;
+}
+
+class EncoderMapTest : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        taps.clear();
+        encoder_init();
+    }
+};
+
+TEST_F(EncoderMapTest, TapsKeepTheOrderOfReversals) {
+    // +5, -2, +3 within one scan, emitted in that order rather than as +8 then -2
+    queue_detents(0, 5);
+    queue_detents(0, -2);
+    queue_detents(0, 3);
+    drain_taps();
+
+    std::vector<bool> expected = {true, true, true, true, true, false, false, true, true, true};
+    EXPECT_EQ(tap_directions(), expected);
+}
+
+TEST_F(EncoderMapTest, ReversalsWhileTapping) {
+    // Reversals arriving while earlier taps are still being emitted are queued behind them
+    queue_detents(0, 3);
+    encoder_task();
+    queue_detents(0, -1);
+    encoder_task();
+    queue_detents(0, 2);
+    drain_taps();
+
+    std::vector<bool> expected = {true, true, true, false, true, true};
+    EXPECT_EQ(tap_directions(), expected);
+}
@@ -23,6 +23,8 @@
 extern "C" {
 #include "encoder.h"
 #include "encoder/tests/mock.h"
+
+void advance_time(uint32_t ms);
 }
 
 struct update {
@@ -39,6 +41,18 @@ bool encoder_update_kb(uint8_t index, bool clockwise) {
     return true;
 }
 
+uint8_t  batch_calls       = 0;
+int16_t  batch_steps       = 0;
+uint16_t batch_velocity    = 0;
+bool     batch_passthrough = true;
+
+bool encoder_update_batch_user(uint8_t index, int16_t steps, uint16_t velocity) {
+    batch_calls++;
+    batch_steps    = steps;
+    batch_velocity = velocity;
+    return batch_passthrough;
+}
+
 bool setAndRead(pin_t pin, bool val) {
     setPin(pin, val);
     return encoder_task();
@@ -142,3 +156,93 @@ TEST_F(EncoderTest, TestHalfway) {
     EXPECT_EQ(updates[0].index, 0);
     EXPECT_EQ(updates[0].clockwise, true);
 }
+
+TEST_F(EncoderTest, TestBatchedDetents) {
+    updates_array_idx = 0;
+    batch_calls       = 0;
+    encoder_init();
+    // three detents queued within the same scan are delivered as a single batch
+    encoder_queue_event(0, true);
+    encoder_queue_event(0, true);
+    encoder_queue_event(0, true);
+    encoder_task();
+
+    EXPECT_EQ(batch_calls, 1);
+    EXPECT_EQ(batch_steps, 3);
+    // and are then passed on one at a time
+    EXPECT_EQ(updates_array_idx, 3);
+    EXPECT_EQ(updates[2].index, 0);
+    EXPECT_EQ(updates[2].clockwise, true);
+}
+
+TEST_F(EncoderTest, TestBatchedOppositeDirections) {
+    updates_array_idx = 0;
+    batch_calls       = 0;
+    encoder_init();
+    encoder_queue_event(0, true);
+    encoder_queue_event(0, false);
+    encoder_queue_event(0, false);
+    encoder_task();
+
+    // a change of direction starts a new batch, so no detents are lost
+    EXPECT_EQ(batch_calls, 2);
+    EXPECT_EQ(batch_steps, -2);
+    EXPECT_EQ(updates_array_idx, 3);
+    EXPECT_EQ(updates[0].clockwise, true);
+    EXPECT_EQ(updates[1].clockwise, false);
+    EXPECT_EQ(updates[2].clockwise, false);
+}
+
+TEST_F(EncoderTest, TestBatchesKeepTheirOrder) {
+    updates_array_idx = 0;
+    batch_calls       = 0;
+    encoder_init();
+    // +5, -2, +3 within one scan are three batches, delivered in the order they were turned
+    for (int i = 0; i < 5; i++) encoder_queue_event(0, true);
+    for (int i = 0; i < 2; i++) encoder_queue_event(0, false);
+    for (int i = 0; i < 3; i++) encoder_queue_event(0, true);
+    encoder_task();
+
+    EXPECT_EQ(batch_calls, 3);
+    EXPECT_EQ(batch_steps, 3);
+    EXPECT_EQ(updates_array_idx, 10);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(updates[i].clockwise, i < 5 || i >= 7) << "detent " << i;
+    }
+}
+
+TEST_F(EncoderTest, TestBatchVelocity) {
+    batch_calls = 0;
+    encoder_init();
+    // the first batch of a movement is treated as having taken the whole timeout period
+    encoder_queue_event(0, true);
+    encoder_queue_event(0, true);
+    encoder_task();
+    EXPECT_EQ(batch_velocity, 2 * 1000 / 250);
+
+    advance_time(10);
+    encoder_queue_event(0, true);
+    encoder_task();
+    EXPECT_EQ(batch_velocity, 1000 / 10);
+
+    advance_time(1000);
+    encoder_queue_event(0, true);
+    encoder_task();
+    EXPECT_EQ(batch_velocity, 1000 / 250);
+    EXPECT_EQ(batch_calls, 3);
+}
+
+TEST_F(EncoderTest, TestBatchConsumed) {
+    updates_array_idx = 0;
+    batch_calls       = 0;
+    batch_passthrough = false;
+    encoder_init();
+    encoder_queue_event(0, true);
+    encoder_queue_event(0, true);
+    encoder_task();
+    batch_passthrough = true;
+
+    EXPECT_EQ(batch_calls, 1);
+    EXPECT_EQ(batch_steps, 2);
+    EXPECT_EQ(updates_array_idx, 0);
+}
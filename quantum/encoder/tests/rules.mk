@@ -2,17 +2,30 @@ encoder_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE
 encoder_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
 
 encoder_SRC := \
+	platforms/timer.c \
 	platforms/test/timer.c \
 	drivers/encoder/encoder_quadrature.c \
 	$(QUANTUM_PATH)/encoder/tests/mock.c \
 	$(QUANTUM_PATH)/encoder/tests/encoder_tests.cpp \
 	$(QUANTUM_PATH)/encoder.c
 
+encoder_map_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SINGLE -DENCODER_MAP_ENABLE
+encoder_map_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock.h
+
+encoder_map_SRC := \
+	platforms/timer.c \
+	platforms/test/timer.c \
+	drivers/encoder/encoder_quadrature.c \
+	$(QUANTUM_PATH)/encoder/tests/mock.c \
+	$(QUANTUM_PATH)/encoder/tests/encoder_map_tests.cpp \
+	$(QUANTUM_PATH)/encoder.c
+
 encoder_split_left_eq_right_DEFS := -DENCODER_TESTS -DENCODER_ENABLE -DENCODER_MOCK_SPLIT
 encoder_split_left_eq_right_INC := $(QUANTUM_PATH)/split_common
 encoder_split_left_eq_right_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_eq_right.h
 
 encoder_split_left_eq_right_SRC := \
+	platforms/timer.c \
 	platforms/test/timer.c \
 	drivers/encoder/encoder_quadrature.c \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
@@ -24,6 +37,7 @@ encoder_split_left_gt_right_INC := $(QUANTUM_PATH)/split_common
 encoder_split_left_gt_right_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_gt_right.h
 
 encoder_split_left_gt_right_SRC := \
+	platforms/timer.c \
 	platforms/test/timer.c \
 	drivers/encoder/encoder_quadrature.c \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
@@ -35,6 +49,7 @@ encoder_split_left_lt_right_INC := $(QUANTUM_PATH)/split_common
 encoder_split_left_lt_right_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_left_lt_right.h
 
 encoder_split_left_lt_right_SRC := \
+	platforms/timer.c \
 	platforms/test/timer.c \
 	drivers/encoder/encoder_quadrature.c \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
@@ -46,6 +61,7 @@ encoder_split_no_left_INC := $(QUANTUM_PATH)/split_common
 encoder_split_no_left_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_no_left.h
 
 encoder_split_no_left_SRC := \
+	platforms/timer.c \
 	platforms/test/timer.c \
 	drivers/encoder/encoder_quadrature.c \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
@@ -57,6 +73,7 @@ encoder_split_no_right_INC := $(QUANTUM_PATH)/split_common
 encoder_split_no_right_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_no_right.h
 
 encoder_split_no_right_SRC := \
+	platforms/timer.c \
 	platforms/test/timer.c \
 	drivers/encoder/encoder_quadrature.c \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
@@ -68,6 +85,7 @@ encoder_split_role_INC := $(QUANTUM_PATH)/split_common
 encoder_split_role_CONFIG := $(QUANTUM_PATH)/encoder/tests/config_mock_split_role.h
 
 encoder_split_role_SRC := \
+	platforms/timer.c \
 	platforms/test/timer.c \
 	drivers/encoder/encoder_quadrature.c \
 	$(QUANTUM_PATH)/encoder/tests/mock_split.c \
@@ -1,5 +1,6 @@
 TEST_LIST += \
 	encoder \
+	encoder_map \
 	encoder_split_left_eq_right \
 	encoder_split_left_gt_right \
 	encoder_split_left_lt_right \
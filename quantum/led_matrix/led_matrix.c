@@ -37,8 +37,46 @@ const led_point_t k_led_matrix_center = {112, 32};
 const led_point_t k_led_matrix_center = LED_MATRIX_CENTER;
 #endif
 
-// Generic effect runners
-#include "led_matrix_runners.inc"
+// timer, key hit tracker and position tables shared with rgb matrix
+#define LIGHTING_LED_COUNT LED_MATRIX_LED_COUNT
+#define LIGHTING_CENTER k_led_matrix_center
+#define LIGHTING_TIMER g_led_timer
+#define LIGHTING_MAP_ROW_COLUMN_TO_LED led_matrix_map_row_column_to_led
+#ifdef LED_MATRIX_POLAR_TABLE
+#    define LIGHTING_POLAR_TABLE g_led_polar_table
+#endif
+#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
+#    define LIGHTING_KEYREACTIVE_ENABLED
+#    if defined(LED_MATRIX_KEYRELEASES)
+#        define LIGHTING_KEYRELEASES
+#    elif defined(LED_MATRIX_KEYPRESSES)
+#        define LIGHTING_KEYPRESSES
+#    endif
+#    ifdef LED_MATRIX_HIT_DISTANCE_TABLE
+#        define LIGHTING_HIT_DISTANCE g_led_hit_distance
+#    endif
+#endif
+#define LIGHTING_CONFIG led_matrix_eeconfig
+#define LIGHTING_TASK_STATES led_task_states
+#define LIGHTING_FLUSH_LIMIT LED_MATRIX_LED_FLUSH_LIMIT
+#define LIGHTING_INDICATORS led_matrix_indicators
+#define LIGHTING_INDICATORS_ADVANCED led_matrix_indicators_advanced
+#define LIGHTING_TASK_EFFECT led_task_effect
+#define LIGHTING_TASK_RENDER led_task_render
+#define LIGHTING_TASK_FLUSH led_task_flush
+#define LIGHTING_TASK_SYNC led_task_sync
+#include "lighting_matrix_core.inc"
+
+// Generic effect runners shared with rgb matrix
+#define LIGHTING_PIXEL uint8_t
+#define LIGHTING_PIXEL_BASE led_matrix_eeconfig.val
+#define LIGHTING_PIXEL_VALUE(pixel) (pixel)
+#define LIGHTING_SET_PIXEL led_matrix_set_value
+#define LIGHTING_USE_LIMITS LED_MATRIX_USE_LIMITS
+#define LIGHTING_TEST_LED_FLAGS LED_MATRIX_TEST_LED_FLAGS
+#define LIGHTING_CHECK_FINISHED_LEDS led_matrix_check_finished_leds
+#define LIGHTING_EFFECT_SPEED(speed) (speed)
+#include "lighting_matrix_runners.inc"
 
 // ------------------------------------------
 // -----Begin led effect includes macros-----
@@ -67,19 +105,15 @@ uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef LED_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // LED_MATRIX_KEYREACTIVE_ENABLED
+#ifdef LED_MATRIX_POLAR_TABLE
+led_polar_t g_led_polar_table[LED_MATRIX_LED_COUNT];
+#endif // LED_MATRIX_POLAR_TABLE
+#if defined(LED_MATRIX_KEYREACTIVE_ENABLED) && defined(LED_MATRIX_HIT_DISTANCE_TABLE)
+uint8_t g_led_hit_distance[LED_HITS_TO_REMEMBER][LED_MATRIX_LED_COUNT];
+#endif
 
 // internals
-static bool            suspend_state     = false;
-static uint8_t         led_last_enable   = UINT8_MAX;
-static uint8_t         led_last_effect   = UINT8_MAX;
-static effect_params_t led_effect_params = {0, LED_FLAG_ALL, false};
-static led_task_states led_task_state    = SYNCING;
-
-// double buffers
-static uint32_t led_timer_buffer;
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
+static bool suspend_state = false;
 
 // split led matrix
 #if defined(LED_MATRIX_SPLIT)
@@ -173,36 +207,7 @@ void led_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
     if (!is_keyboard_master()) return;
 #endif
 
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t led[LED_HITS_TO_REMEMBER];
-    uint8_t led_count = 0;
-
-#    if defined(LED_MATRIX_KEYRELEASES)
-    if (!pressed)
-#    elif defined(LED_MATRIX_KEYPRESSES)
-    if (pressed)
-#    endif // defined(LED_MATRIX_KEYRELEASES)
-    {
-        led_count = led_matrix_map_row_column_to_led(row, col, led);
-    }
-
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
+    lighting_key_event(row, col, pressed);
 
 #if defined(LED_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_LED_MATRIX_TYPING_HEATMAP)
     if (led_matrix_eeconfig.mode == LED_MATRIX_TYPING_HEATMAP) {
@@ -220,50 +225,14 @@ static bool led_matrix_none(effect_params_t *params) {
     return false;
 }
 
-static void led_task_timers(void) {
-#if defined(LED_MATRIX_KEYREACTIVE_ENABLED)
-    uint32_t deltaTime = sync_timer_elapsed32(led_timer_buffer);
-#endif // defined(LED_MATRIX_KEYREACTIVE_ENABLED)
-    led_timer_buffer = sync_timer_read32();
-
-    // Update double buffer last hit timers
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
-}
-
 static void led_task_sync(void) {
     eeconfig_flush_led_matrix(false);
-    // next task
-    if (sync_timer_elapsed32(g_led_timer) >= LED_MATRIX_LED_FLUSH_LIMIT) led_task_state = STARTING;
-}
-
-static void led_task_start(void) {
-    // reset iter
-    led_effect_params.iter = 0;
-
-    // update double buffers
-    g_led_timer = led_timer_buffer;
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    led_task_state = RENDERING;
 }
 
-static void led_task_render(uint8_t effect) {
-    bool rendering         = false;
-    led_effect_params.init = (effect != led_last_effect) || (led_matrix_eeconfig.enable != led_last_enable);
-    if (led_effect_params.flags != led_matrix_eeconfig.flags) {
-        led_effect_params.flags = led_matrix_eeconfig.flags;
+static bool led_task_render(uint8_t effect, effect_params_t *params) {
+    bool rendering = false;
+    if (params->flags != led_matrix_eeconfig.flags) {
+        params->flags = led_matrix_eeconfig.flags;
         led_matrix_set_value_all(0);
     }
 
@@ -271,22 +240,22 @@ static void led_task_render(uint8_t effect) {
     // and/or request PWM buffer updates.
     switch (effect) {
         case LED_MATRIX_NONE:
-            rendering = led_matrix_none(&led_effect_params);
+            rendering = led_matrix_none(params);
             break;
 
 // ---------------------------------------------
 // -----Begin led effect switch case macros-----
-#define LED_MATRIX_EFFECT(name, ...)          \
-    case LED_MATRIX_##name:                   \
-        rendering = name(&led_effect_params); \
+#define LED_MATRIX_EFFECT(name, ...) \
+    case LED_MATRIX_##name:          \
+        rendering = name(params);    \
         break;
 #include "led_matrix_effects.inc"
 #undef LED_MATRIX_EFFECT
 
 #if defined(LED_MATRIX_CUSTOM_KB) || defined(LED_MATRIX_CUSTOM_USER)
-#    define LED_MATRIX_EFFECT(name, ...)          \
-        case LED_MATRIX_CUSTOM_##name:            \
-            rendering = name(&led_effect_params); \
+#    define LED_MATRIX_EFFECT(name, ...) \
+        case LED_MATRIX_CUSTOM_##name:   \
+            rendering = name(params);    \
             break;
 #    ifdef LED_MATRIX_CUSTOM_KB
 #        include "led_matrix_kb.inc"
@@ -300,33 +269,14 @@ static void led_task_render(uint8_t effect) {
             // ---------------------------------------------
     }
 
-    led_effect_params.iter++;
-
-    // next task
-    if (!rendering) {
-        led_task_state = FLUSHING;
-        if (!led_effect_params.init && effect == LED_MATRIX_NONE) {
-            // We only need to flush once if we are LED_MATRIX_NONE
-            led_task_state = SYNCING;
-        }
-    }
+    return rendering;
 }
 
-static void led_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    led_last_effect = effect;
-    led_last_enable = led_matrix_eeconfig.enable;
-
-    // update pwm buffers
+static void led_task_flush(void) {
     led_matrix_update_pwm_buffers();
-
-    // next task
-    led_task_state = SYNCING;
 }
 
-void led_matrix_task(void) {
-    led_task_timers();
-
+static uint8_t led_task_effect(void) {
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -335,28 +285,11 @@ void led_matrix_task(void) {
 #endif // LED_MATRIX_TIMEOUT > 0
                              false;
 
-    uint8_t effect = suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
+    return suspend_backlight || !led_matrix_eeconfig.enable ? 0 : led_matrix_eeconfig.mode;
+}
 
-    switch (led_task_state) {
-        case STARTING:
-            led_task_start();
-            break;
-        case RENDERING:
-            led_task_render(effect);
-            if (effect) {
-                if (led_task_state == FLUSHING) {
-                    led_matrix_indicators(); // ensure we only draw basic indicators once rendering is finished
-                }
-                led_matrix_indicators_advanced(&led_effect_params);
-            }
-            break;
-        case FLUSHING:
-            led_task_flush(effect);
-            break;
-        case SYNCING:
-            led_task_sync();
-            break;
-    }
+void led_matrix_task(void) {
+    lighting_task_step();
 }
 
 void led_matrix_indicators(void) {
@@ -373,9 +306,9 @@ __attribute__((weak)) bool led_matrix_indicators_user(void) {
 
 void led_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
-     * Could move the invocations to led_task_render, but then it's missing a few checks
+     * Could move the invocations to lighting_task_render, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
-     * led_task_render, right before the iter++ line.
+     * lighting_task_render, right before the iter++ line.
      */
     LED_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
     led_matrix_indicators_advanced_kb(min, max);
@@ -420,17 +353,7 @@ struct led_matrix_limits_t led_matrix_get_limits(uint8_t iter) {
 void led_matrix_init(void) {
     led_matrix_driver.init();
 
-#ifdef LED_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
-
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
-#endif // LED_MATRIX_KEYREACTIVE_ENABLED
+    lighting_init();
 
     eeconfig_init_led_matrix();
     if (!led_matrix_eeconfig.mode) {
@@ -443,8 +366,8 @@ void led_matrix_init(void) {
 void led_matrix_set_suspend_state(bool state) {
 #ifdef LED_MATRIX_SLEEP
     if (state && !suspend_state && is_keyboard_master()) { // only run if turning off, and only once
-        led_task_render(0);                                // turn off all LEDs when suspending
-        led_task_flush(0);                                 // and actually flash led state to LEDs
+        lighting_task_render(0);                           // turn off all LEDs when suspending
+        lighting_task_flush(0);                            // and actually flash led state to LEDs
     }
     suspend_state = state;
 #endif
@@ -456,7 +379,7 @@ bool led_matrix_get_suspend_state(void) {
 
 void led_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
     led_matrix_eeconfig.enable ^= 1;
-    led_task_state = STARTING;
+    lighting_task_restart();
     eeconfig_flag_led_matrix(write_to_eeprom);
     dprintf("led matrix toggle [%s]: led_matrix_eeconfig.enable = %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.enable);
 }
@@ -473,7 +396,7 @@ void led_matrix_enable(void) {
 }
 
 void led_matrix_enable_noeeprom(void) {
-    if (!led_matrix_eeconfig.enable) led_task_state = STARTING;
+    if (!led_matrix_eeconfig.enable) lighting_task_restart();
     led_matrix_eeconfig.enable = 1;
 }
 
@@ -483,7 +406,7 @@ void led_matrix_disable(void) {
 }
 
 void led_matrix_disable_noeeprom(void) {
-    if (led_matrix_eeconfig.enable) led_task_state = STARTING;
+    if (led_matrix_eeconfig.enable) lighting_task_restart();
     led_matrix_eeconfig.enable = 0;
 }
 
@@ -502,7 +425,7 @@ void led_matrix_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     } else {
         led_matrix_eeconfig.mode = mode;
     }
-    led_task_state = STARTING;
+    lighting_task_restart();
     eeconfig_flag_led_matrix(write_to_eeprom);
     dprintf("led matrix mode [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", led_matrix_eeconfig.mode);
 }
@@ -200,3 +200,9 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef LED_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_led_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef LED_MATRIX_POLAR_TABLE
+extern led_polar_t g_led_polar_table[LED_MATRIX_LED_COUNT];
+#endif
+#if defined(LED_MATRIX_KEYREACTIVE_ENABLED) && defined(LED_MATRIX_HIT_DISTANCE_TABLE)
+extern uint8_t g_led_hit_distance[LED_HITS_TO_REMEMBER][LED_MATRIX_LED_COUNT];
+#endif
@@ -0,0 +1,21 @@
+#pragma once
+
+typedef LIGHTING_PIXEL (*dx_dy_dist_f)(LIGHTING_PIXEL pixel, int16_t dx, int16_t dy, uint8_t dist, uint8_t time);
+
+bool effect_runner_dx_dy_dist(effect_params_t* params, dx_dy_dist_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(LIGHTING_TIMER, LIGHTING_CONFIG.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        int16_t dx = g_led_config.point[i].x - LIGHTING_CENTER.x;
+        int16_t dy = g_led_config.point[i].y - LIGHTING_CENTER.y;
+#ifdef LIGHTING_POLAR_TABLE
+        uint8_t dist = LIGHTING_POLAR_TABLE[i].dist;
+#else
+        uint8_t dist = sqrt16(dx * dx + dy * dy);
+#endif
+        LIGHTING_SET_PIXEL(i, effect_func(LIGHTING_PIXEL_BASE, dx, dy, dist, time));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
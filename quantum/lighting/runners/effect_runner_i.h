@@ -0,0 +1,14 @@
+#pragma once
+
+typedef LIGHTING_PIXEL (*i_f)(LIGHTING_PIXEL pixel, uint8_t i, uint8_t time);
+
+bool effect_runner_i(effect_params_t* params, i_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(LIGHTING_TIMER, LIGHTING_EFFECT_SPEED(LIGHTING_CONFIG.speed / 4));
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        LIGHTING_SET_PIXEL(i, effect_func(LIGHTING_PIXEL_BASE, i, time));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
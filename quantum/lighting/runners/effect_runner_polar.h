@@ -0,0 +1,23 @@
+#pragma once
+
+typedef LIGHTING_PIXEL (*polar_f)(LIGHTING_PIXEL pixel, uint8_t angle, uint8_t dist, uint8_t time);
+
+bool effect_runner_polar(effect_params_t* params, polar_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(LIGHTING_TIMER, LIGHTING_CONFIG.speed / 2);
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+#ifdef LIGHTING_POLAR_TABLE
+        uint8_t angle = LIGHTING_POLAR_TABLE[i].angle;
+        uint8_t dist  = LIGHTING_POLAR_TABLE[i].dist;
+#else
+        int16_t dx    = g_led_config.point[i].x - LIGHTING_CENTER.x;
+        int16_t dy    = g_led_config.point[i].y - LIGHTING_CENTER.y;
+        uint8_t angle = atan2_8(dy, dx);
+        uint8_t dist  = sqrt16(dx * dx + dy * dy);
+#endif
+        LIGHTING_SET_PIXEL(i, effect_func(LIGHTING_PIXEL_BASE, angle, dist, time));
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
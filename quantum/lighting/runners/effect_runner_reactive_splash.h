@@ -0,0 +1,35 @@
+#pragma once
+
+#ifdef LIGHTING_KEYREACTIVE_ENABLED
+
+typedef LIGHTING_PIXEL (*reactive_splash_f)(LIGHTING_PIXEL pixel, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    LIGHTING_USE_LIMITS(led_min, led_max);
+#    ifdef LIGHTING_HIT_DISTANCE
+    lighting_update_hit_distances(led_min, led_max);
+#    endif
+
+    uint8_t count = g_last_hit_tracker.count;
+    for (uint8_t i = led_min; i < led_max; i++) {
+        LIGHTING_TEST_LED_FLAGS();
+        LIGHTING_PIXEL pixel        = LIGHTING_PIXEL_BASE;
+        LIGHTING_PIXEL_VALUE(pixel) = 0;
+        for (uint8_t j = start; j < count; j++) {
+            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+#    ifdef LIGHTING_HIT_DISTANCE
+            uint8_t  dist = LIGHTING_HIT_DISTANCE[g_last_hit_tracker.slot[j]][i];
+#    else
+            uint8_t  dist = sqrt16(dx * dx + dy * dy);
+#    endif
+            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], LIGHTING_EFFECT_SPEED(LIGHTING_CONFIG.speed));
+            pixel         = effect_func(pixel, dx, dy, dist, tick);
+        }
+        LIGHTING_PIXEL_VALUE(pixel) = scale8(LIGHTING_PIXEL_VALUE(pixel), LIGHTING_PIXEL_VALUE(LIGHTING_PIXEL_BASE));
+        LIGHTING_SET_PIXEL(i, pixel);
+    }
+    return LIGHTING_CHECK_FINISHED_LEDS(led_max);
+}
+
+#endif // LIGHTING_KEYREACTIVE_ENABLED
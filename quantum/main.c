@@ -55,6 +55,11 @@ int main(void) {
         raw_hid_task();
 #endif
 
+#ifdef RAW_HID_STREAM_ENABLE
+        void raw_hid_stream_task(void);
+        raw_hid_stream_task();
+#endif
+
 #ifdef CONSOLE_ENABLE
         void console_task(void);
         console_task();
@@ -16,12 +16,14 @@
  */
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 #include "keycode.h"
 #include "host.h"
 #include "timer.h"
 #include "print.h"
 #include "debug.h"
+#include "util.h"
 #include "mousekey.h"
 
 static inline int8_t times_inv_sqrt2(int8_t x) {
@@ -37,6 +39,21 @@ static inline int8_t times_inv_sqrt2(int8_t x) {
     return n < 0 ? (n - d / 2) / d : (n + d / 2) / d;
 }
 
+static void mousekey_scale_wheel(report_mouse_t *report) {
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    // Wheel keys step whole detents, so scale them once the host counts in high resolution units
+    int32_t v = (int32_t)report->v * host_mouse_wheel_multiplier(false);
+    int32_t h = (int32_t)report->h * host_mouse_wheel_multiplier(true);
+#    ifdef WHEEL_EXTENDED_REPORT
+    report->v = v < -32767 ? -32767 : (v > 32767 ? 32767 : v);
+    report->h = h < -32767 ? -32767 : (h > 32767 ? 32767 : h);
+#    else
+    report->v = v < -127 ? -127 : (v > 127 ? 127 : v);
+    report->h = h < -127 ? -127 : (h > 127 ? 127 : h);
+#    endif
+#endif
+}
+
 static report_mouse_t mouse_report = {0};
 static void           mousekey_debug(void);
 static uint8_t        mousekey_accel        = 0;
@@ -53,7 +70,225 @@ static int8_t  mousekey_y_inertia = 0; // ...
 static uint16_t mouse_timer = 0;
 #endif
 
-#ifndef MK_3_SPEED
+#if defined(MOUSEKEY_FRAME_INTEGRATION)
+
+/*
+ * Frame integrated movement
+ *
+ *  speed = I + A * T/50 + A * (T/50)^2 * 1/2 | maximum B
+ *
+ * The speed follows the same curve as the kinetic mode, but instead of sending
+ * a fixed step per interval, it is integrated once per USB frame (1ms) into a
+ * position kept in 1/1000 pixel (or wheel detent) units, so that a speed in
+ * units per second is exactly the step per frame. Whole units are taken
+ * out when a report is sent, at most once every mk_interval milliseconds, and
+ * the fraction carries over into the next one. With a pointing device, the
+ * motion is merged into its report instead, see mousekey_take_motion().
+ */
+
+/* milliseconds between the initial key press and the start of acceleration (0-2550) */
+uint8_t mk_delay = MOUSEKEY_DELAY / 10;
+/* minimum milliseconds between reports (0-255) */
+uint8_t mk_interval = MOUSEKEY_INTERVAL;
+/* unused, kept for the command console */
+uint8_t mk_max_speed         = MOUSEKEY_MAX_SPEED;
+uint8_t mk_time_to_max       = MOUSEKEY_TIME_TO_MAX;
+uint8_t mk_wheel_max_speed   = MOUSEKEY_WHEEL_MAX_SPEED;
+uint8_t mk_wheel_time_to_max = MOUSEKEY_WHEEL_TIME_TO_MAX;
+
+enum {
+    MK_HELD_UP          = (1 << 0),
+    MK_HELD_DOWN        = (1 << 1),
+    MK_HELD_LEFT        = (1 << 2),
+    MK_HELD_RIGHT       = (1 << 3),
+    MK_HELD_WHEEL_UP    = (1 << 4),
+    MK_HELD_WHEEL_DOWN  = (1 << 5),
+    MK_HELD_WHEEL_LEFT  = (1 << 6),
+    MK_HELD_WHEEL_RIGHT = (1 << 7),
+    MK_HELD_CURSOR      = 0x0F,
+    MK_HELD_WHEEL       = 0xF0,
+};
+
+static uint8_t  mousekey_held        = 0; // direction keys held, see MK_HELD_*
+static uint16_t mousekey_move_start  = 0; // time the first cursor key was pressed
+static uint16_t mousekey_wheel_start = 0; // time the first wheel key was pressed
+static uint16_t mousekey_last_frame  = 0;
+static uint8_t  mousekey_report_age  = UINT8_MAX; // frames since the last report
+static int32_t  mousekey_remainder_x = 0;         // position not yet reported, in 1/1000 units
+static int32_t  mousekey_remainder_y = 0;
+static int32_t  mousekey_remainder_v = 0;
+static int32_t  mousekey_remainder_h = 0;
+
+static uint8_t held_bit(uint8_t code) {
+    return IS_MOUSEKEY_MOVE(code) ? 1 << (code - QK_MOUSE_CURSOR_UP) : 1 << (4 + code - QK_MOUSE_WHEEL_UP);
+}
+
+static int8_t held_direction(uint8_t negative, uint8_t positive) {
+    return ((mousekey_held & positive) ? 1 : 0) - ((mousekey_held & negative) ? 1 : 0);
+}
+
+static uint16_t kinetic_speed(uint16_t start, uint16_t initial, uint16_t acceleration, uint16_t base, uint16_t decelerated, uint16_t accelerated) {
+    if (mousekey_accel & (1 << 0)) {
+        return decelerated;
+    } else if (mousekey_accel & (1 << 2)) {
+        return accelerated;
+    }
+
+    uint16_t elapsed = timer_elapsed(start);
+    if (elapsed < mk_delay * 10) {
+        return 0; // only the step of the initial press until the delay has passed
+    }
+    // Capped at 12.75s so the square stays within 32 bits, every sane curve has reached its base speed by then
+    uint32_t t     = MIN((elapsed - mk_delay * 10) / 50, 255);
+    uint32_t speed = initial + acceleration * t + (acceleration * t * t) / 2;
+    return speed > base ? base : speed;
+}
+
+static int16_t take_whole(int32_t *remainder, int16_t max) {
+    int32_t whole = *remainder / 1000;
+    *remainder -= whole * 1000;
+    // Like the other modes, movement beyond what a report can carry is dropped rather than piling up
+    return whole > max ? max : (whole < -max ? -max : whole);
+}
+
+#    ifndef POINTING_DEVICE_ENABLE
+static bool has_whole_units(void) {
+    return abs(mousekey_remainder_x) >= 1000 || abs(mousekey_remainder_y) >= 1000 || abs(mousekey_remainder_v) >= 1000 || abs(mousekey_remainder_h) >= 1000;
+}
+#    endif
+
+static void take_motion(report_mouse_t *report) {
+    report->x = take_whole(&mousekey_remainder_x, MOUSEKEY_MOVE_MAX);
+    report->y = take_whole(&mousekey_remainder_y, MOUSEKEY_MOVE_MAX);
+    report->v = take_whole(&mousekey_remainder_v, MOUSEKEY_WHEEL_MAX);
+    report->h = take_whole(&mousekey_remainder_h, MOUSEKEY_WHEEL_MAX);
+}
+
+static void frame_send(void) {
+#    ifndef POINTING_DEVICE_ENABLE
+    take_motion(&mouse_report);
+#    endif
+    mousekey_debug();
+    report_mouse_t report = mouse_report;
+    mousekey_scale_wheel(&report);
+    host_mouse_send(&report);
+
+    mousekey_report_age = 0;
+    mouse_report.x      = 0;
+    mouse_report.y      = 0;
+    mouse_report.v      = 0;
+    mouse_report.h      = 0;
+}
+
+void mousekey_task(void) {
+    uint16_t now        = timer_read();
+    uint16_t frames     = MIN(TIMER_DIFF_16(now, mousekey_last_frame), MOUSEKEY_FRAME_MAX_STEP);
+    mousekey_last_frame = now;
+    mousekey_report_age = MIN(mousekey_report_age + frames, UINT8_MAX);
+
+    if (frames && (mousekey_held & MK_HELD_CURSOR)) {
+        int8_t   x     = held_direction(MK_HELD_LEFT, MK_HELD_RIGHT);
+        int8_t   y     = held_direction(MK_HELD_UP, MK_HELD_DOWN);
+        uint16_t speed = kinetic_speed(mousekey_move_start, MOUSEKEY_INITIAL_SPEED, MOUSEKEY_MOVE_DELTA, MOUSEKEY_BASE_SPEED, MOUSEKEY_DECELERATED_SPEED, MOUSEKEY_ACCELERATED_SPEED);
+        int32_t  step  = (int32_t)speed * frames;
+        if (x && y) {
+            step = step * 181 / 256; // diagonal move [1/sqrt(2)]
+        }
+        mousekey_remainder_x += x * step;
+        mousekey_remainder_y += y * step;
+    }
+    if (frames && (mousekey_held & MK_HELD_WHEEL)) {
+        int8_t   v     = held_direction(MK_HELD_WHEEL_DOWN, MK_HELD_WHEEL_UP);
+        int8_t   h     = held_direction(MK_HELD_WHEEL_LEFT, MK_HELD_WHEEL_RIGHT);
+        uint16_t speed = kinetic_speed(mousekey_wheel_start, MOUSEKEY_WHEEL_INITIAL_MOVEMENTS, 1, MOUSEKEY_WHEEL_BASE_MOVEMENTS, MOUSEKEY_WHEEL_DECELERATED_MOVEMENTS, MOUSEKEY_WHEEL_ACCELERATED_MOVEMENTS);
+        int32_t  step  = (int32_t)speed * frames;
+        if (v && h) {
+            step = step * 181 / 256;
+        }
+        mousekey_remainder_v += v * step;
+        mousekey_remainder_h += h * step;
+    }
+
+#    ifndef POINTING_DEVICE_ENABLE
+    if (has_whole_units() && mousekey_report_age >= mk_interval) {
+        frame_send();
+    }
+#    endif
+}
+
+report_mouse_t mousekey_take_motion(void) {
+    report_mouse_t report = {0};
+    take_motion(&report);
+    mousekey_scale_wheel(&report);
+    return report;
+}
+
+void mousekey_on(uint8_t code) {
+    if (IS_MOUSEKEY_MOVE(code) || IS_MOUSEKEY_WHEEL(code)) {
+        uint8_t bit = held_bit(code);
+        if (!mousekey_held) {
+            mousekey_last_frame = timer_read(); // integration starts with the press
+        }
+        if ((bit & MK_HELD_CURSOR) && !(mousekey_held & MK_HELD_CURSOR)) {
+            mousekey_move_start = timer_read();
+        } else if ((bit & MK_HELD_WHEEL) && !(mousekey_held & MK_HELD_WHEEL)) {
+            mousekey_wheel_start = timer_read();
+        }
+
+        // A press on an idle axis moves by one unit straight away, so that taps stay precise
+        if (code == QK_MOUSE_CURSOR_UP && !(mousekey_held & (MK_HELD_UP | MK_HELD_DOWN)))
+            mousekey_remainder_y -= 1000;
+        else if (code == QK_MOUSE_CURSOR_DOWN && !(mousekey_held & (MK_HELD_UP | MK_HELD_DOWN)))
+            mousekey_remainder_y += 1000;
+        else if (code == QK_MOUSE_CURSOR_LEFT && !(mousekey_held & (MK_HELD_LEFT | MK_HELD_RIGHT)))
+            mousekey_remainder_x -= 1000;
+        else if (code == QK_MOUSE_CURSOR_RIGHT && !(mousekey_held & (MK_HELD_LEFT | MK_HELD_RIGHT)))
+            mousekey_remainder_x += 1000;
+        else if (code == QK_MOUSE_WHEEL_UP && !(mousekey_held & (MK_HELD_WHEEL_UP | MK_HELD_WHEEL_DOWN)))
+            mousekey_remainder_v += 1000;
+        else if (code == QK_MOUSE_WHEEL_DOWN && !(mousekey_held & (MK_HELD_WHEEL_UP | MK_HELD_WHEEL_DOWN)))
+            mousekey_remainder_v -= 1000;
+        else if (code == QK_MOUSE_WHEEL_LEFT && !(mousekey_held & (MK_HELD_WHEEL_LEFT | MK_HELD_WHEEL_RIGHT)))
+            mousekey_remainder_h -= 1000;
+        else if (code == QK_MOUSE_WHEEL_RIGHT && !(mousekey_held & (MK_HELD_WHEEL_LEFT | MK_HELD_WHEEL_RIGHT)))
+            mousekey_remainder_h += 1000;
+
+        mousekey_held |= bit;
+    } else if (IS_MOUSEKEY_BUTTON(code))
+        mouse_report.buttons |= 1 << (code - QK_MOUSE_BUTTON_1);
+    else if (code == QK_MOUSE_ACCELERATION_0)
+        mousekey_accel |= (1 << 0);
+    else if (code == QK_MOUSE_ACCELERATION_1)
+        mousekey_accel |= (1 << 1);
+    else if (code == QK_MOUSE_ACCELERATION_2)
+        mousekey_accel |= (1 << 2);
+}
+
+void mousekey_off(uint8_t code) {
+    if (IS_MOUSEKEY_MOVE(code) || IS_MOUSEKEY_WHEEL(code)) {
+        mousekey_held &= ~held_bit(code);
+
+        // Once an axis comes to rest the fraction is dropped, so the next press starts from a clean step
+        if (!(mousekey_held & (MK_HELD_UP | MK_HELD_DOWN))) mousekey_remainder_y -= mousekey_remainder_y % 1000;
+        if (!(mousekey_held & (MK_HELD_LEFT | MK_HELD_RIGHT))) mousekey_remainder_x -= mousekey_remainder_x % 1000;
+        if (!(mousekey_held & (MK_HELD_WHEEL_UP | MK_HELD_WHEEL_DOWN))) mousekey_remainder_v -= mousekey_remainder_v % 1000;
+        if (!(mousekey_held & (MK_HELD_WHEEL_LEFT | MK_HELD_WHEEL_RIGHT))) mousekey_remainder_h -= mousekey_remainder_h % 1000;
+    } else if (IS_MOUSEKEY_BUTTON(code))
+        mouse_report.buttons &= ~(1 << (code - QK_MOUSE_BUTTON_1));
+    else if (code == QK_MOUSE_ACCELERATION_0)
+        mousekey_accel &= ~(1 << 0);
+    else if (code == QK_MOUSE_ACCELERATION_1)
+        mousekey_accel &= ~(1 << 1);
+    else if (code == QK_MOUSE_ACCELERATION_2)
+        mousekey_accel &= ~(1 << 2);
+}
+
+void mousekey_send(void) {
+    // Carries along whatever motion is due, the next frame waits for the interval again
+    frame_send();
+}
+
+#elif !defined(MK_3_SPEED)
 
 static uint16_t last_timer_c = 0;
 static uint16_t last_timer_w = 0;
@@ -630,13 +865,17 @@ void mousekey_off(uint8_t code) {
 
 #endif /* #ifndef MK_3_SPEED */
 
+#ifndef MOUSEKEY_FRAME_INTEGRATION
 void mousekey_send(void) {
     mousekey_debug();
     uint16_t time = timer_read();
     if (mouse_report.x || mouse_report.y) last_timer_c = time;
     if (mouse_report.v || mouse_report.h) last_timer_w = time;
-    host_mouse_send(&mouse_report);
+    report_mouse_t report = mouse_report;
+    mousekey_scale_wheel(&report);
+    host_mouse_send(&report);
 }
+#endif
 
 void mousekey_clear(void) {
     mouse_report          = (report_mouse_t){};
@@ -650,6 +889,13 @@ void mousekey_clear(void) {
     mousekey_x_dir     = 0;
     mousekey_y_dir     = 0;
 #endif
+#ifdef MOUSEKEY_FRAME_INTEGRATION
+    mousekey_held        = 0;
+    mousekey_remainder_x = 0;
+    mousekey_remainder_y = 0;
+    mousekey_remainder_v = 0;
+    mousekey_remainder_h = 0;
+#endif
 }
 
 static void mousekey_debug(void) {
@@ -20,6 +20,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdint.h>
 #include "host.h"
 
+#if defined(MOUSEKEY_FRAME_INTEGRATION) && (defined(MK_3_SPEED) || defined(MK_KINETIC_SPEED) || defined(MK_COMBINED) || defined(MOUSEKEY_INERTIA))
+#    error MOUSEKEY_FRAME_INTEGRATION cannot be combined with another mouse keys mode
+#endif
+
 #ifndef MK_3_SPEED
 
 /* max value on report descriptor */
@@ -36,7 +40,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    endif
 
 #    ifndef MOUSEKEY_MOVE_DELTA
-#        if defined(MK_KINETIC_SPEED)
+#        if defined(MK_KINETIC_SPEED) || defined(MOUSEKEY_FRAME_INTEGRATION)
 #            define MOUSEKEY_MOVE_DELTA 16
 #        elif defined(MOUSEKEY_INERTIA)
 #            define MOUSEKEY_MOVE_DELTA 1
@@ -45,7 +49,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        endif
 #    endif
 #    ifndef MOUSEKEY_DELAY
-#        if defined(MK_KINETIC_SPEED)
+#        if defined(MK_KINETIC_SPEED) || defined(MOUSEKEY_FRAME_INTEGRATION)
 #            define MOUSEKEY_DELAY 5
 #        elif defined(MOUSEKEY_INERTIA)
 #            define MOUSEKEY_DELAY 150 // allow single-pixel movements before repeat activates
@@ -54,7 +58,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #        endif
 #    endif
 #    ifndef MOUSEKEY_INTERVAL
-#        if defined(MK_KINETIC_SPEED)
+#        if defined(MOUSEKEY_FRAME_INTEGRATION) && defined(USB_POLLING_INTERVAL_MS)
+#            define MOUSEKEY_INTERVAL USB_POLLING_INTERVAL_MS // at most one report per polling interval
+#        elif defined(MOUSEKEY_FRAME_INTEGRATION)
+#            define MOUSEKEY_INTERVAL 1
+#        elif defined(MK_KINETIC_SPEED)
 #            define MOUSEKEY_INTERVAL 10
 #        elif defined(MOUSEKEY_INERTIA)
 #            define MOUSEKEY_INTERVAL 16 // 60 fps
@@ -119,6 +127,11 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    ifndef MOUSEKEY_WHEEL_DECELERATED_MOVEMENTS
 #        define MOUSEKEY_WHEEL_DECELERATED_MOVEMENTS 8
 #    endif
+#    ifndef MOUSEKEY_FRAME_MAX_STEP
+#        define MOUSEKEY_FRAME_MAX_STEP 64 // frames integrated at once after a stall, at most
+#    elif MOUSEKEY_FRAME_MAX_STEP > 64
+#        error MOUSEKEY_FRAME_MAX_STEP needs to be 64 or smaller
+#    endif
 
 #else /* #ifndef MK_3_SPEED */
 
@@ -202,6 +215,9 @@ void           mousekey_clear(void);
 void           mousekey_send(void);
 report_mouse_t mousekey_get_report(void);
 bool           should_mousekey_report_send(report_mouse_t *mouse_report);
+#ifdef MOUSEKEY_FRAME_INTEGRATION
+report_mouse_t mousekey_take_motion(void);
+#endif
 
 #ifdef __cplusplus
 }
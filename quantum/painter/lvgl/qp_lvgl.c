@@ -5,6 +5,7 @@
 #include "qp_lvgl.h"
 #include "timer.h"
 #include "deferred_exec.h"
+#include "keyboard.h"
 #include "lvgl.h"
 
 typedef struct lvgl_state_t {
@@ -16,19 +17,40 @@ typedef struct lvgl_state_t {
 static deferred_executor_t lvgl_executors[2] = {0}; // For lv_tick_inc and lv_task_handler
 static lvgl_state_t        lvgl_states[2]    = {0}; // For lv_tick_inc and lv_task_handler
 
+static uint16_t task_period        = QP_LVGL_TASK_PERIOD;
+static uint16_t task_period_typing = QP_LVGL_TASK_PERIOD_TYPING;
+
 painter_device_t selected_display = NULL;
 void *           color_buffer     = NULL;
+#ifdef QP_LVGL_DOUBLE_BUFFER
+void *color_buffer_2 = NULL;
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter LVGL Integration Internal: qp_lvgl_flush
 
+#ifdef QP_LVGL_DOUBLE_BUFFER
+static void qp_lvgl_flush_complete(painter_device_t device, void *cb_arg) {
+    // May be invoked from interrupt context; LVGL only clears its flushing flag here
+    lv_disp_flush_ready((lv_disp_drv_t *)cb_arg);
+}
+#endif // QP_LVGL_DOUBLE_BUFFER
+
 void qp_lvgl_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p) {
     if (selected_display) {
         uint32_t number_pixels = (area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
         qp_viewport(selected_display, area->x1, area->y1, area->x2, area->y2);
+#ifdef QP_LVGL_DOUBLE_BUFFER
+        // LVGL renders into the other buffer while this one is sent to the panel, the buffer is handed back once the
+        // transfer completes
+        if (!qp_pixdata_async(selected_display, (void *)color_p, number_pixels, qp_lvgl_flush_complete, disp)) {
+            lv_disp_flush_ready(disp);
+        }
+#else
         qp_pixdata(selected_display, (void *)color_p, number_pixels);
         qp_flush(selected_display);
         lv_disp_flush_ready(disp);
+#endif // QP_LVGL_DOUBLE_BUFFER
     }
 }
 
@@ -43,6 +65,7 @@ static uint32_t tick_task_callback(uint32_t trigger_time, void *cb_arg) {
         } break;
         case 1:
             lv_task_handler();
+            state->delay_ms = last_matrix_activity_elapsed() < QP_LVGL_TYPING_TIMEOUT ? task_period_typing : task_period;
             break;
 
         default:
@@ -81,8 +104,8 @@ bool qp_lvgl_attach(painter_device_t device) {
 
     lvgl_state_t *lv_task_handler_state = &lvgl_states[1];
     lv_task_handler_state->fnc_id       = 1;
-    lv_task_handler_state->delay_ms     = QP_LVGL_TASK_PERIOD;
-    lv_task_handler_state->defer_token  = defer_exec_advanced(lvgl_executors, 2, QP_LVGL_TASK_PERIOD, tick_task_callback, lv_task_handler_state);
+    lv_task_handler_state->delay_ms     = task_period;
+    lv_task_handler_state->defer_token  = defer_exec_advanced(lvgl_executors, 2, task_period, tick_task_callback, lv_task_handler_state);
 
     if (lv_task_handler_state->defer_token == INVALID_DEFERRED_TOKEN) {
         qp_dprintf("qp_lvgl_attach: fail (could not set up qp_lvgl executor)\n");
@@ -95,8 +118,8 @@ bool qp_lvgl_attach(painter_device_t device) {
 
     // Set up lvgl display buffer
     static lv_disp_draw_buf_t draw_buf;
-    // Allocate a buffer for 1/10 screen size
-    const size_t count_required   = driver->panel_width * driver->panel_height / 10;
+    // Allocate a buffer for 1/QP_LVGL_BUFFER_DIVISOR screen size
+    const size_t count_required   = driver->panel_width * driver->panel_height / QP_LVGL_BUFFER_DIVISOR;
     void *       new_color_buffer = realloc(color_buffer, sizeof(lv_color_t) * count_required);
     if (!new_color_buffer) {
         qp_dprintf("qp_lvgl_attach: fail (could not set up memory buffer)\n");
@@ -105,8 +128,22 @@ bool qp_lvgl_attach(painter_device_t device) {
     }
     color_buffer = new_color_buffer;
     memset(color_buffer, 0, sizeof(lv_color_t) * count_required);
+#ifdef QP_LVGL_DOUBLE_BUFFER
+    // Second buffer of the same size, so that LVGL can render while the first is being transferred
+    new_color_buffer = realloc(color_buffer_2, sizeof(lv_color_t) * count_required);
+    if (!new_color_buffer) {
+        qp_dprintf("qp_lvgl_attach: fail (could not set up second memory buffer)\n");
+        qp_lvgl_detach();
+        return false;
+    }
+    color_buffer_2 = new_color_buffer;
+    memset(color_buffer_2, 0, sizeof(lv_color_t) * count_required);
+    // Initialize the display buffer.
+    lv_disp_draw_buf_init(&draw_buf, color_buffer, color_buffer_2, count_required);
+#else
     // Initialize the display buffer.
     lv_disp_draw_buf_init(&draw_buf, color_buffer, NULL, count_required);
+#endif // QP_LVGL_DOUBLE_BUFFER
 
     selected_display = device;
 
@@ -132,6 +169,14 @@ void qp_lvgl_detach(void) {
     for (int i = 0; i < 2; ++i) {
         cancel_deferred_exec_advanced(lvgl_executors, 2, lvgl_states[i].defer_token);
     }
+#ifdef QP_LVGL_DOUBLE_BUFFER
+    // Don't free a buffer that's still being transferred
+    qp_pixdata_async_wait();
+    if (color_buffer_2) {
+        free(color_buffer_2);
+        color_buffer_2 = NULL;
+    }
+#endif // QP_LVGL_DOUBLE_BUFFER
     if (color_buffer) {
         free(color_buffer);
         color_buffer = NULL;
@@ -139,10 +184,24 @@ void qp_lvgl_detach(void) {
     selected_display = NULL;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter LVGL Integration API: qp_lvgl_set_task_period
+
+void qp_lvgl_set_task_period(uint16_t period_ms, uint16_t typing_period_ms) {
+    task_period        = period_ms;
+    task_period_typing = typing_period_ms;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter LVGL Integration Internal: qp_lvgl_internal_tick
 
 void qp_lvgl_internal_tick(void) {
+#ifdef QP_LVGL_DOUBLE_BUFFER
+    // Release the bus once the previous transfer has completed, so other devices can use it
+    if (!qp_pixdata_async_busy()) {
+        qp_pixdata_async_wait();
+    }
+#endif // QP_LVGL_DOUBLE_BUFFER
     static uint32_t last_lvgl_exec = 0;
     deferred_exec_advanced_task(lvgl_executors, 2, &last_lvgl_exec);
 }
@@ -11,6 +11,21 @@
 #    define QP_LVGL_TASK_PERIOD 5
 #endif
 
+// Period used for lv_task_handler while keys are being pressed, allowing rendering to back off during typing
+#ifndef QP_LVGL_TASK_PERIOD_TYPING
+#    define QP_LVGL_TASK_PERIOD_TYPING QP_LVGL_TASK_PERIOD
+#endif
+
+// How long after the last matrix activity the typing period remains in effect
+#ifndef QP_LVGL_TYPING_TIMEOUT
+#    define QP_LVGL_TYPING_TIMEOUT 250
+#endif
+
+// Each draw buffer holds 1/QP_LVGL_BUFFER_DIVISOR of the screen
+#ifndef QP_LVGL_BUFFER_DIVISOR
+#    define QP_LVGL_BUFFER_DIVISOR 10
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter - LVGL External API
 
@@ -27,3 +42,11 @@ bool qp_lvgl_attach(painter_device_t device);
  * Disconnects LVGL from any attached display
  */
 void qp_lvgl_detach(void);
+
+/**
+ * Changes how often lv_task_handler is invoked.
+ *
+ * @param period_ms[in] the period in milliseconds while the keyboard is idle
+ * @param typing_period_ms[in] the period in milliseconds while the keyboard is being typed on
+ */
+void qp_lvgl_set_task_period(uint16_t period_ms, uint16_t typing_period_ms);
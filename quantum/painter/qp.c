@@ -318,3 +318,47 @@ bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native
     qp_comms_stop(device);
     return ret;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_pixdata_async
+
+bool qp_pixdata_async(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count, qp_pixdata_async_callback_t callback, void *cb_arg) {
+    qp_dprintf("qp_pixdata_async: entry\n");
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_pixdata_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    if (!qp_comms_start(device)) {
+        qp_dprintf("qp_pixdata_async: fail (could not start comms)\n");
+        return false;
+    }
+
+    // Drivers without asynchronous support stream the data immediately
+    if (!driver->driver_vtable->pixdata_async) {
+        bool ret = driver->driver_vtable->pixdata(device, pixel_data, native_pixel_count);
+        qp_dprintf("qp_pixdata_async: %s (synchronous)\n", ret ? "ok" : "fail");
+        qp_comms_stop(device);
+        if (ret && callback) {
+            callback(device, cb_arg);
+        }
+        return ret;
+    }
+
+    // On success, comms are stopped once the transfer has completed -- see qp_comms_async_finish()
+    bool ret = driver->driver_vtable->pixdata_async(device, pixel_data, native_pixel_count, callback, cb_arg);
+    qp_dprintf("qp_pixdata_async: %s\n", ret ? "ok" : "fail");
+    if (!ret) {
+        qp_comms_stop(device);
+    }
+    return ret;
+}
+
+bool qp_pixdata_async_wait(void) {
+    return qp_comms_async_finish();
+}
+
+bool qp_pixdata_async_busy(void) {
+    return qp_comms_async_busy();
+}
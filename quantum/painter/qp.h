@@ -72,6 +72,14 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_ASYNC_TIMEOUT
+/**
+ * @def This controls the maximum amount of time (in milliseconds) that Quantum Painter waits for an asynchronous pixel
+ *      data transfer to complete, before giving up and aborting it.
+ */
+#    define QUANTUM_PAINTER_ASYNC_TIMEOUT 1000
+#endif // QUANTUM_PAINTER_ASYNC_TIMEOUT
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -341,6 +349,51 @@ bool qp_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t
  */
 bool qp_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
 
+/**
+ * Callback invoked once an asynchronous pixel data transfer has completed.
+ *
+ * @note This may be invoked from interrupt context, and must not perform any Quantum Painter operations.
+ */
+typedef void (*qp_pixdata_async_callback_t)(painter_device_t device, void *cb_arg);
+
+/**
+ * Starts streaming raw pixel data (in the native panel format) to the area previously set by \ref qp_viewport, returning
+ * before the transfer has completed where the display and comms driver support it.
+ *
+ * The pixel data must remain untouched until the callback has been invoked. The bus remains held by Quantum Painter
+ * until the next Quantum Painter operation on any device, or until \ref qp_pixdata_async_wait is called. Displays which
+ * cannot transfer asynchronously fall back to \ref qp_pixdata, invoking the callback before returning.
+ *
+ * @note This is for advanced uses only, and should not be required for normal Quantum Painter functionality.
+ *
+ * @param device[in] the handle of the device to control
+ * @param pixel_data[in] pointer to buffer data
+ * @param native_pixel_count[in] the number of pixels to transmit
+ * @param callback[in] the function to invoke once the transfer has completed
+ * @param cb_arg[in] the argument to pass to the callback
+ * @return true if the transfer was started
+ * @return false if the transfer could not be started, in which case the callback is not invoked
+ */
+bool qp_pixdata_async(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count, qp_pixdata_async_callback_t callback, void *cb_arg);
+
+/**
+ * Waits for any outstanding asynchronous pixel data transfer to complete, and releases the bus.
+ *
+ * If the transfer doesn't complete within \ref QUANTUM_PAINTER_ASYNC_TIMEOUT, it is aborted and the callback is invoked
+ * anyway, so that the pixel data buffer is handed back.
+ *
+ * @return true if the transfer completed
+ * @return false if the transfer timed out and was aborted
+ */
+bool qp_pixdata_async_wait(void);
+
+/**
+ * Checks whether an asynchronous pixel data transfer is still in progress.
+ *
+ * @return true if a transfer started by \ref qp_pixdata_async has not yet completed
+ */
+bool qp_pixdata_async_busy(void);
+
 /**
  * Loads an image into memory.
  *
@@ -422,10 +475,51 @@ deferred_token qp_animate(painter_device_t device, uint16_t x, uint16_t y, paint
  */
 deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
 
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+
+/**
+ * Draws an animation to the display, decoding each frame into a keyframe surface first.
+ *
+ * Delta frames are applied to the surface, and only the region of the surface that actually changed is transmitted to
+ * the display. The surface must be at least as large as the image, and must match the display's native pixel format.
+ *
+ * @param device[in] the handle of the device to control
+ * @param surface[in] the handle of the surface used to hold the decoded frame
+ * @param x[in] the x-position where the image should be drawn onto the device
+ * @param y[in] the y-position where the image should be drawn onto the device
+ * @param image[in] the handle of the image to draw
+ * @return the \ref deferred_token to use with \ref qp_stop_animation in order to stop animating
+ * @return INVALID_DEFERRED_TOKEN if animating the image failed
+ */
+deferred_token qp_animate_via_surface(painter_device_t device, painter_device_t surface, uint16_t x, uint16_t y, painter_image_handle_t image);
+
+/**
+ * Draws an animation to the display via a keyframe surface, recoloring monochrome images to the desired
+ * foreground/background.
+ *
+ * @param device[in] the handle of the device to control
+ * @param surface[in] the handle of the surface used to hold the decoded frame
+ * @param x[in] the x-position where the image should be drawn onto the device
+ * @param y[in] the y-position where the image should be drawn onto the device
+ * @param image[in] the handle of the image to draw
+ * @param hue_fg[in] the foreground hue to use, with 0-360 mapped to 0-255
+ * @param sat_fg[in] the foreground saturation to use, with 0-100% mapped to 0-255
+ * @param val_fg[in] the foreground value to use, with 0-100% mapped to 0-255
+ * @param hue_bg[in] the background hue to use, with 0-360 mapped to 0-255
+ * @param sat_bg[in] the background saturation to use, with 0-100% mapped to 0-255
+ * @param val_bg[in] the background value to use, with 0-100% mapped to 0-255
+ * @return the \ref deferred_token to use with \ref qp_stop_animation in order to stop animating
+ * @return INVALID_DEFERRED_TOKEN if animating the image failed
+ */
+deferred_token qp_animate_recolor_via_surface(painter_device_t device, painter_device_t surface, uint16_t x, uint16_t y, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg);
+
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
+
 /**
  * Cancels a running animation.
  *
- * @param anim_token[in] the animation token returned by \ref qp_animate, or \ref qp_animate_recolor.
+ * @param anim_token[in] the animation token returned by \ref qp_animate, \ref qp_animate_recolor, \ref qp_animate_via_surface, or
+ *                       \ref qp_animate_recolor_via_surface.
  */
 void qp_stop_animation(deferred_token anim_token);
 
@@ -23,6 +23,11 @@ bool qp_comms_start(painter_device_t device) {
         return false;
     }
 
+    // Any outstanding asynchronous transfer is still holding the bus, so let it complete first
+    if (!qp_comms_async_finish()) {
+        qp_dprintf("qp_comms_start: outstanding asynchronous transfer timed out, aborted\n");
+    }
+
     return driver->comms_vtable->comms_start(device);
 }
 
@@ -46,6 +51,77 @@ uint32_t qp_comms_send(painter_device_t device, const void *data, uint32_t byte_
     return driver->comms_vtable->comms_send(device, data, byte_count);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous comms APIs
+
+// The device whose comms were left started by an asynchronous transfer, and need stopping once it completes
+static painter_device_t            async_device   = NULL;
+static volatile bool               async_busy     = false;
+static qp_pixdata_async_callback_t async_callback = NULL;
+static void *                      async_cb_arg   = NULL;
+
+static void qp_comms_async_complete(void *cb_arg) {
+    async_busy = false;
+    if (async_callback) {
+        async_callback(async_device, async_cb_arg);
+    }
+}
+
+bool qp_comms_send_async(painter_device_t device, const void *data, uint32_t byte_count, qp_pixdata_async_callback_t callback, void *cb_arg) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver || !driver->validate_ok) {
+        qp_dprintf("qp_comms_send_async: fail (validation_ok == false)\n");
+        return false;
+    }
+
+    async_device   = device;
+    async_callback = callback;
+    async_cb_arg   = cb_arg;
+    async_busy     = true;
+
+    if (driver->comms_vtable->comms_send_async && driver->comms_vtable->comms_async_wait) {
+        if (!driver->comms_vtable->comms_send_async(device, data, byte_count, qp_comms_async_complete, NULL)) {
+            qp_dprintf("qp_comms_send_async: fail (could not start transfer)\n");
+            async_busy   = false;
+            async_device = NULL;
+            return false;
+        }
+        return true;
+    }
+
+    // No asynchronous support in the comms driver, so transfer synchronously
+    driver->comms_vtable->comms_send(device, data, byte_count);
+    qp_comms_async_complete(NULL);
+    return true;
+}
+
+bool qp_comms_async_busy(void) {
+    return async_busy;
+}
+
+bool qp_comms_async_finish(void) {
+    if (!async_device) {
+        return true;
+    }
+
+    painter_device_t  device = async_device;
+    painter_driver_t *driver = (painter_driver_t *)device;
+    bool              ok     = !async_busy || driver->comms_vtable->comms_async_wait(device, QUANTUM_PAINTER_ASYNC_TIMEOUT);
+    if (!ok) {
+        qp_dprintf("qp_comms_async_finish: fail (transfer timed out)\n");
+    }
+
+    // Stopping comms releases the bus, and aborts the transfer if its completion was lost
+    qp_comms_stop(device);
+
+    // Hand the buffer back regardless, so that whoever is waiting on the callback isn't stuck forever
+    if (async_busy) {
+        qp_comms_async_complete(NULL);
+    }
+    async_device = NULL;
+    return ok;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
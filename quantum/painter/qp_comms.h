@@ -16,6 +16,13 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous comms APIs
+
+bool qp_comms_send_async(painter_device_t device, const void* data, uint32_t byte_count, qp_pixdata_async_callback_t callback, void* cb_arg);
+bool qp_comms_async_busy(void);
+bool qp_comms_async_finish(void);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
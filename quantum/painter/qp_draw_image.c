@@ -7,6 +7,10 @@
 #include "qgf.h"
 #include "deferred_exec.h"
 
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+#    include "qp_surface.h"
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QGF image handles
 
@@ -290,6 +294,7 @@ deferred_token qp_animate(painter_device_t device, uint16_t x, uint16_t y, paint
 
 typedef struct animation_state_t {
     painter_device_t       device;
+    painter_device_t       surface; // optional keyframe surface, NULL if frames are drawn directly to the device
     uint16_t               x;
     uint16_t               y;
     painter_image_handle_t image;
@@ -305,7 +310,19 @@ static animation_state_t   animation_states[QUANTUM_PAINTER_CONCURRENT_ANIMATION
 static deferred_token qp_render_animation_state(animation_state_t *state, uint16_t *delay_ms) {
     qgf_frame_info_t frame_info = {0};
     qp_dprintf("qp_render_animation_state: entry (frame #%d)\n", (int)state->frame_number);
-    bool ret = qp_drawimage_recolor_impl(state->device, state->x, state->y, state->image, state->frame_number, &frame_info, state->fg_hsv888, state->bg_hsv888);
+    bool ret;
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+    if (state->surface) {
+        // Decode the frame (or delta) into the keyframe surface, then only send the pixels that actually changed
+        ret = qp_drawimage_recolor_impl(state->surface, 0, 0, state->image, state->frame_number, &frame_info, state->fg_hsv888, state->bg_hsv888);
+        if (ret) {
+            ret = qp_surface_draw(state->surface, state->device, state->x, state->y, false);
+        }
+    } else
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
+    {
+        ret = qp_drawimage_recolor_impl(state->device, state->x, state->y, state->image, state->frame_number, &frame_info, state->fg_hsv888, state->bg_hsv888);
+    }
     if (ret) {
         ++state->frame_number;
         if (state->frame_number >= state->image->frame_count) {
@@ -323,13 +340,14 @@ static uint32_t animation_callback(uint32_t trigger_time, void *cb_arg) {
     bool               ret      = qp_render_animation_state(state, &delay_ms);
     if (!ret) {
         // Setting the device to NULL clears the animation slot
-        state->device = NULL;
+        state->device  = NULL;
+        state->surface = NULL;
     }
     // If we're successful, keep animating -- returning 0 cancels the deferred execution
     return ret ? delay_ms : 0;
 }
 
-deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+static deferred_token qp_animate_recolor_impl(painter_device_t device, painter_device_t surface, uint16_t x, uint16_t y, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
     qp_dprintf("qp_animate_recolor: entry\n");
 
     animation_state_t *anim_state = NULL;
@@ -347,6 +365,7 @@ deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t
 
     // Prepare the animation state
     anim_state->device       = device;
+    anim_state->surface      = surface;
     anim_state->x            = x;
     anim_state->y            = y;
     anim_state->image        = image;
@@ -374,6 +393,47 @@ deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t
     return anim_state->defer_token;
 }
 
+deferred_token qp_animate_recolor(painter_device_t device, uint16_t x, uint16_t y, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    return qp_animate_recolor_impl(device, NULL, x, y, image, hue_fg, sat_fg, val_fg, hue_bg, sat_bg, val_bg);
+}
+
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_animate_via_surface
+
+deferred_token qp_animate_via_surface(painter_device_t device, painter_device_t surface, uint16_t x, uint16_t y, painter_image_handle_t image) {
+    return qp_animate_recolor_via_surface(device, surface, x, y, image, 0, 0, 255, 0, 0, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Quantum Painter External API: qp_animate_recolor_via_surface
+
+deferred_token qp_animate_recolor_via_surface(painter_device_t device, painter_device_t surface, uint16_t x, uint16_t y, painter_image_handle_t image, uint8_t hue_fg, uint8_t sat_fg, uint8_t val_fg, uint8_t hue_bg, uint8_t sat_bg, uint8_t val_bg) {
+    painter_driver_t *driver         = (painter_driver_t *)device;
+    painter_driver_t *surface_driver = (painter_driver_t *)surface;
+    if (!driver || !driver->validate_ok || !surface_driver || !surface_driver->validate_ok || !image) {
+        qp_dprintf("qp_animate_recolor_via_surface: fail (invalid device, surface or image)\n");
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // The surface's pixel data is streamed to the device as-is, so both need to use the same native pixel format
+    if (surface_driver->native_bits_per_pixel != driver->native_bits_per_pixel) {
+        qp_dprintf("qp_animate_recolor_via_surface: fail (incompatible bpp: surface=%d, device=%d)\n", (int)surface_driver->native_bits_per_pixel, (int)driver->native_bits_per_pixel);
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // The keyframe surface needs to be able to hold an entire frame
+    if (surface_driver->panel_width < image->width || surface_driver->panel_height < image->height) {
+        qp_dprintf("qp_animate_recolor_via_surface: fail (surface %dx%d smaller than image %dx%d)\n", (int)surface_driver->panel_width, (int)surface_driver->panel_height, (int)image->width, (int)image->height);
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    return qp_animate_recolor_impl(device, surface, x, y, image, hue_fg, sat_fg, val_fg, hue_bg, sat_bg, val_bg);
+}
+
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter External API: qp_stop_animation
 
@@ -381,7 +441,8 @@ void qp_stop_animation(deferred_token anim_token) {
     for (int i = 0; i < QUANTUM_PAINTER_CONCURRENT_ANIMATIONS; ++i) {
         if (animation_states[i].defer_token == anim_token) {
             cancel_deferred_exec_advanced(animation_executors, QUANTUM_PAINTER_CONCURRENT_ANIMATIONS, anim_token);
-            animation_states[i].device = NULL;
+            animation_states[i].device  = NULL;
+            animation_states[i].surface = NULL;
             return;
         }
     }
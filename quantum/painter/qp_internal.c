@@ -23,7 +23,8 @@ enum {
                      + (LD7032_NUM_DEVICES)  // LD7032
 };
 
-static painter_device_t qp_devices[QP_NUM_DEVICES] = {NULL};
+// At least one entry, so that the table can still be initialised when only surfaces are enabled
+static painter_device_t qp_devices[QP_NUM_DEVICES > 0 ? QP_NUM_DEVICES : 1] = {NULL};
 
 bool qp_internal_register_device(painter_device_t driver) {
     for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
@@ -97,7 +98,8 @@ void qp_internal_task(void) {
     bool old_debug_state = debug_enable;
     debug_enable         = false;
 #endif // defined(QUANTUM_PAINTER_DEBUG_ENABLE_FLUSH_TASK_OUTPUT)
-    for (uint8_t i = 0; i < QP_NUM_DEVICES; i++) {
+    // Skip this round if an asynchronous transfer is still in flight, rather than stalling until it completes
+    for (uint8_t i = 0; i < QP_NUM_DEVICES && !qp_pixdata_async_busy(); i++) {
         if (qp_devices[i] != NULL) {
             qp_flush(qp_devices[i]);
         }
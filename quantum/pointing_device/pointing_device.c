@@ -17,9 +17,11 @@
  */
 
 #include "pointing_device.h"
+#include <stdlib.h>
 #include <string.h>
 #include "timer.h"
 #include "gpio.h"
+#include "util.h"
 
 #ifdef MOUSEKEY_ENABLE
 #    include "mousekey.h"
@@ -42,16 +44,11 @@
 report_mouse_t shared_mouse_report = {};
 uint16_t       shared_cpi          = 0;
 
-/**
- * @brief Sets the shared mouse report used be pointing device task
- *
- * NOTE : Only available when using SPLIT_POINTING_ENABLE
- *
- * @param[in] new_mouse_report report_mouse_t
- */
-void pointing_device_set_shared_report(report_mouse_t new_mouse_report) {
-    shared_mouse_report = new_mouse_report;
-}
+// Motion received from the other side that hasn't been consumed by pointing_device_task yet
+static int32_t shared_motion_x = 0;
+static int32_t shared_motion_y = 0;
+static int32_t shared_motion_h = 0;
+static int32_t shared_motion_v = 0;
 
 /**
  * @brief Gets current pointing device CPI if supported
@@ -168,7 +165,7 @@ __attribute__((weak)) void pointing_device_init(void) {
 #endif
     {
         pointing_device_driver->init();
-#ifdef POINTING_DEVICE_MOTION_PIN
+#if defined(POINTING_DEVICE_MOTION_PIN) && !defined(PMW33XX_MOTION_THREAD_ENABLE)
 #    ifdef POINTING_DEVICE_MOTION_PIN_ACTIVE_LOW
         gpio_set_pin_input_high(POINTING_DEVICE_MOTION_PIN);
 #    else
@@ -203,6 +200,87 @@ __attribute__((weak)) bool pointing_device_send(void) {
     return should_send_report || buttons;
 }
 
+/**
+ * @brief clamps a wheel value to the range of the report
+ *
+ * @param[in] int32_t value
+ * @return mouse_hv_report_t clamped value
+ */
+static inline mouse_hv_report_t pointing_device_hv_clamp(int32_t value) {
+    if (value < HV_REPORT_MIN) {
+        return HV_REPORT_MIN;
+    } else if (value > HV_REPORT_MAX) {
+        return HV_REPORT_MAX;
+    } else {
+        return value;
+    }
+}
+
+/**
+ * @brief clamps a movement value to the range of the report
+ *
+ * @param[in] int32_t value
+ * @return mouse_xy_report_t clamped value
+ */
+static inline mouse_xy_report_t pointing_device_xy_clamp(int32_t value) {
+    if (value < XY_REPORT_MIN) {
+        return XY_REPORT_MIN;
+    } else if (value > XY_REPORT_MAX) {
+        return XY_REPORT_MAX;
+    } else {
+        return value;
+    }
+}
+
+#if defined(SPLIT_POINTING_ENABLE)
+/**
+ * @brief Adds motion received from the other side to the shared report
+ *
+ * The movement is accumulated until it is consumed by pointing_device_task, so nothing is lost when several transfers arrive between two
+ * tasks. Buttons are taken as they are.
+ *
+ * NOTE : Only available when using SPLIT_POINTING_ENABLE
+ *
+ * @param[in] delta report_mouse_t holding the movement since the last call
+ */
+void pointing_device_add_shared_report(report_mouse_t delta) {
+    shared_motion_x += delta.x;
+    shared_motion_y += delta.y;
+    shared_motion_h += delta.h;
+    shared_motion_v += delta.v;
+    shared_mouse_report.buttons = delta.buttons;
+}
+
+/**
+ * @brief Replaces the shared report, discarding any motion still waiting to be consumed
+ *
+ * DEPRECATED: use pointing_device_add_shared_report() instead, which doesn't lose motion when several transfers arrive between two tasks
+ *
+ * @param[in] report report_mouse_t to replace the shared report with
+ */
+void pointing_device_set_shared_report(report_mouse_t report) {
+    shared_motion_x = 0;
+    shared_motion_y = 0;
+    shared_motion_h = 0;
+    shared_motion_v = 0;
+    pointing_device_add_shared_report(report);
+}
+
+/**
+ * @brief Moves as much of the accumulated shared motion as fits into the shared report
+ */
+static void pointing_device_drain_shared_report(void) {
+    shared_mouse_report.x = pointing_device_xy_clamp(shared_motion_x);
+    shared_mouse_report.y = pointing_device_xy_clamp(shared_motion_y);
+    shared_mouse_report.h = pointing_device_hv_clamp(shared_motion_h);
+    shared_mouse_report.v = pointing_device_hv_clamp(shared_motion_v);
+    shared_motion_x -= shared_mouse_report.x;
+    shared_motion_y -= shared_mouse_report.y;
+    shared_motion_h -= shared_mouse_report.h;
+    shared_motion_v -= shared_mouse_report.v;
+}
+#endif
+
 /**
  * @brief Adjust mouse report by any optional common pointing configuration defines
  *
@@ -239,6 +317,130 @@ report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report) {
     return mouse_report;
 }
 
+static bool    drag_scroll_enabled = false;
+static int32_t motion_remainder_x  = 0;
+static int32_t motion_remainder_y  = 0;
+static int32_t scroll_remainder_h  = 0;
+static int32_t scroll_remainder_v  = 0;
+
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+static const pointing_device_accel_point_t accel_curve[] = POINTING_DEVICE_ACCEL_CURVE;
+
+/**
+ * @brief Looks up the acceleration gain for a given speed
+ *
+ * Interpolates linearly between the points of POINTING_DEVICE_ACCEL_CURVE, holding the gain of the first and last point beyond either end.
+ *
+ * @param[in] speed counts per report
+ * @return uint16_t gain, 256 being 1.0
+ */
+static uint16_t pointing_device_accel_gain(uint16_t speed) {
+    if (speed <= accel_curve[0].speed) {
+        return accel_curve[0].gain;
+    }
+    for (uint8_t i = 1; i < ARRAY_SIZE(accel_curve); i++) {
+        if (speed < accel_curve[i].speed) {
+            const pointing_device_accel_point_t *lo = &accel_curve[i - 1];
+            const pointing_device_accel_point_t *hi = &accel_curve[i];
+            return lo->gain + (int32_t)(hi->gain - lo->gain) * (speed - lo->speed) / (hi->speed - lo->speed);
+        }
+    }
+    return accel_curve[ARRAY_SIZE(accel_curve) - 1].gain;
+}
+#endif
+
+/**
+ * @brief Divides a fixed point accumulator, keeping the remainder for the next report
+ *
+ * @param[in,out] accumulator value to divide, left holding the remainder
+ * @param[in] divisor
+ * @return int32_t whole part of the division
+ */
+static inline int32_t pointing_device_take_whole(int32_t *accumulator, int32_t divisor) {
+    int32_t whole = *accumulator / divisor;
+    *accumulator -= whole * divisor;
+    return whole;
+}
+
+/**
+ * @brief Runs the fixed point motion pipeline over a report
+ *
+ * Applies the acceleration curve to X/Y and, while drag scroll is enabled, turns movement into wheel motion. Fractions of a count are carried over
+ * to the next report rather than discarded, so slow movement is neither lost nor quantised. Wheel values are converted to the units currently
+ * expected by the host, so they are scaled up once high resolution scrolling has been negotiated.
+ *
+ * @param[in] mouse_report report_mouse_t in sensor counts and wheel detents
+ * @return report_mouse_t ready to be sent to the host
+ */
+report_mouse_t pointing_device_process_motion(report_mouse_t mouse_report) {
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+    const int32_t multiplier_h = host_mouse_wheel_multiplier(true);
+    const int32_t multiplier_v = host_mouse_wheel_multiplier(false);
+#else
+    const int32_t multiplier_h = 1;
+    const int32_t multiplier_v = 1;
+#endif
+    int32_t h = mouse_report.h * multiplier_h;
+    int32_t v = mouse_report.v * multiplier_v;
+
+    if (drag_scroll_enabled) {
+        scroll_remainder_h += (int32_t)mouse_report.x * multiplier_h;
+#ifdef POINTING_DEVICE_DRAG_SCROLL_INVERT
+        scroll_remainder_v -= (int32_t)mouse_report.y * multiplier_v;
+#else
+        scroll_remainder_v += (int32_t)mouse_report.y * multiplier_v;
+#endif
+        h += pointing_device_take_whole(&scroll_remainder_h, POINTING_DEVICE_DRAG_SCROLL_DIVISOR_H);
+        v += pointing_device_take_whole(&scroll_remainder_v, POINTING_DEVICE_DRAG_SCROLL_DIVISOR_V);
+        mouse_report.x = 0;
+        mouse_report.y = 0;
+    }
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+    else if (mouse_report.x || mouse_report.y) {
+        // Octagonal approximation of the vector length, within 12% of the real thing
+        uint16_t ax    = abs(mouse_report.x);
+        uint16_t ay    = abs(mouse_report.y);
+        uint16_t speed = ax > ay ? ax + ay / 2 : ay + ax / 2;
+        uint16_t gain  = pointing_device_accel_gain(speed);
+
+        motion_remainder_x += (int32_t)mouse_report.x * gain;
+        motion_remainder_y += (int32_t)mouse_report.y * gain;
+        mouse_report.x = pointing_device_xy_clamp(pointing_device_take_whole(&motion_remainder_x, 256));
+        mouse_report.y = pointing_device_xy_clamp(pointing_device_take_whole(&motion_remainder_y, 256));
+    }
+#endif
+
+    mouse_report.h = pointing_device_hv_clamp(h);
+    mouse_report.v = pointing_device_hv_clamp(v);
+    return mouse_report;
+}
+
+/**
+ * @brief Enables or disables drag scroll
+ *
+ * While enabled, pointer movement is turned into wheel motion of one detent per POINTING_DEVICE_DRAG_SCROLL_DIVISOR_H/V counts.
+ *
+ * @param[in] enable bool
+ */
+void pointing_device_set_drag_scroll(bool enable) {
+    if (enable != drag_scroll_enabled) {
+        drag_scroll_enabled = enable;
+        motion_remainder_x  = 0;
+        motion_remainder_y  = 0;
+        scroll_remainder_h  = 0;
+        scroll_remainder_v  = 0;
+    }
+}
+
+/**
+ * @brief Gets the drag scroll state
+ *
+ * @return bool true if drag scroll is enabled
+ */
+bool pointing_device_get_drag_scroll(void) {
+    return drag_scroll_enabled;
+}
+
 /**
  * @brief Retrieves and processes pointing device data.
  *
@@ -263,7 +465,8 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
     // Gather report info
-#ifdef POINTING_DEVICE_MOTION_PIN
+    // When the sensor driver services the motion pin itself, the report has to be fetched every time to collect the counts
+#if defined(POINTING_DEVICE_MOTION_PIN) && !defined(PMW33XX_MOTION_THREAD_ENABLE)
 #    if defined(SPLIT_POINTING_ENABLE)
 #        error POINTING_DEVICE_MOTION_PIN not supported when sharing the pointing device report between sides.
 #    endif
@@ -276,6 +479,7 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #endif
 
 #if defined(SPLIT_POINTING_ENABLE)
+        pointing_device_drain_shared_report();
 #    if defined(POINTING_DEVICE_COMBINED)
         static uint8_t old_buttons = 0;
         local_mouse_report.buttons = old_buttons;
@@ -290,7 +494,7 @@ __attribute__((weak)) bool pointing_device_task(void) {
     local_mouse_report = pointing_device_driver->get_report(local_mouse_report);
 #endif // defined(SPLIT_POINTING_ENABLE)
 
-#ifdef POINTING_DEVICE_MOTION_PIN
+#if defined(POINTING_DEVICE_MOTION_PIN) && !defined(PMW33XX_MOTION_THREAD_ENABLE)
     }
 #endif
 
@@ -308,6 +512,7 @@ __attribute__((weak)) bool pointing_device_task(void) {
     local_mouse_report = pointing_device_adjust_by_defines(local_mouse_report);
     local_mouse_report = pointing_device_task_kb(local_mouse_report);
 #endif
+    local_mouse_report = pointing_device_process_motion(local_mouse_report);
     // automatic mouse layer function
 #ifdef POINTING_DEVICE_AUTO_MOUSE_ENABLE
     pointing_device_task_auto_mouse(local_mouse_report);
@@ -316,6 +521,14 @@ __attribute__((weak)) bool pointing_device_task(void) {
 #ifdef MOUSEKEY_ENABLE
     report_mouse_t mousekey_report = mousekey_get_report();
     local_mouse_report.buttons     = local_mouse_report.buttons | mousekey_report.buttons;
+#    ifdef MOUSEKEY_FRAME_INTEGRATION
+    // Mouse keys motion rides along in this report rather than being sent on its own
+    mousekey_report      = mousekey_take_motion();
+    local_mouse_report.x = pointing_device_xy_clamp((int32_t)local_mouse_report.x + mousekey_report.x);
+    local_mouse_report.y = pointing_device_xy_clamp((int32_t)local_mouse_report.y + mousekey_report.y);
+    local_mouse_report.h = pointing_device_hv_clamp((int32_t)local_mouse_report.h + mousekey_report.h);
+    local_mouse_report.v = pointing_device_hv_clamp((int32_t)local_mouse_report.v + mousekey_report.v);
+#    endif
 #endif
 
     const bool send_report     = pointing_device_send() || pointing_device_force_send;
@@ -397,37 +610,6 @@ void pointing_device_set_cpi_on_side(bool left, uint16_t cpi) {
     }
 }
 
-/**
- * @brief clamps int16_t to int8_t, or int32_t to int16_t
- *
- * @param[in] hv_clamp_range_t value
- * @return mouse_hv_report_t clamped value
- */
-static inline mouse_hv_report_t pointing_device_hv_clamp(hv_clamp_range_t value) {
-    if (value < HV_REPORT_MIN) {
-        return HV_REPORT_MIN;
-    } else if (value > HV_REPORT_MAX) {
-        return HV_REPORT_MAX;
-    } else {
-        return value;
-    }
-}
-
-/**
- * @brief clamps int16_t to int8_t, or int32_t to int16_t
- *
- * @param[in] xy_clamp_range_t value
- * @return mouse_xy_report_t clamped value
- */
-static inline mouse_xy_report_t pointing_device_xy_clamp(xy_clamp_range_t value) {
-    if (value < XY_REPORT_MIN) {
-        return XY_REPORT_MIN;
-    } else if (value > XY_REPORT_MAX) {
-        return XY_REPORT_MAX;
-    } else {
-        return value;
-    }
-}
 /**
  * @brief combines 2 mouse reports and returns 2
  *
@@ -113,6 +113,26 @@ typedef int16_t hv_clamp_range_t;
 
 #define CONSTRAIN_HID(amt) ((amt) < INT8_MIN ? INT8_MIN : ((amt) > INT8_MAX ? INT8_MAX : (amt)))
 #define CONSTRAIN_HID_XY(amt) ((amt) < XY_REPORT_MIN ? XY_REPORT_MIN : ((amt) > XY_REPORT_MAX ? XY_REPORT_MAX : (amt)))
+#define CONSTRAIN_HID_HV(amt) ((amt) < HV_REPORT_MIN ? HV_REPORT_MIN : ((amt) > HV_REPORT_MAX ? HV_REPORT_MAX : (amt)))
+
+#ifdef POINTING_DEVICE_ACCEL_ENABLE
+typedef struct {
+    uint16_t speed; // counts per report
+    uint16_t gain;  // 256 = 1.0
+} pointing_device_accel_point_t;
+
+#    ifndef POINTING_DEVICE_ACCEL_CURVE
+#        define POINTING_DEVICE_ACCEL_CURVE {{0, 256}, {4, 256}, {16, 384}, {48, 640}, {96, 768}}
+#    endif
+#endif
+
+// Sensor counts per wheel detent while drag scrolling
+#ifndef POINTING_DEVICE_DRAG_SCROLL_DIVISOR_H
+#    define POINTING_DEVICE_DRAG_SCROLL_DIVISOR_H 64
+#endif
+#ifndef POINTING_DEVICE_DRAG_SCROLL_DIVISOR_V
+#    define POINTING_DEVICE_DRAG_SCROLL_DIVISOR_V 64
+#endif
 
 void           pointing_device_init(void);
 bool           pointing_device_task(void);
@@ -129,10 +149,15 @@ report_mouse_t pointing_device_task_user(report_mouse_t mouse_report);
 uint8_t        pointing_device_handle_buttons(uint8_t buttons, bool pressed, pointing_device_buttons_t button);
 report_mouse_t pointing_device_adjust_by_defines(report_mouse_t mouse_report);
 void           pointing_device_keycode_handler(uint16_t keycode, bool pressed);
+report_mouse_t pointing_device_process_motion(report_mouse_t mouse_report);
+void           pointing_device_set_drag_scroll(bool enable);
+bool           pointing_device_get_drag_scroll(void);
 
 #if defined(SPLIT_POINTING_ENABLE)
-void     pointing_device_set_shared_report(report_mouse_t report);
+void     pointing_device_add_shared_report(report_mouse_t delta);
 uint16_t pointing_device_get_shared_cpi(void);
+// DEPRECATED: use pointing_device_add_shared_report() instead
+void pointing_device_set_shared_report(report_mouse_t report);
 #    if !defined(POINTING_DEVICE_TASK_THROTTLE_MS)
 #        define POINTING_DEVICE_TASK_THROTTLE_MS 1
 #    endif
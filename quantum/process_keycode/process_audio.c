@@ -5,7 +5,7 @@
 #ifndef VOICE_CHANGE_SONG
 #    define VOICE_CHANGE_SONG SONG(VOICE_CHANGE_SOUND)
 #endif
-float voice_change_song[][2] = VOICE_CHANGE_SONG;
+const audio_compact_note_t voice_change_song[] PROGMEM = VOICE_CHANGE_SONG;
 
 #ifndef PITCH_STANDARD_A
 #    define PITCH_STANDARD_A 440.0f
@@ -38,13 +38,13 @@ bool process_audio(uint16_t keycode, keyrecord_t *record) {
 
     if (keycode == QK_AUDIO_VOICE_NEXT && record->event.pressed) {
         voice_iterate();
-        PLAY_SONG(voice_change_song);
+        PLAY_COMPACT_SONG(voice_change_song);
         return false;
     }
 
     if (keycode == QK_AUDIO_VOICE_PREVIOUS && record->event.pressed) {
         voice_deiterate();
-        PLAY_SONG(voice_change_song);
+        PLAY_COMPACT_SONG(voice_change_song);
         return false;
     }
 
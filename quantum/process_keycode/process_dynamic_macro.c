@@ -18,11 +18,19 @@
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
 #include <stddef.h>
+#include <string.h>
 #include "action_layer.h"
 #include "keycodes.h"
 #include "debug.h"
+#include "timer.h"
+#include "util.h"
 #include "wait.h"
 
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    include "eeprom.h"
+#    include "eeconfig.h"
+#endif
+
 #ifdef BACKLIGHT_ENABLE
 #    include "backlight.h"
 #endif
@@ -82,188 +90,505 @@ __attribute__((weak)) bool dynamic_macro_valid_key_user(uint16_t keycode, keyrec
     return true;
 }
 
-/* Convenience macros used for retrieving the debug info. All of them
- * need a `direction` variable accessible at the call site.
+#if DYNAMIC_MACRO_COUNT < 2
+#    error "DYNAMIC_MACRO_COUNT must be at least 2"
+#endif
+
+_Static_assert(DYNAMIC_MACRO_BUFFER_SIZE <= 65535, "DYNAMIC_MACRO_BUFFER_SIZE must be less than 65536");
+
+/* Events are stored back to back in a compact variable length format,
+ * starting with a header byte:
+ *
+ *   bit 7    key pressed
+ *   bit 6    long form
+ *   bit 0-5  delay since the previous event, in DYNAMIC_MACRO_TIME_UNIT,
+ *            63 means the delay follows as a little endian 16 bit value
+ *
+ * A plain key event at a matrix position is stored in short form, as
+ * its index in the matrix -- one byte if the matrix has at most 256
+ * positions, otherwise row and column. Everything else (encoders,
+ * combos, tapped keys, events carrying a keycode) uses the long form:
+ * type and tap state in one byte, then row and column, then the
+ * keycode if keyrecord_t has one.
+ */
+#define DM_HEADER_PRESSED 0x80
+#define DM_HEADER_LONG 0x40
+#define DM_HEADER_DELAY_MASK 0x3F
+#define DM_DELAY_EXTENDED DM_HEADER_DELAY_MASK
+
+#if (MATRIX_ROWS * MATRIX_COLS) <= 256
+#    define DM_SHORT_KEY_SIZE 1
+#else
+#    define DM_SHORT_KEY_SIZE 2
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+#    define DM_LONG_KEY_SIZE 5
+#else
+#    define DM_LONG_KEY_SIZE 3
+#endif
+#define DM_MAX_EVENT_SIZE (1 + 2 + DM_LONG_KEY_SIZE)
+
+#define DM_NO_SLOT 0xFF
+
+typedef struct {
+    uint16_t offset;
+    uint16_t length;
+} dynamic_macro_slot_t;
+
+/* All macros share one buffer. Each slot is a contiguous range of it,
+ * and the ranges are packed from the start of the buffer without gaps:
+ * recording a slot first removes its old contents, moving the slots
+ * behind it down, then appends the new events at the end. Any mix of
+ * lengths fits, as long as the total does.
+ */
+static uint8_t              macro_buffer[DYNAMIC_MACRO_BUFFER_SIZE];
+static uint16_t             macro_buffer_used = 0;
+static dynamic_macro_slot_t macro_slots[DYNAMIC_MACRO_COUNT];
+
+static uint8_t  recording_slot = DM_NO_SLOT;
+static uint16_t recording_last_time;
+
+typedef struct {
+    uint8_t       slot;
+    uint16_t      position;    // Relative to the start of the slot
+    layer_state_t layer_state; // The layers as the macro left them, starting from the base layer
+} dynamic_macro_frame_t;
+
+static dynamic_macro_frame_t play_stack[DYNAMIC_MACRO_NESTING_DEPTH];
+static uint8_t               play_depth = 0;
+static uint32_t              play_timer;
+static uint32_t              play_delay;
+
+/* Keeps the direction argument of the hooks compatible with the two
+ * slot implementation: 1 for macro 1, -1 for macro 2, and the macro
+ * number for any further ones.
  */
-#define DYNAMIC_MACRO_CURRENT_SLOT() (direction > 0 ? 1 : 2)
-#define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
-#define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
+static int8_t slot_direction(uint8_t slot) {
+    switch (slot) {
+        case 0:
+            return 1;
+        case 1:
+            return -1;
+        default:
+            return slot + 1;
+    }
+}
+
+static uint8_t encode_event(uint8_t *data, keyrecord_t *record, uint16_t delay) {
+    uint8_t size     = 0;
+    uint8_t header   = record->event.pressed ? DM_HEADER_PRESSED : 0;
+    bool    is_short = record->event.type == KEY_EVENT && record->event.key.row < MATRIX_ROWS && record->event.key.col < MATRIX_COLS;
+#ifndef NO_ACTION_TAPPING
+    is_short &= record->tap.count == 0 && !record->tap.interrupted;
+#endif
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    is_short &= record->keycode == KC_NO;
+#endif
+    if (!is_short) {
+        header |= DM_HEADER_LONG;
+    }
+
+    if (delay < DM_DELAY_EXTENDED) {
+        data[size++] = header | delay;
+    } else {
+        data[size++] = header | DM_DELAY_EXTENDED;
+        data[size++] = delay & 0xFF;
+        data[size++] = delay >> 8;
+    }
+
+    if (is_short) {
+#if DM_SHORT_KEY_SIZE == 1
+        data[size++] = record->event.key.row * MATRIX_COLS + record->event.key.col;
+#else
+        data[size++] = record->event.key.row;
+        data[size++] = record->event.key.col;
+#endif
+        return size;
+    }
+
+    uint8_t type = record->event.type & 0x07;
+#ifndef NO_ACTION_TAPPING
+    type |= (record->tap.count << 3) | (record->tap.interrupted ? 0x80 : 0);
+#endif
+    data[size++] = type;
+    data[size++] = record->event.key.row;
+    data[size++] = record->event.key.col;
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    data[size++] = record->keycode & 0xFF;
+    data[size++] = record->keycode >> 8;
+#endif
+    return size;
+}
+
+static uint8_t decode_event(const uint8_t *data, keyrecord_t *record, uint16_t *delay) {
+    uint8_t size   = 0;
+    uint8_t header = data[size++];
+
+    memset(record, 0, sizeof(keyrecord_t));
+    record->event.pressed = header & DM_HEADER_PRESSED;
+    record->event.time    = timer_read() | 1;
+
+    *delay = header & DM_HEADER_DELAY_MASK;
+    if (*delay == DM_DELAY_EXTENDED) {
+        *delay = data[size] | (data[size + 1] << 8);
+        size += 2;
+    }
+
+    if (!(header & DM_HEADER_LONG)) {
+        record->event.type = KEY_EVENT;
+#if DM_SHORT_KEY_SIZE == 1
+        record->event.key.row = data[size] / MATRIX_COLS;
+        record->event.key.col = data[size] % MATRIX_COLS;
+        size += 1;
+#else
+        record->event.key.row = data[size++];
+        record->event.key.col = data[size++];
+#endif
+        return size;
+    }
+
+    uint8_t type       = data[size++];
+    record->event.type = type & 0x07;
+#ifndef NO_ACTION_TAPPING
+    record->tap.count       = (type >> 3) & 0x0F;
+    record->tap.interrupted = type & 0x80;
+#endif
+    record->event.key.row = data[size++];
+    record->event.key.col = data[size++];
+#if defined(COMBO_ENABLE) || defined(REPEAT_KEY_ENABLE)
+    record->keycode = data[size] | (data[size + 1] << 8);
+    size += 2;
+#endif
+    return size;
+}
+
+static uint8_t event_size(const uint8_t *data) {
+    uint8_t size = 1;
+    if ((data[0] & DM_HEADER_DELAY_MASK) == DM_DELAY_EXTENDED) {
+        size += 2;
+    }
+    return size + ((data[0] & DM_HEADER_LONG) ? DM_LONG_KEY_SIZE : DM_SHORT_KEY_SIZE);
+}
+
+/* Removes a slot from the buffer, moving the slots behind it down.
+ */
+static void slot_clear(uint8_t slot) {
+    dynamic_macro_slot_t *macro = &macro_slots[slot];
+    uint16_t              end   = macro->offset + macro->length;
+
+    memmove(&macro_buffer[macro->offset], &macro_buffer[end], macro_buffer_used - end);
+    for (uint8_t i = 0; i < DYNAMIC_MACRO_COUNT; i++) {
+        if (macro_slots[i].offset > macro->offset) {
+            macro_slots[i].offset -= macro->length;
+        }
+    }
+    macro_buffer_used -= macro->length;
+    macro->offset = macro_buffer_used;
+    macro->length = 0;
+}
+
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+#    ifndef DYNAMIC_MACRO_EEPROM_ADDR
+#        ifdef DYNAMIC_KEYMAP_ENABLE
+#            error "DYNAMIC_MACRO_EEPROM_STORAGE requires DYNAMIC_MACRO_EEPROM_ADDR to be set outside of the dynamic keymap"
+#        endif
+#        define DYNAMIC_MACRO_EEPROM_ADDR (EECONFIG_SIZE)
+#    endif
+
+// Changes whenever the layout of the stored data does, so that stale macros aren't loaded
+#    define DYNAMIC_MACRO_EEPROM_MAGIC (0xD300 | (DYNAMIC_MACRO_COUNT << 2) | (DM_SHORT_KEY_SIZE - 1) << 1 | (DM_LONG_KEY_SIZE == 5))
+
+typedef struct PACKED {
+    uint16_t             magic;
+    uint16_t             used;
+    dynamic_macro_slot_t slots[DYNAMIC_MACRO_COUNT];
+} dynamic_macro_eeprom_header_t;
+
+_Static_assert(DYNAMIC_MACRO_EEPROM_ADDR + sizeof(dynamic_macro_eeprom_header_t) + DYNAMIC_MACRO_BUFFER_SIZE <= TOTAL_EEPROM_BYTE_COUNT, "Dynamic macros don't fit into the EEPROM, lower DYNAMIC_MACRO_BUFFER_SIZE or DYNAMIC_MACRO_EEPROM_ADDR");
+
+#    define DYNAMIC_MACRO_EEPROM_HEADER ((void *)(DYNAMIC_MACRO_EEPROM_ADDR))
+#    define DYNAMIC_MACRO_EEPROM_BUFFER ((void *)(DYNAMIC_MACRO_EEPROM_ADDR + sizeof(dynamic_macro_eeprom_header_t)))
+
+static void dynamic_macro_load(void) {
+    dynamic_macro_eeprom_header_t header;
+    eeprom_read_block(&header, DYNAMIC_MACRO_EEPROM_HEADER, sizeof(header));
+    if (header.magic != DYNAMIC_MACRO_EEPROM_MAGIC || header.used > DYNAMIC_MACRO_BUFFER_SIZE) {
+        dprintln("dynamic macro: no valid macros stored");
+        return;
+    }
+    for (uint8_t i = 0; i < DYNAMIC_MACRO_COUNT; i++) {
+        if (header.slots[i].offset > header.used || header.slots[i].length > header.used - header.slots[i].offset) {
+            return;
+        }
+    }
+
+    eeprom_read_block(macro_buffer, DYNAMIC_MACRO_EEPROM_BUFFER, header.used);
+    memcpy(macro_slots, header.slots, sizeof(macro_slots));
+    macro_buffer_used = header.used;
+}
+
+/* Only the bytes that differ are written, and only when a recording
+ * ends, which keeps the wear on flash backed EEPROM low. The magic is
+ * invalidated while writing, so an interrupted save loses the macros
+ * instead of loading garbage.
+ */
+static void dynamic_macro_save(void) {
+    dynamic_macro_eeprom_header_t header = {.magic = 0xFFFF, .used = macro_buffer_used};
+    memcpy(header.slots, macro_slots, sizeof(macro_slots));
+
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_HEADER, 0xFFFF);
+    eeprom_update_block(macro_buffer, DYNAMIC_MACRO_EEPROM_BUFFER, macro_buffer_used);
+    eeprom_update_block(&header, DYNAMIC_MACRO_EEPROM_HEADER, sizeof(header));
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_HEADER, DYNAMIC_MACRO_EEPROM_MAGIC);
+}
+
+/* Called from eeconfig_init(), so that clearing the EEPROM forgets the
+ * macros as well. Only the magic is invalidated, the rest is left to be
+ * overwritten by the next recording.
+ */
+void eeconfig_init_dynamic_macro(void) {
+    eeprom_update_word(DYNAMIC_MACRO_EEPROM_HEADER, 0xFFFF);
+    dynamic_macro_init();
+}
+#endif
+
+void dynamic_macro_init(void) {
+    macro_buffer_used = 0;
+    for (uint8_t i = 0; i < DYNAMIC_MACRO_COUNT; i++) {
+        macro_slots[i].offset = 0;
+        macro_slots[i].length = 0;
+    }
+    recording_slot = DM_NO_SLOT;
+    play_depth     = 0;
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    dynamic_macro_load();
+#endif
+}
+
+bool dynamic_macro_is_recording(void) {
+    return recording_slot != DM_NO_SLOT;
+}
+
+bool dynamic_macro_is_playing(void) {
+    return play_depth > 0;
+}
+
+uint16_t dynamic_macro_get_length(uint8_t slot) {
+    return slot < DYNAMIC_MACRO_COUNT ? macro_slots[slot].length : 0;
+}
+
+uint16_t dynamic_macro_get_free_space(void) {
+    return DYNAMIC_MACRO_BUFFER_SIZE - macro_buffer_used;
+}
+
+static void dynamic_macro_stop_playing(void) {
+    play_depth = 0;
+    clear_keyboard();
+}
 
 /**
  * Start recording of the dynamic macro.
  *
- * @param[out] macro_pointer The new macro buffer iterator.
- * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
+ * @param[in] slot The macro to record, discarding its previous contents.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer, int8_t direction) {
+void dynamic_macro_record_start(uint8_t slot) {
+    if (slot >= DYNAMIC_MACRO_COUNT || dynamic_macro_is_recording()) {
+        return;
+    }
+
     dprintln("dynamic macro recording: started");
 
-    dynamic_macro_record_start_kb(direction);
+    dynamic_macro_record_start_kb(slot_direction(slot));
 
-    clear_keyboard();
+    // Moving the slots around underneath a playing macro would derail it
+    dynamic_macro_stop_playing();
     layer_clear();
-    *macro_pointer = macro_buffer;
+
+    slot_clear(slot);
+    recording_slot = slot;
 }
 
 /**
- * Play the dynamic macro.
+ * Start playing the dynamic macro. The events are sent from
+ * dynamic_macro_task(), so the keyboard keeps running meanwhile.
  *
- * @param macro_buffer[in] The beginning of the macro buffer being played.
- * @param macro_end[in]    The element after the last macro buffer element.
- * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
+ * @param[in] slot The macro to play.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
-    dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
+void dynamic_macro_play(uint8_t slot) {
+    if (slot >= DYNAMIC_MACRO_COUNT || slot == recording_slot) {
+        return;
+    }
 
-    layer_state_t saved_layer_state = layer_state;
+    for (uint8_t i = 0; i < play_depth; i++) {
+        if (play_stack[i].slot == slot) {
+            dprintln("dynamic macro: ignoring recursive playback");
+            return;
+        }
+    }
+    if (play_depth == DYNAMIC_MACRO_NESTING_DEPTH) {
+        dprintln("dynamic macro: nesting too deep");
+        return;
+    }
+
+    dprintf("dynamic macro: slot %d playback\n", slot + 1);
+
+    play_stack[play_depth++] = (dynamic_macro_frame_t){
+        .slot        = slot,
+        .position    = 0,
+        .layer_state = 0,
+    };
+    play_timer = timer_read32();
+    play_delay = 0;
 
     clear_keyboard();
-    layer_clear();
+}
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
-#ifdef DYNAMIC_MACRO_DELAY
-        wait_ms(DYNAMIC_MACRO_DELAY);
-#endif
-    }
+static void dynamic_macro_play_end(void) {
+    dynamic_macro_frame_t *frame = &play_stack[--play_depth];
 
     clear_keyboard();
 
-    layer_state_set(saved_layer_state);
+    dynamic_macro_play_kb(slot_direction(frame->slot));
+}
+
+/* Replays one event on the layers the macro has set up, then hands the
+ * user's layers back, so that keys pressed while a long macro plays in
+ * the background aren't resolved on the macro's layers.
+ */
+static void dynamic_macro_replay_event(dynamic_macro_frame_t *frame, keyrecord_t *record) {
+    layer_state_t user_layer_state = layer_state;
+
+    if (layer_state != frame->layer_state) {
+        layer_state_set(frame->layer_state);
+    }
+    process_record(record);
+    frame->layer_state = layer_state;
+    if (layer_state != user_layer_state) {
+        layer_state_set(user_layer_state);
+    }
+}
+
+void dynamic_macro_task(void) {
+    while (play_depth > 0) {
+        dynamic_macro_frame_t *frame = &play_stack[play_depth - 1];
+        dynamic_macro_slot_t  *macro = &macro_slots[frame->slot];
+
+        if (frame->position >= macro->length) {
+            dynamic_macro_play_end();
+            continue;
+        }
+
+        keyrecord_t record;
+        uint16_t    delay;
+        uint8_t     size = decode_event(&macro_buffer[macro->offset + frame->position], &record, &delay);
+
+#if defined(DYNAMIC_MACRO_KEEP_TIMING)
+        play_delay = (uint32_t)delay * DYNAMIC_MACRO_TIME_UNIT;
+#elif defined(DYNAMIC_MACRO_DELAY)
+        play_delay = frame->position > 0 ? DYNAMIC_MACRO_DELAY : 0;
+#endif
+        if (timer_elapsed32(play_timer) < play_delay) {
+            return;
+        }
+        play_timer = timer_read32();
+
+        frame->position += size;
+        dynamic_macro_replay_event(frame, &record);
 
-    dynamic_macro_play_kb(direction);
+        // One event per call, the rest of the keyboard gets to run in between
+        return;
+    }
 }
 
 /**
  * Record a single key in a dynamic macro.
  *
- * @param macro_buffer[in] The start of the used macro buffer.
- * @param macro_pointer[in,out] The current buffer position.
- * @param macro2_end[in] The end of the other macro.
- * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
- * @param record[in]     The current keypress.
+ * @param record[in] The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+static void dynamic_macro_record_key(keyrecord_t *record) {
+    dynamic_macro_slot_t *macro = &macro_slots[recording_slot];
+
     /* If we've just started recording, ignore all the key releases. */
-    if (!record->event.pressed && *macro_pointer == macro_buffer) {
+    if (!record->event.pressed && macro->length == 0) {
         dprintln("dynamic macro: ignoring a leading key-up event");
         return;
     }
 
-    /* The other end of the other macro is the last buffer element it
-     * is safe to use before overwriting the other macro.
+    uint16_t delay = 0;
+    if (macro->length > 0) {
+        delay = (TIMER_DIFF_16(record->event.time, recording_last_time) + DYNAMIC_MACRO_TIME_UNIT / 2) / DYNAMIC_MACRO_TIME_UNIT;
+    }
+
+    /* The macro being recorded always sits at the end of the buffer,
+     * so it can grow until the buffer is full.
      */
-    if (*macro_pointer - direction != macro2_end) {
-        **macro_pointer = *record;
-        *macro_pointer += direction;
+    uint8_t event[DM_MAX_EVENT_SIZE];
+    uint8_t size = encode_event(event, record, delay);
+    if (size <= DYNAMIC_MACRO_BUFFER_SIZE - macro_buffer_used) {
+        memcpy(&macro_buffer[macro_buffer_used], event, size);
+        macro_buffer_used += size;
+        macro->length += size;
+        recording_last_time = record->event.time;
     }
-    dynamic_macro_record_key_kb(direction, record);
+    dynamic_macro_record_key_kb(slot_direction(recording_slot), record);
 
-    dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
+    dprintf("dynamic macro: slot %d length: %d bytes, %d free\n", recording_slot + 1, macro->length, dynamic_macro_get_free_space());
 }
 
 /**
- * End recording of the dynamic macro. Essentially just update the
- * pointer to the end of the macro.
+ * End recording of the dynamic macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
-    dynamic_macro_record_end_kb(direction);
+void dynamic_macro_stop_recording(void) {
+    if (!dynamic_macro_is_recording()) {
+        return;
+    }
+
+    dynamic_macro_slot_t *macro = &macro_slots[recording_slot];
+
+    dynamic_macro_record_end_kb(slot_direction(recording_slot));
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DM_RSTP is on.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    uint16_t length = 0;
+    for (uint16_t position = 0; position < macro->length; position += event_size(&macro_buffer[macro->offset + position])) {
+        if (!(macro_buffer[macro->offset + position] & DM_HEADER_PRESSED)) {
+            length = position + event_size(&macro_buffer[macro->offset + position]);
+        }
+    }
+    if (length < macro->length) {
+        dprintln("dynamic macro: trimming trailing key-down events");
+        macro_buffer_used -= macro->length - length;
+        macro->length = length;
     }
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
-
-    *macro_end = macro_pointer;
-}
-
-/* Both macros use the same buffer but read/write on different
- * ends of it.
- *
- * Macro1 is written left-to-right starting from the beginning of
- * the buffer.
- *
- * Macro2 is written right-to-left starting from the end of the
- * buffer.
- *
- * &macro_buffer   macro_end
- *  v                   v
- * +------------------------------------------------------------+
- * |>>>>>> MACRO1 >>>>>>      <<<<<<<<<<<<< MACRO2 <<<<<<<<<<<<<|
- * +------------------------------------------------------------+
- *                           ^                                 ^
- *                         r_macro_end                  r_macro_buffer
- *
- * During the recording when one macro encounters the end of the
- * other macro, the recording is stopped. Apart from this, there
- * are no arbitrary limits for the macros' length in relation to
- * each other: for example one can either have two medium sized
- * macros or one long macro and one short macro. Or even one empty
- * and one using the whole buffer.
- */
-static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
-
-/* Pointer to the first buffer element after the first macro.
- * Initially points to the very beginning of the buffer since the
- * macro is empty. */
-static keyrecord_t *macro_end = macro_buffer;
-
-/* The other end of the macro buffer. Serves as the beginning of
- * the second macro. */
-static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* Like macro_end but for the second macro. */
-static keyrecord_t *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
-
-/* A persistent pointer to the current macro position (iterator)
- * used during the recording. */
-static keyrecord_t *macro_pointer = NULL;
+    dprintf("dynamic macro: slot %d saved, length: %d bytes\n", recording_slot + 1, macro->length);
 
-/* 0   - no macro is being recorded right now
- * 1,2 - either macro 1 or 2 is being recorded */
-static uint8_t macro_id = 0;
+    recording_slot = DM_NO_SLOT;
 
-/**
- * If a dynamic macro is currently being recorded, stop recording.
- */
-void dynamic_macro_stop_recording(void) {
-    switch (macro_id) {
-        case 1:
-            dynamic_macro_record_end(macro_buffer, macro_pointer, +1, &macro_end);
-            break;
-        case 2:
-            dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
-            break;
-    }
-    macro_id = 0;
+#ifdef DYNAMIC_MACRO_EEPROM_STORAGE
+    dynamic_macro_save();
+#endif
 }
 
 /* Handle the key events related to the dynamic macros.
  */
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
-    if (macro_id == 0) {
+    if (!dynamic_macro_is_recording()) {
         /* No macro recording in progress. */
         if (!record->event.pressed) {
             switch (keycode) {
                 case QK_DYNAMIC_MACRO_RECORD_START_1:
-                    dynamic_macro_record_start(&macro_pointer, macro_buffer, +1);
-                    macro_id = 1;
+                    dynamic_macro_record_start(0);
                     return false;
                 case QK_DYNAMIC_MACRO_RECORD_START_2:
-                    dynamic_macro_record_start(&macro_pointer, r_macro_buffer, -1);
-                    macro_id = 2;
+                    dynamic_macro_record_start(1);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_1:
-                    dynamic_macro_play(macro_buffer, macro_end, +1);
+                    dynamic_macro_play(0);
                     return false;
                 case QK_DYNAMIC_MACRO_PLAY_2:
-                    dynamic_macro_play(r_macro_buffer, r_macro_end, -1);
+                    dynamic_macro_play(1);
                     return false;
             }
         }
@@ -289,14 +614,7 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
             default:
                 if (dynamic_macro_valid_key_kb(keycode, record)) {
                     /* Store the key in the macro buffer and process it normally. */
-                    switch (macro_id) {
-                        case 1:
-                            dynamic_macro_record_key(macro_buffer, &macro_pointer, r_macro_end, +1, record);
-                            break;
-                        case 2:
-                            dynamic_macro_record_key(r_macro_buffer, &macro_pointer, macro_end, -1, record);
-                            break;
-                    }
+                    dynamic_macro_record_key(record);
                 }
                 return true;
                 break;
@@ -22,21 +22,53 @@
 #include <stdbool.h>
 #include "action.h"
 
-/* May be overridden with a custom value. Be aware that the effective
- * macro length is half of this value: each keypress is recorded twice
- * because of the down-event and up-event. This is not a bug, it's the
- * intended behavior.
- *
- * Usually it should be fine to set the macro size to at least 256 but
- * there have been reports of it being too much in some users' cases,
- * so 128 is considered a safe default.
+/* Number of macro slots. The first two are bound to the DM_REC1/DM_PLY1
+ * and DM_REC2/DM_PLY2 keycodes, any further slots can be recorded and
+ * played from keymap code.
+ */
+#ifndef DYNAMIC_MACRO_COUNT
+#    define DYNAMIC_MACRO_COUNT 2
+#endif
+
+/* Legacy sizing, in events. Only used to derive the default of
+ * DYNAMIC_MACRO_BUFFER_SIZE, so that existing configurations keep
+ * their RAM footprint.
  */
 #ifndef DYNAMIC_MACRO_SIZE
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* Size in bytes of the buffer shared by all macros. Most events take
+ * two bytes (three on boards with more than 256 keys), so this fits
+ * several times as many events as DYNAMIC_MACRO_SIZE did.
+ */
+#ifndef DYNAMIC_MACRO_BUFFER_SIZE
+#    define DYNAMIC_MACRO_BUFFER_SIZE (DYNAMIC_MACRO_SIZE * sizeof(keyrecord_t))
+#endif
+
+/* Resolution of the delays stored with each event, in milliseconds.
+ * Only used for playback with DYNAMIC_MACRO_KEEP_TIMING.
+ */
+#ifndef DYNAMIC_MACRO_TIME_UNIT
+#    define DYNAMIC_MACRO_TIME_UNIT 8
+#endif
+
+/* How many macros playing other macros can be active at once.
+ */
+#ifndef DYNAMIC_MACRO_NESTING_DEPTH
+#    define DYNAMIC_MACRO_NESTING_DEPTH 4
+#endif
+
+void dynamic_macro_init(void);
+void dynamic_macro_task(void);
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
+void dynamic_macro_record_start(uint8_t slot);
+void dynamic_macro_play(uint8_t slot);
+bool dynamic_macro_is_recording(void);
+bool dynamic_macro_is_playing(void);
+uint16_t dynamic_macro_get_length(uint8_t slot);
+uint16_t dynamic_macro_get_free_space(void);
 bool dynamic_macro_record_start_kb(int8_t direction);
 bool dynamic_macro_record_start_user(int8_t direction);
 bool dynamic_macro_play_kb(int8_t direction);
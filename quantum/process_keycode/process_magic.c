@@ -33,10 +33,10 @@
 #    ifndef CG_SWAP_SONG
 #        define CG_SWAP_SONG SONG(AG_SWAP_SOUND)
 #    endif
-float ag_norm_song[][2] = AG_NORM_SONG;
-float ag_swap_song[][2] = AG_SWAP_SONG;
-float cg_norm_song[][2] = CG_NORM_SONG;
-float cg_swap_song[][2] = CG_SWAP_SONG;
+const audio_compact_note_t ag_norm_song[] PROGMEM = AG_NORM_SONG;
+const audio_compact_note_t ag_swap_song[] PROGMEM = AG_SWAP_SONG;
+const audio_compact_note_t cg_norm_song[] PROGMEM = CG_NORM_SONG;
+const audio_compact_note_t cg_swap_song[] PROGMEM = CG_SWAP_SONG;
 #endif
 
 /**
@@ -86,13 +86,13 @@ bool process_magic(uint16_t keycode, keyrecord_t *record) {
                 case QK_MAGIC_SWAP_ALT_GUI:
                     keymap_config.swap_lalt_lgui = keymap_config.swap_ralt_rgui = true;
 #ifdef AUDIO_ENABLE
-                    PLAY_SONG(ag_swap_song);
+                    PLAY_COMPACT_SONG(ag_swap_song);
 #endif
                     break;
                 case QK_MAGIC_SWAP_CTL_GUI:
                     keymap_config.swap_lctl_lgui = keymap_config.swap_rctl_rgui = true;
 #ifdef AUDIO_ENABLE
-                    PLAY_SONG(cg_swap_song);
+                    PLAY_COMPACT_SONG(cg_swap_song);
 #endif
                     break;
                 case QK_MAGIC_UNSWAP_CONTROL_CAPS_LOCK:
@@ -132,13 +132,13 @@ bool process_magic(uint16_t keycode, keyrecord_t *record) {
                 case QK_MAGIC_UNSWAP_ALT_GUI:
                     keymap_config.swap_lalt_lgui = keymap_config.swap_ralt_rgui = false;
 #ifdef AUDIO_ENABLE
-                    PLAY_SONG(ag_norm_song);
+                    PLAY_COMPACT_SONG(ag_norm_song);
 #endif
                     break;
                 case QK_MAGIC_UNSWAP_CTL_GUI:
                     keymap_config.swap_lctl_lgui = keymap_config.swap_rctl_rgui = false;
 #ifdef AUDIO_ENABLE
-                    PLAY_SONG(cg_norm_song);
+                    PLAY_COMPACT_SONG(cg_norm_song);
 #endif
                     break;
                 case QK_MAGIC_TOGGLE_ALT_GUI:
@@ -146,9 +146,9 @@ bool process_magic(uint16_t keycode, keyrecord_t *record) {
                     keymap_config.swap_ralt_rgui = keymap_config.swap_lalt_lgui;
 #ifdef AUDIO_ENABLE
                     if (keymap_config.swap_ralt_rgui) {
-                        PLAY_SONG(ag_swap_song);
+                        PLAY_COMPACT_SONG(ag_swap_song);
                     } else {
-                        PLAY_SONG(ag_norm_song);
+                        PLAY_COMPACT_SONG(ag_norm_song);
                     }
 #endif
                     break;
@@ -157,9 +157,9 @@ bool process_magic(uint16_t keycode, keyrecord_t *record) {
                     keymap_config.swap_rctl_rgui = keymap_config.swap_lctl_lgui;
 #ifdef AUDIO_ENABLE
                     if (keymap_config.swap_rctl_rgui) {
-                        PLAY_SONG(cg_swap_song);
+                        PLAY_COMPACT_SONG(cg_swap_song);
                     } else {
-                        PLAY_SONG(cg_norm_song);
+                        PLAY_COMPACT_SONG(cg_norm_song);
                     }
 #endif
                     break;
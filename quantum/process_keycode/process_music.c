@@ -68,11 +68,11 @@ static uint16_t music_sequence_interval = 100;
 #        ifndef MAJOR_SONG
 #            define MAJOR_SONG SONG(MAJOR_SOUND)
 #        endif
-float music_mode_songs[NUMBER_OF_MODES][5][2] = {CHROMATIC_SONG, GUITAR_SONG, VIOLIN_SONG, MAJOR_SONG};
-float music_on_song[][2]                      = MUSIC_ON_SONG;
-float music_off_song[][2]                     = MUSIC_OFF_SONG;
-float midi_on_song[][2]                       = MIDI_ON_SONG;
-float midi_off_song[][2]                      = MIDI_OFF_SONG;
+float music_mode_songs[NUMBER_OF_MODES][5][2]       = {CHROMATIC_SONG, GUITAR_SONG, VIOLIN_SONG, MAJOR_SONG};
+const audio_compact_note_t music_on_song[] PROGMEM  = MUSIC_ON_SONG;
+const audio_compact_note_t music_off_song[] PROGMEM = MUSIC_OFF_SONG;
+const audio_compact_note_t midi_on_song[] PROGMEM   = MIDI_ON_SONG;
+const audio_compact_note_t midi_off_song[] PROGMEM  = MIDI_OFF_SONG;
 #    endif
 
 static void music_noteon(uint8_t note) {
@@ -255,7 +255,7 @@ void music_toggle(void) {
 void music_on(void) {
     music_activated = 1;
 #    ifdef AUDIO_ENABLE
-    PLAY_SONG(music_on_song);
+    PLAY_COMPACT_SONG(music_on_song);
 #    endif
     music_on_user();
 }
@@ -264,7 +264,7 @@ void music_off(void) {
     music_all_notes_off();
     music_activated = 0;
 #    ifdef AUDIO_ENABLE
-    PLAY_SONG(music_off_song);
+    PLAY_COMPACT_SONG(music_off_song);
 #    endif
 }
 
@@ -283,7 +283,7 @@ void midi_toggle(void) {
 void midi_on(void) {
     midi_activated = 1;
 #    ifdef AUDIO_ENABLE
-    PLAY_SONG(midi_on_song);
+    PLAY_COMPACT_SONG(midi_on_song);
 #    endif
     midi_on_user();
 }
@@ -294,7 +294,7 @@ void midi_off(void) {
 #    endif
     midi_activated = 0;
 #    ifdef AUDIO_ENABLE
-    PLAY_SONG(midi_off_song);
+    PLAY_COMPACT_SONG(midi_off_song);
 #    endif
 }
 
@@ -88,7 +88,7 @@
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
 #    endif
-float goodbye_song[][2] = GOODBYE_SONG;
+const audio_compact_note_t goodbye_song[] PROGMEM = GOODBYE_SONG;
 #    ifdef DEFAULT_LAYER_SONGS
 float default_layer_songs[][16][2] = DEFAULT_LAYER_SONGS;
 #    endif
@@ -216,7 +216,7 @@ void shutdown_quantum(bool jump_to_bootloader) {
     music_all_notes_off();
 #    endif
     uint16_t timer_start = timer_read();
-    PLAY_SONG(goodbye_song);
+    PLAY_COMPACT_SONG(goodbye_song);
     shutdown_modules(jump_to_bootloader);
     shutdown_kb(jump_to_bootloader);
     while (timer_elapsed(timer_start) < 250)
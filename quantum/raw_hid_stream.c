@@ -0,0 +1,174 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "raw_hid_stream.h"
+#include "raw_hid.h"
+#include "util.h"
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
+
+static struct {
+    raw_hid_stream_source_t source;
+    uint32_t                offset;
+    uint32_t                remaining;
+    uint8_t                 report_size;
+    uint8_t                 sequence; // Sequence number of the next data report
+    uint8_t                 acked;    // Sequence number of the first unacknowledged data report
+    uint8_t                 window;
+    bool                    active;
+} stream;
+
+static uint8_t report[RAW_HID_STREAM_MAX_REPORT_SIZE];
+
+__attribute__((weak)) bool raw_hid_stream_get_source_user(uint8_t id, raw_hid_stream_source_t *source) {
+    return false;
+}
+
+__attribute__((weak)) bool raw_hid_stream_get_source_kb(uint8_t id, raw_hid_stream_source_t *source) {
+    return raw_hid_stream_get_source_user(id, source);
+}
+
+#ifdef DYNAMIC_KEYMAP_ENABLE
+static void read_keymap(uint32_t offset, uint8_t size, uint8_t *data) {
+    dynamic_keymap_get_buffer(offset, size, data);
+}
+
+static void read_macros(uint32_t offset, uint8_t size, uint8_t *data) {
+    dynamic_keymap_macro_get_buffer(offset, size, data);
+}
+#endif
+
+static bool get_source(uint8_t id, raw_hid_stream_source_t *source) {
+    switch (id) {
+#ifdef DYNAMIC_KEYMAP_ENABLE
+        case RAW_HID_STREAM_SOURCE_KEYMAP:
+            source->size = dynamic_keymap_get_layer_count() * MATRIX_ROWS * MATRIX_COLS * 2;
+            source->read = read_keymap;
+            return true;
+        case RAW_HID_STREAM_SOURCE_MACROS:
+            source->size = dynamic_keymap_macro_get_buffer_size();
+            source->read = read_macros;
+            return true;
+#endif
+        default:
+            return id >= RAW_HID_STREAM_SOURCE_KB && raw_hid_stream_get_source_kb(id, source);
+    }
+}
+
+static void send_error(uint8_t report_size, uint8_t status) {
+    memset(report, 0, report_size);
+    report[0] = RAW_HID_STREAM_COMMAND_ID;
+    report[1] = RAW_HID_STREAM_OP_DATA;
+    report[2] = 0;
+    report[3] = RAW_HID_STREAM_FLAG_END | RAW_HID_STREAM_FLAG_ERROR;
+    report[5] = status;
+    raw_hid_send(report, report_size);
+}
+
+static void handle_info(uint8_t *data, uint8_t length) {
+    raw_hid_stream_source_t source;
+    bool                    found = get_source(data[2], &source);
+
+    data[3] = found ? RAW_HID_STREAM_STATUS_OK : RAW_HID_STREAM_STATUS_UNKNOWN_SOURCE;
+    raw_hid_stream_write_u32(&data[4], found ? source.size : 0);
+    data[8] = RAW_HID_STREAM_PAYLOAD_SIZE(length);
+    data[9] = RAW_HID_STREAM_MAX_WINDOW;
+    raw_hid_send(data, length);
+}
+
+static void handle_read(uint8_t *data, uint8_t length) {
+    uint32_t offset = raw_hid_stream_read_u32(&data[3]);
+    uint32_t size   = raw_hid_stream_read_u32(&data[7]);
+
+    // A new read replaces any transfer in progress, so a host that went away mid-transfer can't wedge the stream
+    stream.active = false;
+
+    if (!get_source(data[2], &stream.source)) {
+        send_error(length, RAW_HID_STREAM_STATUS_UNKNOWN_SOURCE);
+        return;
+    }
+    if (offset > stream.source.size || size > stream.source.size - offset) {
+        send_error(length, RAW_HID_STREAM_STATUS_OUT_OF_RANGE);
+        return;
+    }
+
+    stream.offset      = offset;
+    stream.remaining   = size;
+    stream.report_size = length;
+    stream.sequence    = 0;
+    stream.acked       = 0;
+    stream.window      = MIN(data[11], RAW_HID_STREAM_MAX_WINDOW);
+    stream.active      = true;
+}
+
+static void handle_ack(uint8_t sequence) {
+    uint8_t acked     = sequence + 1;
+    uint8_t in_flight = stream.sequence - stream.acked;
+
+    // Stale or bogus acknowledgements must not move the window backwards, or past what has been sent
+    if ((uint8_t)(acked - stream.acked) <= in_flight) {
+        stream.acked = acked;
+    }
+}
+
+bool raw_hid_stream_receive(uint8_t *data, uint8_t length) {
+    if (data[0] != RAW_HID_STREAM_COMMAND_ID || length < RAW_HID_STREAM_MIN_REPORT_SIZE || length > RAW_HID_STREAM_MAX_REPORT_SIZE) {
+        return false;
+    }
+
+    switch (data[1]) {
+        case RAW_HID_STREAM_OP_INFO:
+            handle_info(data, length);
+            break;
+        case RAW_HID_STREAM_OP_READ:
+            handle_read(data, length);
+            break;
+        case RAW_HID_STREAM_OP_ACK:
+            handle_ack(data[2]);
+            break;
+        case RAW_HID_STREAM_OP_ABORT:
+            stream.active = false;
+            break;
+        default:
+            // Unknown operations are consumed as well, the command ID is reserved
+            break;
+    }
+    return true;
+}
+
+bool raw_hid_stream_is_active(void) {
+    return stream.active;
+}
+
+void raw_hid_stream_task(void) {
+    while (stream.active) {
+        if (stream.window && (uint8_t)(stream.sequence - stream.acked) >= stream.window) {
+            return;
+        }
+        if (!raw_hid_send_ready()) {
+            return;
+        }
+
+        uint8_t chunk = MIN(stream.remaining, RAW_HID_STREAM_PAYLOAD_SIZE(stream.report_size));
+
+        memset(report, 0, stream.report_size);
+        report[0] = RAW_HID_STREAM_COMMAND_ID;
+        report[1] = RAW_HID_STREAM_OP_DATA;
+        report[2] = stream.sequence;
+        report[3] = chunk == stream.remaining ? RAW_HID_STREAM_FLAG_END : 0;
+        report[4] = chunk;
+        if (chunk) {
+            stream.source.read(stream.offset, chunk, &report[RAW_HID_STREAM_HEADER_SIZE]);
+        }
+        raw_hid_send(report, stream.report_size);
+
+        stream.sequence++;
+        stream.offset += chunk;
+        stream.remaining -= chunk;
+        if (stream.remaining == 0) {
+            stream.active = false;
+        }
+    }
+}
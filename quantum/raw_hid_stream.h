@@ -0,0 +1,214 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * \file
+ *
+ * \defgroup raw_hid_stream Raw HID Streaming
+ *
+ * Windowed bulk reads over the Raw HID interface. The host issues a single
+ * read request, and the keyboard answers with a run of data reports without
+ * waiting for a reply to each one -- the host only acknowledges every half
+ * window, if at all. Requests are identified by their first byte, so they can share the
+ * interface with VIA or any other protocol built on `raw_hid_receive()`.
+ *
+ * The framing section of this header has no dependencies on the rest of QMK,
+ * so host tools written in C can include it directly.
+ * \{
+ */
+
+// First byte of every streaming report, must not collide with the other commands sent over the interface
+#ifndef RAW_HID_STREAM_COMMAND_ID
+#    define RAW_HID_STREAM_COMMAND_ID 0xF0
+#endif
+
+// Upper bound for the window requested by the host, the sequence number wraps at 256
+#ifndef RAW_HID_STREAM_MAX_WINDOW
+#    define RAW_HID_STREAM_MAX_WINDOW 64
+#endif
+
+#define RAW_HID_STREAM_MIN_REPORT_SIZE 16
+#define RAW_HID_STREAM_MAX_REPORT_SIZE 64
+#define RAW_HID_STREAM_HEADER_SIZE 5
+#define RAW_HID_STREAM_PAYLOAD_SIZE(report_size) ((report_size) - RAW_HID_STREAM_HEADER_SIZE)
+
+enum raw_hid_stream_op {
+    RAW_HID_STREAM_OP_INFO  = 0x01, // host: [source], keyboard: [source, status, size (4), payload size, max window]
+    RAW_HID_STREAM_OP_READ  = 0x02, // host: [source, offset (4), length (4), window]
+    RAW_HID_STREAM_OP_ACK   = 0x03, // host: [sequence of the last data report received]
+    RAW_HID_STREAM_OP_ABORT = 0x04, // host: []
+    RAW_HID_STREAM_OP_DATA  = 0x80, // keyboard: [sequence, flags, length, payload...], or [sequence, flags, 0, status] on error
+};
+
+enum raw_hid_stream_flags {
+    RAW_HID_STREAM_FLAG_END   = (1 << 0), // Last report of the transfer
+    RAW_HID_STREAM_FLAG_ERROR = (1 << 1), // Transfer failed, no payload
+};
+
+enum raw_hid_stream_status {
+    RAW_HID_STREAM_STATUS_OK             = 0x00,
+    RAW_HID_STREAM_STATUS_UNKNOWN_SOURCE = 0x01,
+    RAW_HID_STREAM_STATUS_OUT_OF_RANGE   = 0x02,
+};
+
+enum raw_hid_stream_source_id {
+    RAW_HID_STREAM_SOURCE_KEYMAP = 0x00, // Dynamic keymap, same layout as the VIA keymap buffer
+    RAW_HID_STREAM_SOURCE_MACROS = 0x01, // Dynamic macro buffer
+    RAW_HID_STREAM_SOURCE_KB     = 0x80, // First ID available to keyboard and user code
+};
+
+static inline void raw_hid_stream_write_u32(uint8_t *data, uint32_t value) {
+    data[0] = (value >> 24) & 0xFF;
+    data[1] = (value >> 16) & 0xFF;
+    data[2] = (value >> 8) & 0xFF;
+    data[3] = value & 0xFF;
+}
+
+static inline uint32_t raw_hid_stream_read_u32(const uint8_t *data) {
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+}
+
+/**
+ * \brief Build a read request.
+ *
+ * \param report The report buffer to fill, `report_size` bytes long.
+ * \param report_size The Raw HID report size of the keyboard.
+ * \param source The ID of the data source to read from.
+ * \param offset The offset within the source to start reading at.
+ * \param length The number of bytes to read.
+ * \param window The number of data reports the keyboard may send before waiting for an acknowledgement, or 0 to send everything without waiting.
+ */
+static inline void raw_hid_stream_build_read(uint8_t *report, uint8_t report_size, uint8_t source, uint32_t offset, uint32_t length, uint8_t window) {
+    memset(report, 0, report_size);
+    report[0] = RAW_HID_STREAM_COMMAND_ID;
+    report[1] = RAW_HID_STREAM_OP_READ;
+    report[2] = source;
+    raw_hid_stream_write_u32(&report[3], offset);
+    raw_hid_stream_write_u32(&report[7], length);
+    report[11] = window;
+}
+
+/**
+ * \brief Host side state of a read in progress.
+ */
+typedef struct {
+    uint32_t remaining;     // Bytes still expected
+    uint8_t  next_sequence; // Sequence number of the next expected data report
+    uint8_t  window;        // Window requested in the read, 0 if unacknowledged
+    uint8_t  unacked;       // Data reports received since the last acknowledgement
+} raw_hid_stream_reader_t;
+
+typedef enum {
+    RAW_HID_STREAM_READER_IGNORED, // Not a data report, hand it to the rest of the application
+    RAW_HID_STREAM_READER_DATA,    // Payload received, more to come
+    RAW_HID_STREAM_READER_ACK,     // Payload received, send an acknowledgement before reading further
+    RAW_HID_STREAM_READER_DONE,    // Payload received, transfer complete
+    RAW_HID_STREAM_READER_ERROR,   // Keyboard aborted, or a report was lost
+} raw_hid_stream_reader_result_t;
+
+static inline void raw_hid_stream_reader_init(raw_hid_stream_reader_t *reader, uint32_t length, uint8_t window) {
+    reader->remaining     = length;
+    reader->next_sequence = 0;
+    reader->window        = window;
+    reader->unacked       = 0;
+}
+
+/**
+ * \brief Feed a report received from the keyboard into a reader.
+ *
+ * \param reader The reader state, initialised with `raw_hid_stream_reader_init()` when the read was requested.
+ * \param report The received report.
+ * \param report_size The Raw HID report size of the keyboard.
+ * \param payload Set to the start of the payload within `report`.
+ * \param payload_length Set to the number of payload bytes.
+ *
+ * \return What the host should do next.
+ */
+static inline raw_hid_stream_reader_result_t raw_hid_stream_reader_feed(raw_hid_stream_reader_t *reader, const uint8_t *report, uint8_t report_size, const uint8_t **payload, uint8_t *payload_length) {
+    if (report[0] != RAW_HID_STREAM_COMMAND_ID || report[1] != RAW_HID_STREAM_OP_DATA) {
+        return RAW_HID_STREAM_READER_IGNORED;
+    }
+
+    uint8_t length = report[4];
+    if ((report[3] & RAW_HID_STREAM_FLAG_ERROR) || report[2] != reader->next_sequence || length > RAW_HID_STREAM_PAYLOAD_SIZE(report_size) || length > reader->remaining) {
+        return RAW_HID_STREAM_READER_ERROR;
+    }
+
+    *payload        = &report[RAW_HID_STREAM_HEADER_SIZE];
+    *payload_length = length;
+    reader->next_sequence++;
+    reader->remaining -= length;
+
+    if (reader->remaining == 0 || (report[3] & RAW_HID_STREAM_FLAG_END)) {
+        return RAW_HID_STREAM_READER_DONE;
+    }
+    // Acknowledging halfway through the window keeps the keyboard sending while the acknowledgement is in flight
+    if (reader->window && ++reader->unacked >= (reader->window + 1) / 2) {
+        reader->unacked = 0;
+        return RAW_HID_STREAM_READER_ACK;
+    }
+    return RAW_HID_STREAM_READER_DATA;
+}
+
+/**
+ * \brief Build the acknowledgement for the last data report fed into a reader.
+ */
+static inline void raw_hid_stream_reader_build_ack(const raw_hid_stream_reader_t *reader, uint8_t *report, uint8_t report_size) {
+    memset(report, 0, report_size);
+    report[0] = RAW_HID_STREAM_COMMAND_ID;
+    report[1] = RAW_HID_STREAM_OP_ACK;
+    report[2] = reader->next_sequence - 1;
+}
+
+/* ---------------------------------------------------------------------------
+ * Keyboard side
+ */
+
+#if defined(RAW_HID_STREAM_ENABLE) || defined(__DOXYGEN__)
+
+/**
+ * \brief Reads `size` bytes at `offset` from a source into `data`.
+ */
+typedef void (*raw_hid_stream_read_t)(uint32_t offset, uint8_t size, uint8_t *data);
+
+typedef struct {
+    uint32_t              size;
+    raw_hid_stream_read_t read;
+} raw_hid_stream_source_t;
+
+/**
+ * \brief Handle a streaming request received from the host.
+ *
+ * Called by VIA before it processes a report. Without VIA, call this at the start of `raw_hid_receive()`.
+ *
+ * \return `true` if the report was a streaming request and has been consumed.
+ */
+bool raw_hid_stream_receive(uint8_t *data, uint8_t length);
+
+/**
+ * \brief Send the pending data reports of the current transfer, as far as the endpoint has room for them.
+ */
+void raw_hid_stream_task(void);
+
+/**
+ * \brief Whether a transfer is in progress.
+ */
+bool raw_hid_stream_is_active(void);
+
+/**
+ * \brief Look up a keyboard defined data source, with an ID of `RAW_HID_STREAM_SOURCE_KB` or above.
+ *
+ * \return `true` if `source` has been filled in.
+ */
+bool raw_hid_stream_get_source_kb(uint8_t id, raw_hid_stream_source_t *source);
+bool raw_hid_stream_get_source_user(uint8_t id, raw_hid_stream_source_t *source);
+
+#endif
+
+/** \} */
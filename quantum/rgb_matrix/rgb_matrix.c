@@ -23,12 +23,33 @@
 #include "keyboard.h"
 #include "sync_timer.h"
 #include "debug.h"
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+#    include "usb_device_state.h"
+#endif
 #include <string.h>
 #include <math.h>
 #include <stdlib.h>
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+#    include <ch.h>
+// Below the main loop, so rendering only ever gets the time the main loop leaves over
+#    ifndef RGB_MATRIX_RENDER_THREAD_PRIORITY
+#        define RGB_MATRIX_RENDER_THREAD_PRIORITY (NORMALPRIO - 1)
+#    endif
+// The indicator callbacks run on the render thread, so leave them some room
+#    ifndef RGB_MATRIX_RENDER_THREAD_STACK_SIZE
+#        define RGB_MATRIX_RENDER_THREAD_STACK_SIZE 1024
+#    endif
+#    ifndef RGB_MATRIX_KEY_EVENT_QUEUE_SIZE
+#        define RGB_MATRIX_KEY_EVENT_QUEUE_SIZE 16
+#    endif
+#    if (RGB_MATRIX_KEY_EVENT_QUEUE_SIZE & (RGB_MATRIX_KEY_EVENT_QUEUE_SIZE - 1)) != 0 || RGB_MATRIX_KEY_EVENT_QUEUE_SIZE > 128
+#        error "RGB_MATRIX_KEY_EVENT_QUEUE_SIZE must be a power of two, up to 128"
+#    endif
+#endif // RGB_MATRIX_RENDER_THREAD_ENABLE
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -39,8 +60,58 @@ __attribute__((weak)) rgb_t rgb_matrix_hsv_to_rgb(hsv_t hsv) {
     return hsv_to_rgb(hsv);
 }
 
-// Generic effect runners
-#include "rgb_matrix_runners.inc"
+// timer, key hit tracker and position tables shared with led matrix
+#define LIGHTING_LED_COUNT RGB_MATRIX_LED_COUNT
+#define LIGHTING_CENTER k_rgb_matrix_center
+#define LIGHTING_TIMER g_rgb_timer
+#define LIGHTING_MAP_ROW_COLUMN_TO_LED rgb_matrix_map_row_column_to_led
+#ifdef RGB_MATRIX_POLAR_TABLE
+#    define LIGHTING_POLAR_TABLE g_rgb_polar_table
+#endif
+#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
+#    define LIGHTING_KEYREACTIVE_ENABLED
+#    if defined(RGB_MATRIX_KEYRELEASES)
+#        define LIGHTING_KEYRELEASES
+#    elif defined(RGB_MATRIX_KEYPRESSES)
+#        define LIGHTING_KEYPRESSES
+#    endif
+#    ifdef RGB_MATRIX_HIT_DISTANCE_TABLE
+#        define LIGHTING_HIT_DISTANCE g_rgb_hit_distance
+#    endif
+#endif
+#define LIGHTING_CONFIG rgb_matrix_config
+#define LIGHTING_TASK_STATES rgb_task_states
+#define LIGHTING_FLUSH_LIMIT rgb_matrix_flush_limit()
+#define LIGHTING_INDICATORS rgb_matrix_indicators
+#define LIGHTING_INDICATORS_ADVANCED rgb_matrix_indicators_advanced
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+#    define LIGHTING_RENDER_THREAD
+#endif
+#define LIGHTING_TASK_EFFECT rgb_task_effect
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+#    define LIGHTING_TASK_START rgb_task_start
+#endif
+#define LIGHTING_TASK_RENDER rgb_task_render
+#define LIGHTING_TASK_FLUSH rgb_task_flush
+#define LIGHTING_TASK_SYNC rgb_task_sync
+static inline uint32_t rgb_matrix_flush_limit(void);
+#include "lighting_matrix_core.inc"
+
+// Generic effect runners shared with led matrix
+static inline void rgb_matrix_set_pixel(uint8_t index, hsv_t hsv) {
+    rgb_t rgb = rgb_matrix_hsv_to_rgb(hsv);
+    rgb_matrix_set_color(index, rgb.r, rgb.g, rgb.b);
+}
+
+#define LIGHTING_PIXEL hsv_t
+#define LIGHTING_PIXEL_BASE rgb_matrix_config.hsv
+#define LIGHTING_PIXEL_VALUE(pixel) (pixel).v
+#define LIGHTING_SET_PIXEL rgb_matrix_set_pixel
+#define LIGHTING_USE_LIMITS RGB_MATRIX_USE_LIMITS
+#define LIGHTING_TEST_LED_FLAGS RGB_MATRIX_TEST_LED_FLAGS
+#define LIGHTING_CHECK_FINISHED_LEDS rgb_matrix_check_finished_leds
+#define LIGHTING_EFFECT_SPEED(speed) qadd8(speed, 1)
+#include "lighting_matrix_runners.inc"
 
 // ------------------------------------------
 // -----Begin rgb effect includes macros-----
@@ -69,19 +140,52 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_POLAR_TABLE
+led_polar_t g_rgb_polar_table[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_POLAR_TABLE
+#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && defined(RGB_MATRIX_HIT_DISTANCE_TABLE)
+uint8_t g_rgb_hit_distance[LED_HITS_TO_REMEMBER][RGB_MATRIX_LED_COUNT];
+#endif
 
 // internals
-static bool            suspend_state     = false;
-static uint8_t         rgb_last_enable   = UINT8_MAX;
-static uint8_t         rgb_last_effect   = UINT8_MAX;
-static effect_params_t rgb_effect_params = {0, LED_FLAG_ALL, false};
-static rgb_task_states rgb_task_state    = SYNCING;
-
-// double buffers
-static uint32_t rgb_timer_buffer;
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-static last_hit_t last_hit_buffer;
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+static bool suspend_state = false;
+
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+#    if RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#        define RGB_MATRIX_GOVERNOR_PROCESS_LIMIT RGB_MATRIX_LED_PROCESS_LIMIT
+#    else
+#        define RGB_MATRIX_GOVERNOR_PROCESS_LIMIT RGB_MATRIX_LED_COUNT
+#    endif
+
+static uint8_t                     governor_level;      // Level the current frame is rendered at
+static uint8_t                     governor_next_level; // Level picked by the governor, applied when the next frame starts
+static uint8_t                     governor_good_windows;
+static uint16_t                    governor_timer;
+static uint32_t                    governor_scans;
+static uint16_t                    governor_frame_start;
+static rgb_matrix_governor_stats_t governor_stats;
+#endif // RGB_MATRIX_GOVERNOR_ENABLE
+
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+// Key events are handed from the main loop to the render thread without locking, the main loop only ever
+// advances the head and the render thread only ever advances the tail
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+    bool    pressed;
+} rgb_key_event_t;
+
+static rgb_key_event_t key_event_queue[RGB_MATRIX_KEY_EVENT_QUEUE_SIZE];
+static uint8_t         key_event_head;
+static uint8_t         key_event_tail;
+
+// Held by the render thread while it renders, and by the main loop while it changes the frame or rgb_matrix_config
+static MUTEX_DECL(rgb_matrix_mutex);
+// Held while a frame is sent to the LED driver
+static MUTEX_DECL(rgb_matrix_driver_mutex);
+static thread_t *rgb_matrix_thread;
+static bool      rgb_matrix_frame_done;
+#endif // RGB_MATRIX_RENDER_THREAD_ENABLE
 
 // split rgb matrix
 #if defined(RGB_MATRIX_SPLIT)
@@ -96,11 +200,13 @@ void eeconfig_update_rgb_matrix(void) {
 
 void eeconfig_update_rgb_matrix_default(void) {
     dprintf("eeconfig_update_rgb_matrix_default\n");
+    rgb_matrix_lock();
     rgb_matrix_config.enable = RGB_MATRIX_DEFAULT_ON;
     rgb_matrix_config.mode   = RGB_MATRIX_DEFAULT_MODE;
     rgb_matrix_config.hsv    = (hsv_t){RGB_MATRIX_DEFAULT_HUE, RGB_MATRIX_DEFAULT_SAT, RGB_MATRIX_DEFAULT_VAL};
     rgb_matrix_config.speed  = RGB_MATRIX_DEFAULT_SPD;
     rgb_matrix_config.flags  = RGB_MATRIX_DEFAULT_FLAGS;
+    rgb_matrix_unlock();
     eeconfig_flush_rgb_matrix(true);
 }
 
@@ -118,7 +224,9 @@ void eeconfig_debug_rgb_matrix(void) {
 void rgb_matrix_reload_from_eeprom(void) {
     rgb_matrix_disable_noeeprom();
     /* Reset back to what we have in eeprom */
+    rgb_matrix_lock();
     eeconfig_init_rgb_matrix();
+    rgb_matrix_unlock();
     eeconfig_debug_rgb_matrix(); // display current eeprom values
     if (rgb_matrix_config.enable) {
         rgb_matrix_mode_noeeprom(rgb_matrix_config.mode);
@@ -139,8 +247,85 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef RGB_MATRIX_WRITE_FRAME
+// Colours of this half's LEDs, handed to the driver in one go when flushing
+static rgb_t rgb_matrix_frame[RGB_MATRIX_LED_COUNT];
+#endif
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+// Copy of the frame being sent to the driver, so that drawing into rgb_matrix_frame can carry on meanwhile
+static rgb_t rgb_matrix_front[RGB_MATRIX_LED_COUNT];
+#endif
+
+void rgb_matrix_lock(void) {
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+    // The render thread already holds it while calling the effects and indicators
+    if (chThdGetSelfX() != rgb_matrix_thread) {
+        chMtxLock(&rgb_matrix_mutex);
+    }
+#endif
+}
+
+void rgb_matrix_unlock(void) {
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+    if (chThdGetSelfX() != rgb_matrix_thread) {
+        chMtxUnlock(&rgb_matrix_mutex);
+    }
+#endif
+}
+
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+__attribute__((weak)) uint16_t rgb_matrix_current_limit(void) {
+#    ifdef SPLIT_KEYBOARD
+    // Only the half connected to the host knows the USB state
+    if (!is_keyboard_master()) {
+        return RGB_MATRIX_CURRENT_LIMIT;
+    }
+#    endif
+    return rgb_current_budget(usb_device_state_get_configure_state(), RGB_MATRIX_CURRENT_LIMIT, RGB_MATRIX_CURRENT_LIMIT_UNCONFIGURED, RGB_MATRIX_CURRENT_LIMIT_SUSPEND);
+}
+#endif
+
+#ifdef RGB_MATRIX_WRITE_FRAME
+static void rgb_matrix_write_frame(const rgb_t *frame) {
+    int count = RGB_MATRIX_LED_COUNT;
+#    if defined(RGB_MATRIX_SPLIT)
+    count = is_keyboard_left() ? k_rgb_matrix_split[0] : k_rgb_matrix_split[1];
+#    endif
+    uint16_t scale = 256;
+#    ifdef RGB_MATRIX_CURRENT_LIMIT
+    scale = rgb_current_scale(frame, count, RGB_MATRIX_CURRENT_RED, RGB_MATRIX_CURRENT_GREEN, RGB_MATRIX_CURRENT_BLUE, rgb_matrix_current_limit());
+#    endif
+    if (scale < 256) {
+        // Dim on the way out, effects only redraw part of the frame per task run so it must keep the full values
+        for (int i = 0; i < count; i++) {
+            rgb_t rgb = rgb_scale(frame[i], scale);
+            rgb_matrix_driver.set_color(i, rgb.r, rgb.g, rgb.b);
+        }
+    } else if (rgb_matrix_driver.write_frame) {
+        rgb_matrix_driver.write_frame(frame, count);
+    } else {
+        for (int i = 0; i < count; i++) {
+            rgb_matrix_driver.set_color(i, frame[i].r, frame[i].g, frame[i].b);
+        }
+    }
+}
+#endif
+
 void rgb_matrix_update_pwm_buffers(void) {
+#if defined(RGB_MATRIX_RENDER_THREAD_ENABLE)
+    chMtxLock(&rgb_matrix_driver_mutex);
+    chMtxLock(&rgb_matrix_mutex);
+    memcpy(rgb_matrix_front, rgb_matrix_frame, sizeof(rgb_matrix_front));
+    chMtxUnlock(&rgb_matrix_mutex);
+    rgb_matrix_write_frame(rgb_matrix_front);
     rgb_matrix_driver.flush();
+    chMtxUnlock(&rgb_matrix_driver_mutex);
+#else
+#    ifdef RGB_MATRIX_WRITE_FRAME
+    rgb_matrix_write_frame(rgb_matrix_frame);
+#    endif
+    rgb_matrix_driver.flush();
+#endif
 }
 
 __attribute__((weak)) int rgb_matrix_led_index(int index) {
@@ -153,11 +338,26 @@ __attribute__((weak)) int rgb_matrix_led_index(int index) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_WRITE_FRAME
+    index = rgb_matrix_led_index(index);
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_matrix_lock();
+        rgb_matrix_frame[index] = (rgb_t){red, green, blue};
+        rgb_matrix_unlock();
+    }
+#else
     rgb_matrix_driver.set_color(rgb_matrix_led_index(index), red, green, blue);
+#endif
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_SPLIT)
+#if defined(RGB_MATRIX_WRITE_FRAME)
+    rgb_matrix_lock();
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_frame[i] = (rgb_t){red, green, blue};
+    }
+    rgb_matrix_unlock();
+#elif defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
@@ -165,41 +365,8 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
 #endif
 }
 
-void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
-#ifndef RGB_MATRIX_SPLIT
-    if (!is_keyboard_master()) return;
-#endif
-
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t led[LED_HITS_TO_REMEMBER];
-    uint8_t led_count = 0;
-
-#    if defined(RGB_MATRIX_KEYRELEASES)
-    if (!pressed)
-#    elif defined(RGB_MATRIX_KEYPRESSES)
-    if (pressed)
-#    endif // defined(RGB_MATRIX_KEYRELEASES)
-    {
-        led_count = rgb_matrix_map_row_column_to_led(row, col, led);
-    }
-
-    if (last_hit_buffer.count + led_count > LED_HITS_TO_REMEMBER) {
-        memcpy(&last_hit_buffer.x[0], &last_hit_buffer.x[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.y[0], &last_hit_buffer.y[led_count], LED_HITS_TO_REMEMBER - led_count);
-        memcpy(&last_hit_buffer.tick[0], &last_hit_buffer.tick[led_count], (LED_HITS_TO_REMEMBER - led_count) * 2); // 16 bit
-        memcpy(&last_hit_buffer.index[0], &last_hit_buffer.index[led_count], LED_HITS_TO_REMEMBER - led_count);
-        last_hit_buffer.count = LED_HITS_TO_REMEMBER - led_count;
-    }
-
-    for (uint8_t i = 0; i < led_count; i++) {
-        uint8_t index                = last_hit_buffer.count;
-        last_hit_buffer.x[index]     = g_led_config.point[led[i]].x;
-        last_hit_buffer.y[index]     = g_led_config.point[led[i]].y;
-        last_hit_buffer.index[index] = led[i];
-        last_hit_buffer.tick[index]  = 0;
-        last_hit_buffer.count++;
-    }
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+static void rgb_task_key_event(uint8_t row, uint8_t col, bool pressed) {
+    lighting_key_event(row, col, pressed);
 
 #if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
 #    if defined(RGB_MATRIX_KEYRELEASES)
@@ -215,6 +382,36 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
 #endif // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
 }
 
+void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed) {
+#ifndef RGB_MATRIX_SPLIT
+    if (!is_keyboard_master()) return;
+#endif
+
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+    uint8_t head = key_event_head;
+    if ((uint8_t)(head - __atomic_load_n(&key_event_tail, __ATOMIC_ACQUIRE)) >= RGB_MATRIX_KEY_EVENT_QUEUE_SIZE) {
+        return; // The render thread is behind, dropping the event only costs an animation
+    }
+    key_event_queue[head % RGB_MATRIX_KEY_EVENT_QUEUE_SIZE] = (rgb_key_event_t){row, col, pressed};
+    __atomic_store_n(&key_event_head, head + 1, __ATOMIC_RELEASE);
+#else
+    rgb_task_key_event(row, col, pressed);
+#endif
+}
+
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+static void rgb_task_key_events(void) {
+    uint8_t tail = key_event_tail;
+    uint8_t head = __atomic_load_n(&key_event_head, __ATOMIC_ACQUIRE);
+    while (tail != head) {
+        rgb_key_event_t *event = &key_event_queue[tail % RGB_MATRIX_KEY_EVENT_QUEUE_SIZE];
+        rgb_task_key_event(event->row, event->col, event->pressed);
+        tail++;
+    }
+    __atomic_store_n(&key_event_tail, tail, __ATOMIC_RELEASE);
+}
+#endif // RGB_MATRIX_RENDER_THREAD_ENABLE
+
 void rgb_matrix_test(void) {
     // Mask out bits 4 and 5
     // Increase the factor to make the test animation slower (and reduce to make it faster)
@@ -248,50 +445,33 @@ static bool rgb_matrix_none(effect_params_t *params) {
     return false;
 }
 
-static void rgb_task_timers(void) {
-#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
-    uint32_t deltaTime = sync_timer_elapsed32(rgb_timer_buffer);
-#endif // defined(RGB_MATRIX_KEYREACTIVE_ENABLED)
-    rgb_timer_buffer = sync_timer_read32();
-
-    // Update double buffer last hit timers
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    uint8_t count = last_hit_buffer.count;
-    for (uint8_t i = 0; i < count; ++i) {
-        if (UINT16_MAX - deltaTime < last_hit_buffer.tick[i]) {
-            last_hit_buffer.count--;
-            continue;
-        }
-        last_hit_buffer.tick[i] += deltaTime;
-    }
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+static inline uint32_t rgb_matrix_flush_limit(void) {
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+    return (uint32_t)RGB_MATRIX_LED_FLUSH_LIMIT << governor_level;
+#else
+    return RGB_MATRIX_LED_FLUSH_LIMIT;
+#endif
 }
 
 static void rgb_task_sync(void) {
+#ifndef RGB_MATRIX_RENDER_THREAD_ENABLE
     eeconfig_flush_rgb_matrix(false);
-    // next task
-    if (sync_timer_elapsed32(g_rgb_timer) >= RGB_MATRIX_LED_FLUSH_LIMIT) rgb_task_state = STARTING;
+#endif
 }
 
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
 static void rgb_task_start(void) {
-    // reset iter
-    rgb_effect_params.iter = 0;
-
-    // update double buffers
-    g_rgb_timer = rgb_timer_buffer;
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker = last_hit_buffer;
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
-
-    // next task
-    rgb_task_state = RENDERING;
+    // The level only changes between frames, so that a frame isn't split into slices of different sizes
+    governor_level       = governor_next_level;
+    governor_stats.level = governor_level;
+    governor_frame_start = timer_read();
 }
+#endif
 
-static void rgb_task_render(uint8_t effect) {
-    bool rendering         = false;
-    rgb_effect_params.init = (effect != rgb_last_effect) || (rgb_matrix_config.enable != rgb_last_enable);
-    if (rgb_effect_params.flags != rgb_matrix_config.flags) {
-        rgb_effect_params.flags = rgb_matrix_config.flags;
+static bool rgb_task_render(uint8_t effect, effect_params_t *params) {
+    bool rendering = false;
+    if (params->flags != rgb_matrix_config.flags) {
+        params->flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
     }
 
@@ -299,22 +479,22 @@ static void rgb_task_render(uint8_t effect) {
     // and/or request PWM buffer updates.
     switch (effect) {
         case RGB_MATRIX_NONE:
-            rendering = rgb_matrix_none(&rgb_effect_params);
+            rendering = rgb_matrix_none(params);
             break;
 
 // ---------------------------------------------
 // -----Begin rgb effect switch case macros-----
-#define RGB_MATRIX_EFFECT(name, ...)          \
-    case RGB_MATRIX_##name:                   \
-        rendering = name(&rgb_effect_params); \
+#define RGB_MATRIX_EFFECT(name, ...) \
+    case RGB_MATRIX_##name:          \
+        rendering = name(params);    \
         break;
 #include "rgb_matrix_effects.inc"
 #undef RGB_MATRIX_EFFECT
 
 #if defined(RGB_MATRIX_CUSTOM_KB) || defined(RGB_MATRIX_CUSTOM_USER)
-#    define RGB_MATRIX_EFFECT(name, ...)          \
-        case RGB_MATRIX_CUSTOM_##name:            \
-            rendering = name(&rgb_effect_params); \
+#    define RGB_MATRIX_EFFECT(name, ...) \
+        case RGB_MATRIX_CUSTOM_##name:   \
+            rendering = name(params);    \
             break;
 #    ifdef RGB_MATRIX_CUSTOM_KB
 #        include "rgb_matrix_kb.inc"
@@ -328,40 +508,27 @@ static void rgb_task_render(uint8_t effect) {
             // ---------------------------------------------
 
         // Factory default magic value
-        case UINT8_MAX: {
+        case UINT8_MAX:
             rgb_matrix_test();
-            rgb_task_state = FLUSHING;
-        }
-            return;
+            break;
     }
 
-    rgb_effect_params.iter++;
-
-    // next task
-    if (!rendering) {
-        rgb_task_state = FLUSHING;
-        if (!rgb_effect_params.init && effect == RGB_MATRIX_NONE) {
-            // We only need to flush once if we are RGB_MATRIX_NONE
-            rgb_task_state = SYNCING;
-        }
-    }
+    return rendering;
 }
 
-static void rgb_task_flush(uint8_t effect) {
-    // update last trackers after the first full render so we can init over several frames
-    rgb_last_effect = effect;
-    rgb_last_enable = rgb_matrix_config.enable;
-
-    // update pwm buffers
+static void rgb_task_flush(void) {
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+    // Sent by the render thread once it has let go of the frame
+    rgb_matrix_frame_done = true;
+#else
     rgb_matrix_update_pwm_buffers();
-
-    // next task
-    rgb_task_state = SYNCING;
+#    ifdef RGB_MATRIX_GOVERNOR_ENABLE
+    governor_stats.frame_time = timer_elapsed(governor_frame_start);
+#    endif
+#endif
 }
 
-void rgb_matrix_task(void) {
-    rgb_task_timers();
-
+static uint8_t rgb_task_effect(void) {
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
     bool suspend_backlight = suspend_state ||
@@ -370,28 +537,97 @@ void rgb_matrix_task(void) {
 #endif // RGB_MATRIX_TIMEOUT > 0
                              false;
 
-    uint8_t effect = suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
+    return suspend_backlight || !rgb_matrix_config.enable ? 0 : rgb_matrix_config.mode;
+}
 
-    switch (rgb_task_state) {
-        case STARTING:
-            rgb_task_start();
-            break;
-        case RENDERING:
-            rgb_task_render(effect);
-            if (effect) {
-                if (rgb_task_state == FLUSHING) { // ensure we only draw basic indicators once rendering is finished
-                    rgb_matrix_indicators();
-                }
-                rgb_matrix_indicators_advanced(&rgb_effect_params);
-            }
-            break;
-        case FLUSHING:
-            rgb_task_flush(effect);
-            break;
-        case SYNCING:
-            rgb_task_sync();
-            break;
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+/**
+ * @brief This thread renders and flushes the frames, so that the main loop carries on
+ * scanning while the LED driver is busy transferring them.
+ */
+static THD_WORKING_AREA(waRGBMatrixThread, RGB_MATRIX_RENDER_THREAD_STACK_SIZE);
+static THD_FUNCTION(RGBMatrixThread, arg) {
+    (void)arg;
+    chRegSetThreadName("rgb_matrix");
+
+    while (true) {
+        chMtxLock(&rgb_matrix_mutex);
+        rgb_task_key_events();
+        lighting_task_step();
+        bool frame_done       = rgb_matrix_frame_done;
+        rgb_matrix_frame_done = false;
+        chMtxUnlock(&rgb_matrix_mutex);
+
+        if (frame_done) {
+            // Sent without holding the frame, so the main loop can keep drawing while the driver is busy
+            rgb_matrix_update_pwm_buffers();
+#    ifdef RGB_MATRIX_GOVERNOR_ENABLE
+            governor_stats.frame_time = timer_elapsed(governor_frame_start);
+#    endif
+        }
+
+        uint32_t elapsed = sync_timer_elapsed32(g_rgb_timer);
+        uint32_t limit   = rgb_matrix_flush_limit();
+        if (lighting_task_state == SYNCING && elapsed < limit) {
+            chThdSleepMilliseconds(limit - elapsed);
+        }
+    }
+}
+#endif // RGB_MATRIX_RENDER_THREAD_ENABLE
+
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+static void rgb_governor_task(void) {
+    governor_scans++;
+
+    uint16_t elapsed = timer_elapsed(governor_timer);
+    if (elapsed < RGB_MATRIX_GOVERNOR_INTERVAL) {
+        return;
+    }
+    governor_stats.scan_rate = governor_scans * 1000 / elapsed;
+    governor_timer           = timer_read();
+    governor_scans           = 0;
+
+    uint8_t level = governor_next_level;
+    if (governor_stats.scan_rate < RGB_MATRIX_GOVERNOR_SCAN_RATE) {
+        governor_good_windows = 0;
+        if (level < RGB_MATRIX_GOVERNOR_MAX_LEVEL) level++;
+    } else if (level > 0 && governor_stats.scan_rate >= RGB_MATRIX_GOVERNOR_SCAN_RATE + RGB_MATRIX_GOVERNOR_SCAN_RATE / 2) {
+        // Only step back up after a run of good windows, rather than flipping between two levels every window
+        if (++governor_good_windows >= 4) {
+            governor_good_windows = 0;
+            level--;
+        }
+    } else {
+        governor_good_windows = 0;
+    }
+
+    if (level != governor_next_level) {
+        governor_next_level = level;
+        dprintf("rgb matrix governor: %lu scans/s, frame %u ms, level %u\n", (unsigned long)governor_stats.scan_rate, governor_stats.frame_time, level);
+    }
+}
+
+rgb_matrix_governor_stats_t rgb_matrix_governor_get_stats(void) {
+    return governor_stats;
+}
+#endif // RGB_MATRIX_GOVERNOR_ENABLE
+
+void rgb_matrix_task(void) {
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+    rgb_governor_task();
+#endif
+
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+    // EEPROM writes stay on the main loop, which is the only writer of rgb_matrix_config and so reads it without the lock
+    eeconfig_flush_rgb_matrix(false);
+    // The render thread runs whenever the main loop sleeps, in wait_us() or waiting on USB, so
+    // only step aside for it when a keyboard never sleeps and the frame is long overdue
+    if (sync_timer_elapsed32(g_rgb_timer) > 2 * rgb_matrix_flush_limit()) {
+        chThdSleep(1);
     }
+#else
+    lighting_task_step();
+#endif
 }
 
 void rgb_matrix_indicators(void) {
@@ -408,16 +644,22 @@ __attribute__((weak)) bool rgb_matrix_indicators_user(void) {
 
 struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
     struct rgb_matrix_limits_t limits = {0};
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+#if defined(RGB_MATRIX_GOVERNOR_ENABLE)
+    uint8_t process_limit = RGB_MATRIX_GOVERNOR_PROCESS_LIMIT >> governor_level;
+    if (process_limit == 0) process_limit = 1;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT
+    const uint8_t process_limit = RGB_MATRIX_LED_PROCESS_LIMIT;
+#endif
+#if defined(RGB_MATRIX_GOVERNOR_ENABLE) || (defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < RGB_MATRIX_LED_COUNT)
 #    if defined(RGB_MATRIX_SPLIT)
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = process_limit * (iter);
+    limits.led_max_index = limits.led_min_index + process_limit;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
     if (is_keyboard_left() && (limits.led_max_index > k_rgb_matrix_split[0])) limits.led_max_index = k_rgb_matrix_split[0];
     if (!(is_keyboard_left()) && (limits.led_min_index < k_rgb_matrix_split[0])) limits.led_min_index = k_rgb_matrix_split[0];
 #    else
-    limits.led_min_index = RGB_MATRIX_LED_PROCESS_LIMIT * (iter);
-    limits.led_max_index = limits.led_min_index + RGB_MATRIX_LED_PROCESS_LIMIT;
+    limits.led_min_index = process_limit * (iter);
+    limits.led_max_index = limits.led_min_index + process_limit;
     if (limits.led_max_index > RGB_MATRIX_LED_COUNT) limits.led_max_index = RGB_MATRIX_LED_COUNT;
 #    endif
 #else
@@ -436,9 +678,9 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter) {
 
 void rgb_matrix_indicators_advanced(effect_params_t *params) {
     /* special handling is needed for "params->iter", since it's already been incremented.
-     * Could move the invocations to rgb_task_render, but then it's missing a few checks
+     * Could move the invocations to lighting_task_render, but then it's missing a few checks
      * and not sure which would be better. Otherwise, this should be called from
-     * rgb_task_render, right before the iter++ line.
+     * lighting_task_render, right before the iter++ line.
      */
     RGB_MATRIX_USE_LIMITS_ITER(min, max, params->iter - 1);
     rgb_matrix_indicators_advanced_kb(min, max);
@@ -455,17 +697,7 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
-#ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
-    g_last_hit_tracker.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        g_last_hit_tracker.tick[i] = UINT16_MAX;
-    }
-
-    last_hit_buffer.count = 0;
-    for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
-        last_hit_buffer.tick[i] = UINT16_MAX;
-    }
-#endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+    lighting_init();
 
     eeconfig_init_rgb_matrix();
     if (!rgb_matrix_config.mode) {
@@ -473,14 +705,24 @@ void rgb_matrix_init(void) {
         eeconfig_update_rgb_matrix_default();
     }
     eeconfig_debug_rgb_matrix(); // display current eeprom values
+
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+    static bool thread_started = false;
+    if (!thread_started) {
+        thread_started = true;
+        rgb_matrix_thread = chThdCreateStatic(waRGBMatrixThread, sizeof(waRGBMatrixThread), RGB_MATRIX_RENDER_THREAD_PRIORITY, RGBMatrixThread, NULL);
+    }
+#endif
 }
 
 void rgb_matrix_set_suspend_state(bool state) {
 #ifdef RGB_MATRIX_SLEEP
+#    ifndef RGB_MATRIX_RENDER_THREAD_ENABLE
     if (state && !suspend_state) { // only run if turning off, and only once
-        rgb_task_render(0);        // turn off all LEDs when suspending
-        rgb_task_flush(0);         // and actually flash led state to LEDs
+        lighting_task_render(0);   // turn off all LEDs when suspending
+        lighting_task_flush(0);    // and actually flash led state to LEDs
     }
+#    endif // the render thread turns the LEDs off with its next frame instead
     suspend_state = state;
 #endif
 }
@@ -490,8 +732,10 @@ bool rgb_matrix_get_suspend_state(void) {
 }
 
 void rgb_matrix_toggle_eeprom_helper(bool write_to_eeprom) {
+    rgb_matrix_lock();
     rgb_matrix_config.enable ^= 1;
-    rgb_task_state = STARTING;
+    rgb_matrix_unlock();
+    lighting_task_restart();
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix toggle [%s]: rgb_matrix_config.enable = %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.enable);
 }
@@ -508,8 +752,10 @@ void rgb_matrix_enable(void) {
 }
 
 void rgb_matrix_enable_noeeprom(void) {
-    if (!rgb_matrix_config.enable) rgb_task_state = STARTING;
+    if (!rgb_matrix_config.enable) lighting_task_restart();
+    rgb_matrix_lock();
     rgb_matrix_config.enable = 1;
+    rgb_matrix_unlock();
 }
 
 void rgb_matrix_disable(void) {
@@ -518,8 +764,10 @@ void rgb_matrix_disable(void) {
 }
 
 void rgb_matrix_disable_noeeprom(void) {
-    if (rgb_matrix_config.enable) rgb_task_state = STARTING;
+    if (rgb_matrix_config.enable) lighting_task_restart();
+    rgb_matrix_lock();
     rgb_matrix_config.enable = 0;
+    rgb_matrix_unlock();
 }
 
 uint8_t rgb_matrix_is_enabled(void) {
@@ -530,6 +778,7 @@ void rgb_matrix_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     if (!rgb_matrix_config.enable) {
         return;
     }
+    rgb_matrix_lock();
     if (mode < 1) {
         rgb_matrix_config.mode = 1;
     } else if (mode >= RGB_MATRIX_EFFECT_MAX) {
@@ -537,7 +786,8 @@ void rgb_matrix_mode_eeprom_helper(uint8_t mode, bool write_to_eeprom) {
     } else {
         rgb_matrix_config.mode = mode;
     }
-    rgb_task_state = STARTING;
+    rgb_matrix_unlock();
+    lighting_task_restart();
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix mode [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.mode);
 }
@@ -578,9 +828,11 @@ void rgb_matrix_sethsv_eeprom_helper(uint16_t hue, uint8_t sat, uint8_t val, boo
     if (!rgb_matrix_config.enable) {
         return;
     }
+    rgb_matrix_lock();
     rgb_matrix_config.hsv.h = hue;
     rgb_matrix_config.hsv.s = sat;
     rgb_matrix_config.hsv.v = (val > RGB_MATRIX_MAXIMUM_BRIGHTNESS) ? RGB_MATRIX_MAXIMUM_BRIGHTNESS : val;
+    rgb_matrix_unlock();
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix set hsv [%s]: %u,%u,%u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.hsv.h, rgb_matrix_config.hsv.s, rgb_matrix_config.hsv.v);
 }
@@ -665,7 +917,9 @@ void rgb_matrix_decrease_val(void) {
 }
 
 void rgb_matrix_set_speed_eeprom_helper(uint8_t speed, bool write_to_eeprom) {
+    rgb_matrix_lock();
     rgb_matrix_config.speed = speed;
+    rgb_matrix_unlock();
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix set speed [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.speed);
 }
@@ -701,7 +955,9 @@ void rgb_matrix_decrease_speed(void) {
 }
 
 void rgb_matrix_set_flags_eeprom_helper(led_flags_t flags, bool write_to_eeprom) {
+    rgb_matrix_lock();
     rgb_matrix_config.flags = flags;
+    rgb_matrix_unlock();
     eeconfig_flag_rgb_matrix(write_to_eeprom);
     dprintf("rgb matrix set flags [%s]: %u\n", (write_to_eeprom) ? "EEPROM" : "NOEEPROM", rgb_matrix_config.flags);
 }
@@ -90,6 +90,64 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+#    ifndef RGB_MATRIX_GOVERNOR_SCAN_RATE
+#        define RGB_MATRIX_GOVERNOR_SCAN_RATE 1000
+#    endif
+#    ifndef RGB_MATRIX_GOVERNOR_INTERVAL
+#        define RGB_MATRIX_GOVERNOR_INTERVAL 250
+#    endif
+#    ifndef RGB_MATRIX_GOVERNOR_MAX_LEVEL
+#        define RGB_MATRIX_GOVERNOR_MAX_LEVEL 3
+#    endif
+#endif
+
+#if defined(RGB_MATRIX_CURRENT_LIMIT_ENABLE) && !defined(RGB_MATRIX_CURRENT_LIMIT)
+#    ifndef USB_MAX_POWER_CONSUMPTION
+#        define USB_MAX_POWER_CONSUMPTION 500
+#    endif
+#    ifndef RGB_MATRIX_CURRENT_RESERVED
+#        define RGB_MATRIX_CURRENT_RESERVED 100
+#    endif
+#    if USB_MAX_POWER_CONSUMPTION <= RGB_MATRIX_CURRENT_RESERVED
+#        error "RGB_MATRIX_CURRENT_RESERVED leaves no current for the LEDs out of USB_MAX_POWER_CONSUMPTION"
+#    endif
+// The power requested from the host in the configuration descriptor, less what the rest of the keyboard draws
+#    define RGB_MATRIX_CURRENT_LIMIT (USB_MAX_POWER_CONSUMPTION - RGB_MATRIX_CURRENT_RESERVED)
+#endif
+
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+// The limiter works on the whole frame, so it has to be kept in RAM
+#    ifndef RGB_MATRIX_WRITE_FRAME
+#        define RGB_MATRIX_WRITE_FRAME
+#    endif
+#    ifndef RGB_MATRIX_CURRENT_LIMIT_UNCONFIGURED
+#        define RGB_MATRIX_CURRENT_LIMIT_UNCONFIGURED 50
+#    endif
+#    ifndef RGB_MATRIX_CURRENT_LIMIT_SUSPEND
+#        define RGB_MATRIX_CURRENT_LIMIT_SUSPEND 0
+#    endif
+#    ifndef RGB_MATRIX_CURRENT_RED
+#        define RGB_MATRIX_CURRENT_RED 20
+#    endif
+#    ifndef RGB_MATRIX_CURRENT_GREEN
+#        define RGB_MATRIX_CURRENT_GREEN 20
+#    endif
+#    ifndef RGB_MATRIX_CURRENT_BLUE
+#        define RGB_MATRIX_CURRENT_BLUE 20
+#    endif
+#endif
+
+#ifdef RGB_MATRIX_RENDER_THREAD_ENABLE
+#    ifndef PROTOCOL_CHIBIOS
+#        error "RGB_MATRIX_RENDER_THREAD_ENABLE is only supported on ChibiOS"
+#    endif
+// The render thread draws into a frame in RAM, which is copied for the driver when it is flushed
+#    ifndef RGB_MATRIX_WRITE_FRAME
+#        define RGB_MATRIX_WRITE_FRAME
+#    endif
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -154,6 +212,20 @@ void rgb_matrix_handle_key_event(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
 
+#ifdef RGB_MATRIX_CURRENT_LIMIT
+uint16_t rgb_matrix_current_limit(void);
+#endif
+
+#ifdef RGB_MATRIX_GOVERNOR_ENABLE
+typedef struct {
+    uint32_t scan_rate;  // Main loop iterations per second, over the last measurement window
+    uint16_t frame_time; // Milliseconds from the start of the last frame until it was flushed
+    uint8_t  level;      // 0 renders as configured, each level halves the LEDs rendered per task run and the frame rate
+} rgb_matrix_governor_stats_t;
+
+rgb_matrix_governor_stats_t rgb_matrix_governor_get_stats(void);
+#endif
+
 // This runs after another backlight effect and replaces
 // colors already set
 void rgb_matrix_indicators(void);
@@ -213,6 +285,8 @@ led_flags_t rgb_matrix_get_flags(void);
 void        rgb_matrix_set_flags(led_flags_t flags);
 void        rgb_matrix_set_flags_noeeprom(led_flags_t flags);
 void        rgb_matrix_update_pwm_buffers(void);
+void        rgb_matrix_lock(void);
+void        rgb_matrix_unlock(void);
 
 #ifndef RGBLIGHT_ENABLE
 #    define eeconfig_update_rgblight_current eeconfig_update_rgb_matrix
@@ -280,3 +354,9 @@ extern last_hit_t g_last_hit_tracker;
 #ifdef RGB_MATRIX_FRAMEBUFFER_EFFECTS
 extern uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
 #endif
+#ifdef RGB_MATRIX_POLAR_TABLE
+extern led_polar_t g_rgb_polar_table[RGB_MATRIX_LED_COUNT];
+#endif
+#if defined(RGB_MATRIX_KEYREACTIVE_ENABLED) && defined(RGB_MATRIX_HIT_DISTANCE_TABLE)
+extern uint8_t g_rgb_hit_distance[LED_HITS_TO_REMEMBER][RGB_MATRIX_LED_COUNT];
+#endif
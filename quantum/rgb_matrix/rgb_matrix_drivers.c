@@ -62,10 +62,12 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 #elif defined(RGB_MATRIX_IS31FL3733)
 const rgb_matrix_driver_t rgb_matrix_driver = {
-    .init          = is31fl3733_init_drivers,
-    .flush         = is31fl3733_flush,
-    .set_color     = is31fl3733_set_color,
-    .set_color_all = is31fl3733_set_color_all,
+    .init            = is31fl3733_init_drivers,
+    .flush           = is31fl3733_flush,
+    .set_color       = is31fl3733_set_color,
+    .set_color_all   = is31fl3733_set_color_all,
+    .set_color_range = is31fl3733_set_color_range,
+    .write_frame     = is31fl3733_write_frame,
 };
 
 #elif defined(RGB_MATRIX_IS31FL3736)
@@ -78,18 +80,22 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 #elif defined(RGB_MATRIX_IS31FL3737)
 const rgb_matrix_driver_t rgb_matrix_driver = {
-    .init          = is31fl3737_init_drivers,
-    .flush         = is31fl3737_flush,
-    .set_color     = is31fl3737_set_color,
-    .set_color_all = is31fl3737_set_color_all,
+    .init            = is31fl3737_init_drivers,
+    .flush           = is31fl3737_flush,
+    .set_color       = is31fl3737_set_color,
+    .set_color_all   = is31fl3737_set_color_all,
+    .set_color_range = is31fl3737_set_color_range,
+    .write_frame     = is31fl3737_write_frame,
 };
 
 #elif defined(RGB_MATRIX_IS31FL3741)
 const rgb_matrix_driver_t rgb_matrix_driver = {
-    .init          = is31fl3741_init_drivers,
-    .flush         = is31fl3741_flush,
-    .set_color     = is31fl3741_set_color,
-    .set_color_all = is31fl3741_set_color_all,
+    .init            = is31fl3741_init_drivers,
+    .flush           = is31fl3741_flush,
+    .set_color       = is31fl3741_set_color,
+    .set_color_all   = is31fl3741_set_color_all,
+    .set_color_range = is31fl3741_set_color_range,
+    .write_frame     = is31fl3741_write_frame,
 };
 
 #elif defined(RGB_MATRIX_IS31FL3742A)
@@ -134,10 +140,12 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 
 #elif defined(RGB_MATRIX_AW20216S)
 const rgb_matrix_driver_t rgb_matrix_driver = {
-    .init          = aw20216s_init_drivers,
-    .flush         = aw20216s_flush,
-    .set_color     = aw20216s_set_color,
-    .set_color_all = aw20216s_set_color_all,
+    .init            = aw20216s_init_drivers,
+    .flush           = aw20216s_flush,
+    .set_color       = aw20216s_set_color,
+    .set_color_all   = aw20216s_set_color_all,
+    .set_color_range = aw20216s_set_color_range,
+    .write_frame     = aw20216s_write_frame,
 };
 
 #elif defined(RGB_MATRIX_WS2812)
@@ -147,10 +155,12 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 #    endif
 
 const rgb_matrix_driver_t rgb_matrix_driver = {
-    .init          = ws2812_init,
-    .flush         = ws2812_flush,
-    .set_color     = ws2812_set_color,
-    .set_color_all = ws2812_set_color_all,
+    .init            = ws2812_init,
+    .flush           = ws2812_flush,
+    .set_color       = ws2812_set_color,
+    .set_color_all   = ws2812_set_color_all,
+    .set_color_range = ws2812_set_color_range,
+    .write_frame     = ws2812_write_frame,
 };
 
 #endif
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "color.h"
 
 #if defined(RGB_MATRIX_AW20216S)
 #    include "aw20216s.h"
@@ -44,6 +45,10 @@ typedef struct {
     void (*set_color)(int index, uint8_t r, uint8_t g, uint8_t b);
     /* Set the colour of all LEDS on the keyboard in the buffer. */
     void (*set_color_all)(uint8_t r, uint8_t g, uint8_t b);
+    /* Optional: set the colour of the LEDs from start up to, but not including, end in the buffer. */
+    void (*set_color_range)(int start, int end, uint8_t r, uint8_t g, uint8_t b);
+    /* Optional: copy a whole frame, starting at the first LED, into the buffer. */
+    void (*write_frame)(const rgb_t *colors, int count);
     /* Flush any buffered changes to the hardware. */
     void (*flush)(void);
 } rgb_matrix_driver_t;
@@ -37,6 +37,9 @@ typedef struct PACKED {
     uint8_t  y[LED_HITS_TO_REMEMBER];
     uint8_t  index[LED_HITS_TO_REMEMBER];
     uint16_t tick[LED_HITS_TO_REMEMBER];
+#    ifdef RGB_MATRIX_HIT_DISTANCE_TABLE
+    uint8_t  slot[LED_HITS_TO_REMEMBER]; // Row of g_rgb_hit_distance holding the distance of every LED from the hit
+#    endif
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
@@ -55,6 +58,11 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+typedef struct PACKED {
+    uint8_t angle; // atan2_8() of the offset from the center
+    uint8_t dist;  // sqrt16() of the offset from the center
+} led_polar_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -0,0 +1,78 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "color.h"
+#include "usb_device_state.h"
+}
+
+class RgbCurrentScaleTest : public ::testing::Test {};
+
+TEST_F(RgbCurrentScaleTest, WithinBudgetIsUnscaled) {
+    rgb_t frame[4] = {{255, 0, 0}, {0, 255, 0}, {0, 0, 255}, {0, 0, 0}};
+    // 20mA per channel at full brightness, 60mA in total
+    EXPECT_EQ(rgb_current_scale(frame, 4, 20, 20, 20, 60), 256);
+    EXPECT_EQ(rgb_current_scale(frame, 4, 20, 20, 20, 500), 256);
+}
+
+TEST_F(RgbCurrentScaleTest, DarkFrameIsUnscaled) {
+    rgb_t frame[8] = {};
+    EXPECT_EQ(rgb_current_scale(frame, 8, 20, 20, 20, 0), 256);
+}
+
+TEST_F(RgbCurrentScaleTest, OverBudgetScalesToTheLimit) {
+    rgb_t frame[10];
+    for (int i = 0; i < 10; i++) {
+        frame[i] = {255, 255, 255};
+    }
+    // 10 white LEDs draw 600mA, so 150mA is a quarter of that
+    EXPECT_EQ(rgb_current_scale(frame, 10, 20, 20, 20, 150), 64);
+    EXPECT_EQ(rgb_current_scale(frame, 10, 20, 20, 20, 300), 128);
+}
+
+TEST_F(RgbCurrentScaleTest, ChannelsHaveTheirOwnCurrent) {
+    rgb_t red[1]  = {{255, 0, 0}};
+    rgb_t blue[1] = {{0, 0, 255}};
+    EXPECT_EQ(rgb_current_scale(red, 1, 10, 20, 40, 20), 256);
+    EXPECT_EQ(rgb_current_scale(blue, 1, 10, 20, 40, 20), 128);
+}
+
+TEST_F(RgbCurrentScaleTest, ScaledFrameStaysWithinBudget) {
+    rgb_t frame[16];
+    for (int i = 0; i < 16; i++) {
+        frame[i] = {(uint8_t)(i * 16), 200, (uint8_t)(255 - i * 16)};
+    }
+    for (uint16_t limit = 1; limit < 1000; limit += 37) {
+        uint16_t scale = rgb_current_scale(frame, 16, 15, 12, 18, limit);
+        ASSERT_LE(scale, 256);
+
+        uint32_t current = 0;
+        for (int i = 0; i < 16; i++) {
+            rgb_t rgb = rgb_scale(frame[i], scale);
+            current += rgb.r * 15 + rgb.g * 12 + rgb.b * 18;
+        }
+        EXPECT_LE(current, (uint32_t)limit * 255) << "limit " << limit;
+    }
+}
+
+TEST_F(RgbCurrentScaleTest, BudgetFollowsUsbState) {
+    EXPECT_EQ(rgb_current_budget(USB_DEVICE_STATE_CONFIGURED, 400, 50, 0), 400);
+    EXPECT_EQ(rgb_current_budget(USB_DEVICE_STATE_INIT, 400, 50, 0), 50);
+    EXPECT_EQ(rgb_current_budget(USB_DEVICE_STATE_SUSPEND, 400, 50, 0), 0);
+    EXPECT_EQ(rgb_current_budget(USB_DEVICE_STATE_SUSPEND, 400, 50, 2), 2);
+    // Never more than the configured budget
+    EXPECT_EQ(rgb_current_budget(USB_DEVICE_STATE_INIT, 30, 50, 0), 30);
+    EXPECT_EQ(rgb_current_budget(USB_DEVICE_STATE_SUSPEND, 30, 50, 100), 30);
+}
+
+TEST_F(RgbCurrentScaleTest, SuspendedFrameIsDark) {
+    rgb_t frame[4] = {{255, 255, 255}, {1, 0, 0}, {0, 0, 0}, {0, 0, 128}};
+    uint16_t scale = rgb_current_scale(frame, 4, 20, 20, 20, rgb_current_budget(USB_DEVICE_STATE_SUSPEND, 400, 50, 0));
+    EXPECT_EQ(scale, 0);
+    for (int i = 0; i < 4; i++) {
+        rgb_t rgb = rgb_scale(frame[i], scale);
+        EXPECT_EQ(rgb.r | rgb.g | rgb.b, 0);
+    }
+}
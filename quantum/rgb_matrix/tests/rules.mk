@@ -0,0 +1,3 @@
+rgb_current_scale_SRC := \
+	$(QUANTUM_PATH)/rgb_matrix/tests/rgb_current_scale_tests.cpp \
+	$(QUANTUM_PATH)/color.c
@@ -0,0 +1 @@
+TEST_LIST += rgb_current_scale
@@ -23,6 +23,10 @@
 #include "debug.h"
 #include "util.h"
 #include "led_tables.h"
+#ifdef RGBLIGHT_CURRENT_LIMIT
+#    include "keyboard.h"
+#    include "usb_device_state.h"
+#endif
 #include <lib/lib8tion/lib8tion.h>
 #ifdef EEPROM_ENABLE
 #    include "eeprom.h"
@@ -148,8 +152,71 @@ uint8_t rgblight_led_index(uint8_t index) {
 #endif
 }
 
+#ifdef RGBLIGHT_CURRENT_LIMIT
+// This half's LEDs, kept so the current drawn by a frame can be worked out before it is flushed
+static rgb_t rgblight_frame[RGBLIGHT_LED_COUNT];
+
+__attribute__((weak)) uint16_t rgblight_current_limit(void) {
+#    ifdef SPLIT_KEYBOARD
+    // Only the half connected to the host knows the USB state
+    if (!is_keyboard_master()) {
+        return RGBLIGHT_CURRENT_LIMIT;
+    }
+#    endif
+    return rgb_current_budget(usb_device_state_get_configure_state(), RGBLIGHT_CURRENT_LIMIT, RGBLIGHT_CURRENT_LIMIT_UNCONFIGURED, RGBLIGHT_CURRENT_LIMIT_SUSPEND);
+}
+
+static void rgblight_write_frame(void) {
+    uint8_t  count = MIN(rgblight_ranges.clipping_num_leds, RGBLIGHT_LED_COUNT);
+    uint16_t scale = rgb_current_scale(rgblight_frame, count, RGBLIGHT_CURRENT_RED, RGBLIGHT_CURRENT_GREEN, RGBLIGHT_CURRENT_BLUE, rgblight_current_limit());
+
+    if (scale < 256) {
+        // Dim on the way out, so the frame keeps the values set by the effects
+        for (uint8_t i = 0; i < count; i++) {
+            rgb_t rgb = rgb_scale(rgblight_frame[i], scale);
+            rgblight_driver.set_color(i, rgb.r, rgb.g, rgb.b);
+        }
+    } else if (rgblight_driver.write_frame) {
+        rgblight_driver.write_frame(rgblight_frame, count);
+    } else {
+        for (uint8_t i = 0; i < count; i++) {
+            rgblight_driver.set_color(i, rgblight_frame[i].r, rgblight_frame[i].g, rgblight_frame[i].b);
+        }
+    }
+}
+#endif
+
+static void rgblight_set_color(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
+#ifdef RGBLIGHT_CURRENT_LIMIT
+    if (index < RGBLIGHT_LED_COUNT) {
+        rgblight_frame[index] = (rgb_t){r, g, b};
+    }
+#else
+    rgblight_driver.set_color(index, r, g, b);
+#endif
+}
+
+static void rgblight_set_color_range(uint8_t start, uint8_t end, uint8_t r, uint8_t g, uint8_t b) {
+#if !defined(RGBLIGHT_LED_MAP) && !defined(RGBLIGHT_CURRENT_LIMIT)
+    // Without a LED map the range stays contiguous, so the driver can fill it in one go
+    if (rgblight_driver.set_color_range) {
+        uint8_t clipping_end_pos = rgblight_ranges.clipping_start_pos + rgblight_ranges.clipping_num_leds;
+
+        start = MAX(start, rgblight_ranges.clipping_start_pos);
+        end   = MIN(end, clipping_end_pos);
+        if (start < end) {
+            rgblight_driver.set_color_range(start - rgblight_ranges.clipping_start_pos, end - rgblight_ranges.clipping_start_pos, r, g, b);
+        }
+        return;
+    }
+#endif
+    for (uint8_t i = start; i < end; i++) {
+        rgblight_set_color(rgblight_led_index(i), r, g, b);
+    }
+}
+
 void setrgb(uint8_t r, uint8_t g, uint8_t b, int index) {
-    rgblight_driver.set_color(rgblight_led_index(index), r, g, b);
+    rgblight_set_color(rgblight_led_index(index), r, g, b);
 }
 
 void sethsv_raw(uint8_t hue, uint8_t sat, uint8_t val, int index) {
@@ -644,9 +711,7 @@ void rgblight_setrgb(uint8_t r, uint8_t g, uint8_t b) {
         return;
     }
 
-    for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i), r, g, b);
-    }
+    rgblight_set_color_range(rgblight_ranges.effect_start_pos, rgblight_ranges.effect_end_pos, r, g, b);
     rgblight_set();
 }
 
@@ -655,7 +720,7 @@ void rgblight_setrgb_at(uint8_t r, uint8_t g, uint8_t b, uint8_t index) {
         return;
     }
 
-    rgblight_driver.set_color(rgblight_led_index(index), r, g, b);
+    rgblight_set_color(rgblight_led_index(index), r, g, b);
     rgblight_set();
 }
 
@@ -685,9 +750,7 @@ void rgblight_setrgb_range(uint8_t r, uint8_t g, uint8_t b, uint8_t start, uint8
         return;
     }
 
-    for (uint8_t i = start; i < end; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i), r, g, b);
-    }
+    rgblight_set_color_range(start, end, r, g, b);
     rgblight_set();
 }
 
@@ -877,9 +940,7 @@ void rgblight_wakeup(void) {
 
 void rgblight_set(void) {
     if (!rgblight_config.enable) {
-        for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
-            rgblight_driver.set_color(rgblight_led_index(i), 0, 0, 0);
-        }
+        rgblight_set_color_range(rgblight_ranges.effect_start_pos, rgblight_ranges.effect_end_pos, 0, 0, 0);
     }
 
 #ifdef RGBLIGHT_LAYERS
@@ -894,6 +955,9 @@ void rgblight_set(void) {
     }
 #endif
 
+#ifdef RGBLIGHT_CURRENT_LIMIT
+    rgblight_write_frame();
+#endif
     rgblight_driver.flush();
 }
 
@@ -1215,7 +1279,7 @@ void rgblight_effect_snake(animation_status_t *anim) {
 #    endif
 
     for (i = 0; i < rgblight_ranges.effect_num_leds; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i + rgblight_ranges.effect_start_pos), 0, 0, 0);
+        rgblight_set_color(rgblight_led_index(i + rgblight_ranges.effect_start_pos), 0, 0, 0);
 
         for (j = 0; j < RGBLIGHT_EFFECT_SNAKE_LENGTH; j++) {
             k = pos + j * increment;
@@ -1270,9 +1334,7 @@ void rgblight_effect_knight(animation_status_t *anim) {
     }
 #    endif
     // Set all the LEDs to 0
-    for (i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
-        rgblight_driver.set_color(rgblight_led_index(i), 0, 0, 0);
-    }
+    rgblight_set_color_range(rgblight_ranges.effect_start_pos, rgblight_ranges.effect_end_pos, 0, 0, 0);
     // Determine which LEDs should be lit up
     for (i = 0; i < RGBLIGHT_EFFECT_KNIGHT_LED_NUM; i++) {
         cur = (i + RGBLIGHT_EFFECT_KNIGHT_OFFSET) % rgblight_ranges.effect_num_leds + rgblight_ranges.effect_start_pos;
@@ -1280,7 +1342,7 @@ void rgblight_effect_knight(animation_status_t *anim) {
         if (i >= low_bound && i <= high_bound) {
             sethsv(rgblight_config.hue, rgblight_config.sat, rgblight_config.val, cur);
         } else {
-            rgblight_driver.set_color(rgblight_led_index(cur), 0, 0, 0);
+            rgblight_set_color(rgblight_led_index(cur), 0, 0, 0);
         }
     }
     rgblight_set();
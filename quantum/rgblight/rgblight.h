@@ -164,6 +164,38 @@ enum RGBLIGHT_EFFECT_MODE {
 #    define RGBLIGHT_LIMIT_VAL 255
 #endif
 
+#if defined(RGBLIGHT_CURRENT_LIMIT_ENABLE) && !defined(RGBLIGHT_CURRENT_LIMIT)
+#    ifndef USB_MAX_POWER_CONSUMPTION
+#        define USB_MAX_POWER_CONSUMPTION 500
+#    endif
+#    ifndef RGBLIGHT_CURRENT_RESERVED
+#        define RGBLIGHT_CURRENT_RESERVED 100
+#    endif
+#    if USB_MAX_POWER_CONSUMPTION <= RGBLIGHT_CURRENT_RESERVED
+#        error "RGBLIGHT_CURRENT_RESERVED leaves no current for the LEDs out of USB_MAX_POWER_CONSUMPTION"
+#    endif
+// The power requested from the host in the configuration descriptor, less what the rest of the keyboard draws
+#    define RGBLIGHT_CURRENT_LIMIT (USB_MAX_POWER_CONSUMPTION - RGBLIGHT_CURRENT_RESERVED)
+#endif
+
+#ifdef RGBLIGHT_CURRENT_LIMIT
+#    ifndef RGBLIGHT_CURRENT_LIMIT_UNCONFIGURED
+#        define RGBLIGHT_CURRENT_LIMIT_UNCONFIGURED 50
+#    endif
+#    ifndef RGBLIGHT_CURRENT_LIMIT_SUSPEND
+#        define RGBLIGHT_CURRENT_LIMIT_SUSPEND 0
+#    endif
+#    ifndef RGBLIGHT_CURRENT_RED
+#        define RGBLIGHT_CURRENT_RED 20
+#    endif
+#    ifndef RGBLIGHT_CURRENT_GREEN
+#        define RGBLIGHT_CURRENT_GREEN 20
+#    endif
+#    ifndef RGBLIGHT_CURRENT_BLUE
+#        define RGBLIGHT_CURRENT_BLUE 20
+#    endif
+#endif
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "rgblight_drivers.h"
@@ -290,6 +322,9 @@ extern rgblight_ranges_t rgblight_ranges;
 /* === Low level Functions === */
 void rgblight_set(void);
 void rgblight_set_clipping_range(uint8_t start_pos, uint8_t num_leds);
+#ifdef RGBLIGHT_CURRENT_LIMIT
+uint16_t rgblight_current_limit(void);
+#endif
 
 /* === Effects and Animations Functions === */
 /*   effect range setting */
@@ -7,20 +7,24 @@
 #    include "ws2812.h"
 
 const rgblight_driver_t rgblight_driver = {
-    .init          = ws2812_init,
-    .set_color     = ws2812_set_color,
-    .set_color_all = ws2812_set_color_all,
-    .flush         = ws2812_flush,
+    .init            = ws2812_init,
+    .set_color       = ws2812_set_color,
+    .set_color_all   = ws2812_set_color_all,
+    .set_color_range = ws2812_set_color_range,
+    .write_frame     = ws2812_write_frame,
+    .flush           = ws2812_flush,
 };
 
 #elif defined(RGBLIGHT_APA102)
 #    include "apa102.h"
 
 const rgblight_driver_t rgblight_driver = {
-    .init          = apa102_init,
-    .set_color     = apa102_set_color,
-    .set_color_all = apa102_set_color_all,
-    .flush         = apa102_flush,
+    .init            = apa102_init,
+    .set_color       = apa102_set_color,
+    .set_color_all   = apa102_set_color_all,
+    .set_color_range = apa102_set_color_range,
+    .write_frame     = apa102_write_frame,
+    .flush           = apa102_flush,
 };
 
 #endif
@@ -4,11 +4,14 @@
 #pragma once
 
 #include <stdint.h>
+#include "color.h"
 
 typedef struct {
     void (*init)(void);
     void (*set_color)(int index, uint8_t red, uint8_t green, uint8_t blue);
     void (*set_color_all)(uint8_t red, uint8_t green, uint8_t blue);
+    void (*set_color_range)(int start, int end, uint8_t red, uint8_t green, uint8_t blue); // Optional
+    void (*write_frame)(const rgb_t *colors, int count);                                 // Optional
     void (*flush)(void);
 } rgblight_driver_t;
 
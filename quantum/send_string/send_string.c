@@ -29,7 +29,7 @@
 #    ifndef BELL_SOUND
 #        define BELL_SOUND TERMINAL_SOUND
 #    endif
-float bell_song[][2] = SONG(BELL_SOUND);
+const audio_compact_note_t bell_song[] PROGMEM = SONG(BELL_SOUND);
 #endif
 
 // clang-format off
@@ -216,7 +216,7 @@ void send_char(char ascii_code) {
 void send_char_with_delay(char ascii_code, uint8_t interval) {
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
     if (ascii_code == '\a') { // BEL
-        PLAY_SONG(bell_song);
+        PLAY_COMPACT_SONG(bell_song);
         return;
     }
 #endif
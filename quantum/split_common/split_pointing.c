@@ -0,0 +1,116 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "split_pointing.h"
+#include "crc.h"
+
+#if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+
+/*
+ * The target accumulates motion and publishes it in numbered packets. A packet stays in place until the initiator has acknowledged its
+ * sequence number, so a packet is pending exactly while the target's sequence and ack differ. The initiator applies a pending packet once,
+ * and only remembers its sequence number until the acknowledgement has reached the target, so either side can be reset without motion
+ * being dropped or repeated.
+ *
+ * A reset target starts numbering its packets from scratch, so the initiator could mistake its first packet for one it applied before
+ * the reset. Every acknowledgement sets the synced flag, which only a reset of the target clears: while it is clear, the initiator forgets
+ * what it has applied and sends a bare acknowledgement before accepting any packets of the new session.
+ */
+
+/**
+ * @brief Adds a sensor report to the motion waiting to be published
+ */
+void split_pointing_accumulate(split_pointing_motion_t *motion, report_mouse_t report) {
+    motion->x += report.x;
+    motion->y += report.y;
+    motion->h += report.h;
+    motion->v += report.v;
+    motion->buttons = report.buttons;
+}
+
+/**
+ * @brief Publishes as much of the accumulated motion as fits into a packet, once the previous packet has been acknowledged
+ *
+ * @return true if a new packet was published
+ */
+bool split_pointing_publish(split_pointing_motion_t *motion, split_slave_pointing_sync_t *sync) {
+    if (!motion->x && !motion->y && !motion->h && !motion->v && motion->buttons == motion->sent_buttons) {
+        return false;
+    }
+    if (sync->state.ack.sequence != sync->state.sequence) {
+        return false;
+    }
+
+    split_slave_pointing_packet_t *packet = &sync->packet;
+    memset(packet, 0, sizeof(split_slave_pointing_packet_t));
+    packet->report.x       = CONSTRAIN_HID_XY(motion->x);
+    packet->report.y       = CONSTRAIN_HID_XY(motion->y);
+    packet->report.h       = CONSTRAIN_HID_HV(motion->h);
+    packet->report.v       = CONSTRAIN_HID_HV(motion->v);
+    packet->report.buttons = motion->buttons;
+    packet->checksum       = crc8(&packet->report, sizeof(report_mouse_t));
+    sync->state.sequence++;
+
+    motion->x -= packet->report.x;
+    motion->y -= packet->report.y;
+    motion->h -= packet->report.h;
+    motion->v -= packet->report.v;
+    motion->sent_buttons = motion->buttons;
+    return true;
+}
+
+/**
+ * @brief Checks whether the target holds a packet that hasn't been applied yet
+ */
+bool split_pointing_packet_wanted(split_pointing_receiver_t *receiver, split_slave_pointing_state_t state) {
+    if (!state.ack.synced) {
+        // The target has been reset, the sequence numbers seen before belong to its previous session
+        receiver->ack_pending = false;
+        return false;
+    }
+    if (state.sequence == state.ack.sequence) {
+        // Nothing pending, so whatever was applied has been acknowledged, or the target has been reset
+        receiver->ack_pending = false;
+        return false;
+    }
+    // Already applied, only the acknowledgement went missing
+    return !(receiver->ack_pending && receiver->applied == state.sequence);
+}
+
+/**
+ * @brief Validates a packet read from the target and records it as applied
+ *
+ * @return true if the packet's report should be applied
+ */
+bool split_pointing_packet_accept(split_pointing_receiver_t *receiver, split_slave_pointing_state_t state, const split_slave_pointing_packet_t *packet) {
+    if (packet->checksum != crc8(&packet->report, sizeof(packet->report))) {
+        return false;
+    }
+    receiver->applied     = state.sequence;
+    receiver->ack_pending = true;
+    return true;
+}
+
+/**
+ * @brief Checks whether the acknowledgement of the last applied packet still has to be sent to the target
+ */
+bool split_pointing_ack_wanted(split_pointing_receiver_t *receiver, split_slave_pointing_state_t state) {
+    if (!state.ack.synced) {
+        // Resends the target's own ack, only to set the synced flag
+        receiver->applied     = state.ack.sequence;
+        receiver->ack_pending = true;
+    } else if (receiver->ack_pending && state.ack.sequence == receiver->applied) {
+        receiver->ack_pending = false;
+    }
+    return receiver->ack_pending;
+}
+
+/**
+ * @brief Records that the acknowledgement of the last applied packet has reached the target
+ */
+void split_pointing_ack_sent(split_pointing_receiver_t *receiver) {
+    receiver->ack_pending = false;
+}
+
+#endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
@@ -0,0 +1,54 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pointing_device.h"
+
+typedef struct _split_slave_pointing_packet_t {
+    uint8_t        checksum;
+    report_mouse_t report;
+} split_slave_pointing_packet_t;
+
+typedef struct _split_slave_pointing_ack_t {
+    uint8_t sequence; // sequence of the last packet consumed by the master
+    bool    synced;   // set by the master, and only cleared by a reset of the target
+} split_slave_pointing_ack_t;
+
+typedef struct _split_slave_pointing_state_t {
+    uint8_t                    sequence; // bumped whenever a new packet is published
+    split_slave_pointing_ack_t ack;      // written by the master
+} split_slave_pointing_state_t;
+
+typedef struct _split_slave_pointing_sync_t {
+    split_slave_pointing_state_t  state;
+    split_slave_pointing_packet_t packet; // motion since the previous packet
+    uint16_t                      cpi;
+} split_slave_pointing_sync_t;
+
+// Motion read on the target that hasn't been published yet
+typedef struct _split_pointing_motion_t {
+    int32_t x;
+    int32_t y;
+    int32_t h;
+    int32_t v;
+    uint8_t buttons;
+    uint8_t sent_buttons;
+} split_pointing_motion_t;
+
+// Initiator side bookkeeping of the packets it has applied
+typedef struct _split_pointing_receiver_t {
+    uint8_t applied;     // sequence of the last packet applied
+    bool    ack_pending; // the target hasn't confirmed the acknowledgement of `applied` yet
+} split_pointing_receiver_t;
+
+void split_pointing_accumulate(split_pointing_motion_t *motion, report_mouse_t report);
+bool split_pointing_publish(split_pointing_motion_t *motion, split_slave_pointing_sync_t *sync);
+
+bool split_pointing_packet_wanted(split_pointing_receiver_t *receiver, split_slave_pointing_state_t state);
+bool split_pointing_packet_accept(split_pointing_receiver_t *receiver, split_slave_pointing_state_t state, const split_slave_pointing_packet_t *packet);
+bool split_pointing_ack_wanted(split_pointing_receiver_t *receiver, split_slave_pointing_state_t state);
+void split_pointing_ack_sent(split_pointing_receiver_t *receiver);
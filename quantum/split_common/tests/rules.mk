@@ -0,0 +1,7 @@
+split_pointing_DEFS := -DPOINTING_DEVICE_ENABLE -DSPLIT_POINTING_ENABLE
+split_pointing_INC := $(QUANTUM_PATH)/split_common $(QUANTUM_PATH)/pointing_device
+
+split_pointing_SRC := \
+    $(QUANTUM_PATH)/split_common/tests/split_pointing_tests.cpp \
+    $(QUANTUM_PATH)/split_common/split_pointing.c \
+    $(QUANTUM_PATH)/crc.c
@@ -0,0 +1,196 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_pointing.h"
+}
+
+// Both sides of the link, with the transfers the pointing transaction handlers make
+class SplitPointingTest : public ::testing::Test {
+   protected:
+    split_slave_pointing_sync_t target   = {};
+    split_pointing_motion_t     motion   = {};
+    split_pointing_receiver_t   receiver = {};
+    int32_t                     moved_x  = 0;
+    int32_t                     moved_y  = 0;
+    int                         applied  = 0;
+
+    // The link comes up with an idle target, the first poll only syncs up with it
+    void SetUp() override {
+        poll();
+    }
+
+    void move(int8_t x, int8_t y) {
+        report_mouse_t report = {};
+        report.x              = x;
+        report.y              = y;
+        split_pointing_accumulate(&motion, report);
+        split_pointing_publish(&motion, &target);
+    }
+
+    void poll(bool ack_lost = false) {
+        split_slave_pointing_state_t state = target.state;
+        if (split_pointing_packet_wanted(&receiver, state)) {
+            split_slave_pointing_packet_t packet = target.packet;
+            if (split_pointing_packet_accept(&receiver, state, &packet)) {
+                moved_x += packet.report.x;
+                moved_y += packet.report.y;
+                applied++;
+            }
+        }
+        if (split_pointing_ack_wanted(&receiver, state) && !ack_lost) {
+            target.state.ack = {receiver.applied, true};
+            split_pointing_ack_sent(&receiver);
+        }
+    }
+};
+
+TEST_F(SplitPointingTest, MotionIsDeliveredOnce) {
+    move(5, -3);
+    poll();
+    poll();
+    poll();
+
+    EXPECT_EQ(applied, 1);
+    EXPECT_EQ(moved_x, 5);
+    EXPECT_EQ(moved_y, -3);
+    EXPECT_EQ(target.state.ack.sequence, target.state.sequence);
+}
+
+TEST_F(SplitPointingTest, IdleSensorPublishesNothing) {
+    move(0, 0);
+    poll();
+
+    EXPECT_EQ(target.state.sequence, 0);
+    EXPECT_EQ(applied, 0);
+}
+
+TEST_F(SplitPointingTest, MotionAccumulatesUntilAcknowledged) {
+    move(1, 0);
+    move(2, 0);
+    move(3, 0);
+    EXPECT_EQ(target.state.sequence, 1);
+
+    poll();
+    move(0, 0);
+    poll();
+
+    EXPECT_EQ(applied, 2);
+    EXPECT_EQ(moved_x, 6);
+}
+
+TEST_F(SplitPointingTest, LostAcknowledgementIsResentNotReapplied) {
+    move(4, 4);
+    poll(true);
+    EXPECT_NE(target.state.ack.sequence, target.state.sequence);
+
+    poll();
+    poll();
+
+    EXPECT_EQ(applied, 1);
+    EXPECT_EQ(moved_x, 4);
+    EXPECT_EQ(target.state.ack.sequence, target.state.sequence);
+}
+
+TEST_F(SplitPointingTest, CorruptPacketIsNotApplied) {
+    move(7, 0);
+    target.packet.checksum ^= 0xFF;
+    poll();
+    EXPECT_EQ(applied, 0);
+    EXPECT_NE(target.state.ack.sequence, target.state.sequence);
+
+    target.packet.checksum ^= 0xFF;
+    poll();
+    EXPECT_EQ(applied, 1);
+    EXPECT_EQ(moved_x, 7);
+}
+
+TEST_F(SplitPointingTest, LargeMotionIsSplitAcrossPackets) {
+    move(100, 0);
+    move(100, 0);
+    move(100, 0);
+    for (int i = 0; i < 4; i++) {
+        poll();
+        move(0, 0);
+    }
+
+    EXPECT_EQ(moved_x, 300);
+    EXPECT_EQ(motion.x, 0);
+}
+
+TEST_F(SplitPointingTest, InitiatorResetAppliesPendingPacket) {
+    move(1, 0);
+    poll();
+    move(2, 0);
+
+    // the restarted initiator has forgotten every sequence number it has seen
+    receiver = {};
+    poll();
+    poll();
+
+    EXPECT_EQ(applied, 2);
+    EXPECT_EQ(moved_x, 3);
+}
+
+TEST_F(SplitPointingTest, InitiatorResetDoesNotRepeatAcknowledgedPacket) {
+    move(1, 0);
+    poll();
+
+    receiver = {};
+    poll();
+
+    EXPECT_EQ(applied, 1);
+    EXPECT_EQ(moved_x, 1);
+}
+
+TEST_F(SplitPointingTest, TargetResetRestartsSequence) {
+    move(1, 0);
+    poll();
+    EXPECT_EQ(receiver.applied, 1);
+
+    // the restarted target publishes sequence number 1 again, which is applied once the initiator has synced up with it
+    target = {};
+    motion = {};
+    move(2, 0);
+    poll();
+    EXPECT_EQ(applied, 1);
+    poll();
+
+    EXPECT_EQ(applied, 2);
+    EXPECT_EQ(moved_x, 3);
+}
+
+TEST_F(SplitPointingTest, TargetResetWithAcknowledgementPending) {
+    move(1, 0);
+    poll(true);
+    EXPECT_EQ(receiver.applied, 1);
+    EXPECT_TRUE(receiver.ack_pending);
+
+    // the first packet of the restarted target has the sequence number the initiator still waits to acknowledge
+    target = {};
+    motion = {};
+    move(2, 0);
+    poll();
+    poll();
+    poll();
+
+    EXPECT_EQ(applied, 2);
+    EXPECT_EQ(moved_x, 3);
+    EXPECT_EQ(target.state.ack.sequence, target.state.sequence);
+}
+
+TEST_F(SplitPointingTest, LostSyncIsResent) {
+    target = {};
+    move(3, 0);
+    poll(true);
+    EXPECT_FALSE(target.state.ack.synced);
+    poll();
+    EXPECT_TRUE(target.state.ack.synced);
+    EXPECT_EQ(applied, 0);
+
+    poll();
+    EXPECT_EQ(applied, 1);
+    EXPECT_EQ(moved_x, 3);
+}
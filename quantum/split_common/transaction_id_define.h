@@ -80,8 +80,9 @@ enum serial_transaction_id {
 #endif // defined(ST7565_ENABLE) && defined(SPLIT_ST7565_ENABLE)
 
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
-    GET_POINTING_CHECKSUM,
+    GET_POINTING_STATE,
     GET_POINTING_DATA,
+    PUT_POINTING_ACK,
     PUT_POINTING_CPI,
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
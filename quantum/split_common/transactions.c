@@ -584,7 +584,9 @@ static bool rgb_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_
 
 static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     split_shared_memory_lock();
+    rgb_matrix_lock();
     memcpy(&rgb_matrix_config, &split_shmem->rgb_matrix_sync.rgb_matrix, sizeof(rgb_config_t));
+    rgb_matrix_unlock();
     bool rgb_suspend_state = split_shmem->rgb_matrix_sync.rgb_suspend_state;
     split_shared_memory_unlock();
 
@@ -715,17 +717,33 @@ static bool pointing_handlers_master(matrix_row_t master_matrix[], matrix_row_t
         return true;
     }
 #    endif
-    static uint32_t last_update     = 0;
-    static uint32_t last_cpi_update = 0;
-    static uint16_t last_cpi        = 0;
-    report_mouse_t  temp_state;
-    uint16_t        temp_cpi;
-    bool            okay = read_if_checksum_mismatch(GET_POINTING_CHECKSUM, GET_POINTING_DATA, &last_update, &temp_state, &split_shmem->pointing.report, sizeof(temp_state));
-    if (okay) pointing_device_set_shared_report(temp_state);
-    temp_cpi = pointing_device_get_shared_cpi();
-    if (temp_cpi) {
+    static split_pointing_receiver_t receiver        = {0};
+    static uint32_t                  last_cpi_update = 0;
+    static uint16_t                  last_cpi        = 0;
+    split_slave_pointing_state_t     state;
+
+    bool okay = transport_read(GET_POINTING_STATE, &state, sizeof(state));
+    if (okay && split_pointing_packet_wanted(&receiver, state)) {
+        split_slave_pointing_packet_t packet;
+        okay &= transport_read(GET_POINTING_DATA, &packet, sizeof(packet));
+        okay = okay && split_pointing_packet_accept(&receiver, state, &packet);
+        if (okay) {
+            pointing_device_add_shared_report(packet.report);
+        }
+    }
+    if (okay && split_pointing_ack_wanted(&receiver, state)) {
+        split_shmem->pointing.state.ack = (split_slave_pointing_ack_t){.sequence = receiver.applied, .synced = true};
+        okay &= transport_write(PUT_POINTING_ACK, &split_shmem->pointing.state.ack, sizeof(split_shmem->pointing.state.ack));
+        if (okay) {
+            split_pointing_ack_sent(&receiver);
+        }
+    }
+
+    uint16_t temp_cpi = pointing_device_get_shared_cpi();
+    if (okay && temp_cpi) {
+        // Also resent periodically, so the target picks it up again after it has been reset
         split_shmem->pointing.cpi = temp_cpi;
-        okay                      = send_if_condition(PUT_POINTING_CPI, &last_cpi_update, last_cpi != temp_cpi, &split_shmem->pointing.cpi, sizeof(split_shmem->pointing.cpi));
+        okay &= send_if_condition(PUT_POINTING_CPI, &last_cpi_update, last_cpi != temp_cpi, &split_shmem->pointing.cpi, sizeof(split_shmem->pointing.cpi));
         if (okay) {
             last_cpi = temp_cpi;
         }
@@ -745,6 +763,7 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
         return;
     }
 #    endif
+
 #    if (POINTING_DEVICE_TASK_THROTTLE_MS > 0)
     static uint32_t last_exec = 0;
     if (timer_elapsed32(last_exec) < POINTING_DEVICE_TASK_THROTTLE_MS) {
@@ -753,29 +772,35 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
     last_exec = timer_read32();
 #    endif
 
-    uint16_t temp_cpi = !pointing_device_driver->get_cpi ? 0 : pointing_device_driver->get_cpi(); // check for NULL
+    static split_pointing_motion_t motion      = {0};
+    static uint16_t                applied_cpi = 0;
 
     split_shared_memory_lock();
-    split_slave_pointing_sync_t pointing;
-    memcpy(&pointing, &split_shmem->pointing, sizeof(split_slave_pointing_sync_t));
+    uint16_t cpi = split_shmem->pointing.cpi;
     split_shared_memory_unlock();
 
-    if (pointing.cpi && pointing.cpi != temp_cpi && pointing_device_driver->set_cpi) {
-        pointing_device_driver->set_cpi(pointing.cpi);
+    if (cpi && cpi != applied_cpi && pointing_device_driver->set_cpi) {
+        pointing_device_driver->set_cpi(cpi);
+        applied_cpi = cpi;
     }
 
-    pointing.report = pointing_device_driver->get_report((report_mouse_t){0});
-    // Now update the checksum given that the pointing has been written to
-    pointing.checksum = crc8(&pointing.report, sizeof(report_mouse_t));
+    split_pointing_accumulate(&motion, pointing_device_driver->get_report((report_mouse_t){0}));
 
     split_shared_memory_lock();
-    memcpy(&split_shmem->pointing, &pointing, sizeof(split_slave_pointing_sync_t));
+    // Only publishes once the previous packet has been consumed, everything else stays accumulated until then
+    split_pointing_publish(&motion, &split_shmem->pointing);
     split_shared_memory_unlock();
 }
 
+// clang-format off
 #    define TRANSACTIONS_POINTING_MASTER() TRANSACTION_HANDLER_MASTER(pointing)
 #    define TRANSACTIONS_POINTING_SLAVE() TRANSACTION_HANDLER_SLAVE(pointing)
-#    define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.report), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi),
+#    define TRANSACTIONS_POINTING_REGISTRATIONS \
+    [GET_POINTING_STATE] = trans_target2initiator_initializer(pointing.state), \
+    [GET_POINTING_DATA]  = trans_target2initiator_initializer(pointing.packet), \
+    [PUT_POINTING_ACK]   = trans_initiator2target_initializer(pointing.state.ack), \
+    [PUT_POINTING_CPI]   = trans_initiator2target_initializer(pointing.cpi),
+// clang-format on
 
 #else // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
@@ -107,12 +107,7 @@ typedef struct _split_mods_sync_t {
 #endif // SPLIT_MODS_ENABLE
 
 #if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
-#    include "pointing_device.h"
-typedef struct _split_slave_pointing_sync_t {
-    uint8_t        checksum;
-    report_mouse_t report;
-    uint16_t       cpi;
-} split_slave_pointing_sync_t;
+#    include "split_pointing.h"
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
 #if defined(HAPTIC_ENABLE) && defined(SPLIT_HAPTIC_ENABLE)
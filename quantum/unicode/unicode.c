@@ -81,54 +81,54 @@ __attribute__((weak)) void unicode_input_mode_set_kb(uint8_t input_mode) {
 
 #ifdef AUDIO_ENABLE
 #    ifdef UNICODE_SONG_MAC
-static float song_mac[][2] = UNICODE_SONG_MAC;
+static const audio_compact_note_t song_mac[] PROGMEM = UNICODE_SONG_MAC;
 #    endif
 #    ifdef UNICODE_SONG_LNX
-static float song_lnx[][2] = UNICODE_SONG_LNX;
+static const audio_compact_note_t song_lnx[] PROGMEM = UNICODE_SONG_LNX;
 #    endif
 #    ifdef UNICODE_SONG_WIN
-static float song_win[][2] = UNICODE_SONG_WIN;
+static const audio_compact_note_t song_win[] PROGMEM = UNICODE_SONG_WIN;
 #    endif
 #    ifdef UNICODE_SONG_BSD
-static float song_bsd[][2] = UNICODE_SONG_BSD;
+static const audio_compact_note_t song_bsd[] PROGMEM = UNICODE_SONG_BSD;
 #    endif
 #    ifdef UNICODE_SONG_WINC
-static float song_winc[][2] = UNICODE_SONG_WINC;
+static const audio_compact_note_t song_winc[] PROGMEM = UNICODE_SONG_WINC;
 #    endif
 #    ifdef UNICODE_SONG_EMACS
-static float song_emacs[][2] = UNICODE_SONG_EMACS;
+static const audio_compact_note_t song_emacs[] PROGMEM = UNICODE_SONG_EMACS;
 #    endif
 
 static void unicode_play_song(uint8_t mode) {
     switch (mode) {
 #    ifdef UNICODE_SONG_MAC
         case UNICODE_MODE_MACOS:
-            PLAY_SONG(song_mac);
+            PLAY_COMPACT_SONG(song_mac);
             break;
 #    endif
 #    ifdef UNICODE_SONG_LNX
         case UNICODE_MODE_LINUX:
-            PLAY_SONG(song_lnx);
+            PLAY_COMPACT_SONG(song_lnx);
             break;
 #    endif
 #    ifdef UNICODE_SONG_WIN
         case UNICODE_MODE_WINDOWS:
-            PLAY_SONG(song_win);
+            PLAY_COMPACT_SONG(song_win);
             break;
 #    endif
 #    ifdef UNICODE_SONG_BSD
         case UNICODE_MODE_BSD:
-            PLAY_SONG(song_bsd);
+            PLAY_COMPACT_SONG(song_bsd);
             break;
 #    endif
 #    ifdef UNICODE_SONG_WINC
         case UNICODE_MODE_WINCOMPOSE:
-            PLAY_SONG(song_winc);
+            PLAY_COMPACT_SONG(song_winc);
             break;
 #    endif
 #    ifdef UNICODE_SONG_EMACS
         case UNICODE_MODE_EMACS:
-            PLAY_SONG(song_emacs);
+            PLAY_COMPACT_SONG(song_emacs);
             break;
 #    endif
     }
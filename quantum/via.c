@@ -25,6 +25,9 @@
 #include "via.h"
 
 #include "raw_hid.h"
+#ifdef RAW_HID_STREAM_ENABLE
+#    include "raw_hid_stream.h"
+#endif
 #include "dynamic_keymap.h"
 #include "eeprom.h"
 #include "eeconfig.h"
@@ -144,7 +147,7 @@ void via_set_layout_options(uint32_t value) {
 }
 
 #if defined(AUDIO_ENABLE)
-float via_device_indication_song[][2] = SONG(STARTUP_SOUND);
+const audio_compact_note_t via_device_indication_song[] PROGMEM = SONG(STARTUP_SOUND);
 #endif // AUDIO_ENABLE
 
 // Used by VIA to tell a device to flash LEDs (or do something else) when that
@@ -169,7 +172,7 @@ __attribute__((weak)) void via_set_device_indication(uint8_t value) {
 #if defined(AUDIO_ENABLE)
     if (value == 0) {
         wait_ms(10);
-        PLAY_SONG(via_device_indication_song);
+        PLAY_COMPACT_SONG(via_device_indication_song);
     }
 #endif // AUDIO_ENABLE
 }
@@ -280,6 +283,13 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
     uint8_t *command_id   = &(data[0]);
     uint8_t *command_data = &(data[1]);
 
+#ifdef RAW_HID_STREAM_ENABLE
+    // Streaming requests share the interface, they never reach the VIA command handlers
+    if (raw_hid_stream_receive(data, length)) {
+        return;
+    }
+#endif
+
     // If via_command_kb() returns true, the command was fully
     // handled, including calling raw_hid_send()
     if (via_command_kb(data, length)) {
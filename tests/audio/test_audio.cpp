@@ -20,6 +20,10 @@
 #include "keyboard_report_util.hpp"
 #include "test_common.hpp"
 
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
 namespace {
 
 class AudioTest : public TestFixture {
@@ -115,4 +119,91 @@ TEST_F(AudioTest, BpmConversion) {
     }
 }
 
+TEST_F(AudioTest, CompactSongQueue) {
+    // At 120 bpm, a whole note (64/64 of a beat) is 500 ms.
+    static const audio_compact_note_t first[]  = {{440, 64}, {880, 64}};
+    static const audio_compact_note_t second[] = {{660, 64}};
+
+    audio_on();
+    audio_stop_all();
+    audio_set_tempo(120);
+
+    audio_play_compact_song(first, 2, false);
+    EXPECT_TRUE(audio_queue_compact_song(second, 1));
+    EXPECT_TRUE(audio_is_playing_melody());
+    EXPECT_EQ(audio_get_frequency(0), 440.0f);
+
+    advance_time(500);
+    audio_update_state();
+    EXPECT_EQ(audio_get_frequency(0), 880.0f);
+
+    // The queued song follows without the melody stopping in between.
+    advance_time(500);
+    audio_update_state();
+    EXPECT_TRUE(audio_is_playing_melody());
+    EXPECT_EQ(audio_get_frequency(0), 660.0f);
+
+    advance_time(500);
+    audio_update_state();
+    EXPECT_FALSE(audio_is_playing_melody());
+}
+
+TEST_F(AudioTest, CompactSongQueueKeptOnPlay) {
+    static const audio_compact_note_t first[]  = {{440, 64}};
+    static const audio_compact_note_t second[] = {{660, 64}};
+    static const audio_compact_note_t third[]  = {{880, 64}};
+
+    audio_on();
+    audio_stop_all();
+    audio_set_tempo(120);
+
+    audio_play_compact_song(first, 1, false);
+    EXPECT_TRUE(audio_queue_compact_song(second, 1));
+
+    // Playing another song replaces the current one, but not the queue behind it.
+    audio_play_compact_song(third, 1, false);
+    EXPECT_EQ(audio_get_frequency(0), 880.0f);
+
+    advance_time(500);
+    audio_update_state();
+    EXPECT_TRUE(audio_is_playing_melody());
+    EXPECT_EQ(audio_get_frequency(0), 660.0f);
+
+    advance_time(500);
+    audio_update_state();
+    EXPECT_FALSE(audio_is_playing_melody());
+}
+
+TEST_F(AudioTest, TonesKeepFixedPointFrequencies) {
+    audio_on();
+    audio_stop_all();
+
+    audio_play_tone(440.5f);
+    EXPECT_EQ(audio_get_processed_frequency_q16(0), AUDIO_HZ_Q16(440) + 0x8000);
+    EXPECT_EQ(audio_get_processed_frequency(0), 440.5f);
+
+    // Negative pitches are the same tone.
+    audio_stop_tone(-440.5f);
+    EXPECT_FALSE(audio_is_playing_note());
+    EXPECT_EQ(audio_get_processed_frequency_q16(0), 0);
+}
+
+TEST_F(AudioTest, CompactSongQueueDroppedOnStop) {
+    static const audio_compact_note_t song[] = {{440, 64}};
+
+    audio_on();
+    audio_stop_all();
+    audio_set_tempo(120);
+
+    audio_play_compact_song(song, 1, false);
+    EXPECT_TRUE(audio_queue_compact_song(song, 1));
+    audio_stop_all();
+    EXPECT_FALSE(audio_is_playing_melody());
+
+    audio_play_compact_song(song, 1, false);
+    advance_time(500);
+    audio_update_state();
+    EXPECT_FALSE(audio_is_playing_melody());
+}
+
 } // namespace
@@ -0,0 +1 @@
+DYNAMIC_MACRO_ENABLE = yes
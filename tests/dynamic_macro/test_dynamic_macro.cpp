@@ -0,0 +1,236 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycodes.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_macro_init();
+    }
+
+    void TearDown() override {
+        dynamic_macro_stop_recording();
+        TestFixture::TearDown();
+    }
+
+    void record(KeymapKey &rec, KeymapKey &stop, std::initializer_list<KeymapKey *> keys) {
+        tap_key(rec);
+        for (auto key : keys) {
+            tap_key(*key);
+        }
+        tap_key(stop);
+    }
+
+    void play(KeymapKey &ply) {
+        tap_key(ply);
+        for (int i = 0; i < 20; i++) {
+            run_one_scan_loop();
+        }
+    }
+};
+
+TEST_F(DynamicMacro, RecordAndPlay) {
+    TestDriver driver;
+    KeymapKey  key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  key_ply  = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a    = KeymapKey(0, 3, 0, KC_A);
+    KeymapKey  key_b    = KeymapKey(0, 4, 0, KC_B);
+
+    set_keymap({key_rec, key_stop, key_ply, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    record(key_rec, key_stop, {&key_a, &key_b});
+    VERIFY_AND_CLEAR(driver);
+
+    // Four events of two bytes each
+    EXPECT_EQ(dynamic_macro_get_length(0), 8);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    play(key_ply);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+}
+
+TEST_F(DynamicMacro, PlaybackDoesNotBlock) {
+    TestDriver driver;
+    KeymapKey  key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  key_ply  = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_a    = KeymapKey(0, 3, 0, KC_A);
+    KeymapKey  key_b    = KeymapKey(0, 4, 0, KC_B);
+
+    set_keymap({key_rec, key_stop, key_ply, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    record(key_rec, key_stop, {&key_a, &key_b});
+    VERIFY_AND_CLEAR(driver);
+
+    // Playback starts on release, then each scan sends one event
+    EXPECT_REPORT(driver, (KC_A));
+    tap_key(key_ply);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    play(key_ply);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, HeldKeysAreTrimmed) {
+    TestDriver driver;
+    KeymapKey  key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop = KeymapKey(1, 2, 0, DM_RSTP);
+    KeymapKey  key_mo   = KeymapKey(0, 1, 0, MO(1));
+    KeymapKey  key_a    = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({key_rec, key_stop, key_mo, key_a});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec);
+    tap_key(key_a);
+    key_mo.press();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    key_mo.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Only the tap of A remains, the MO(1) press is dropped
+    EXPECT_EQ(dynamic_macro_get_length(0), 4);
+}
+
+TEST_F(DynamicMacro, SlotsShareTheBuffer) {
+    TestDriver driver;
+    KeymapKey  key_rec1 = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  key_rec2 = KeymapKey(0, 0, 1, DM_REC2);
+    KeymapKey  key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  key_ply2 = KeymapKey(0, 2, 1, DM_PLY2);
+    KeymapKey  key_a    = KeymapKey(0, 3, 0, KC_A);
+    KeymapKey  key_b    = KeymapKey(0, 4, 0, KC_B);
+    KeymapKey  key_c    = KeymapKey(0, 5, 0, KC_C);
+
+    set_keymap({key_rec1, key_rec2, key_stop, key_ply2, key_a, key_b, key_c});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    record(key_rec1, key_stop, {&key_a});
+    record(key_rec2, key_stop, {&key_b});
+    uint16_t free_space = dynamic_macro_get_free_space();
+
+    // Re-recording the first macro moves the second one down
+    record(key_rec1, key_stop, {&key_a, &key_c});
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(dynamic_macro_get_length(0), 8);
+    EXPECT_EQ(dynamic_macro_get_length(1), 4);
+    EXPECT_EQ(dynamic_macro_get_free_space(), free_space - 4);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    play(key_ply2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, FullBufferDropsFurtherEvents) {
+    TestDriver driver;
+    KeymapKey  key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  key_a    = KeymapKey(0, 3, 0, KC_A);
+
+    set_keymap({key_rec, key_stop, key_a});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec);
+    for (int i = 0; i < DYNAMIC_MACRO_BUFFER_SIZE; i++) {
+        tap_key(key_a);
+    }
+    // Still recording, the events that didn't fit are left out
+    EXPECT_TRUE(dynamic_macro_is_recording());
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(dynamic_macro_get_free_space(), 0);
+    EXPECT_EQ(dynamic_macro_get_length(0), DYNAMIC_MACRO_BUFFER_SIZE);
+}
+
+TEST_F(DynamicMacro, TappedModTapReplaysAsTap) {
+    TestDriver driver;
+    KeymapKey  key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  key_ply  = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_mt   = KeymapKey(0, 3, 0, LSFT_T(KC_A));
+
+    set_keymap({key_rec, key_stop, key_ply, key_mt});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec);
+    tap_key(key_mt);
+    run_one_scan_loop();
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // The tap count is kept, which takes the long form
+    EXPECT_EQ(dynamic_macro_get_length(0), 8);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    play(key_ply);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicMacro, PlaybackLayersDoNotLeak) {
+    TestDriver driver;
+    KeymapKey  key_rec  = KeymapKey(0, 0, 0, DM_REC1);
+    KeymapKey  key_stop = KeymapKey(0, 1, 0, DM_RSTP);
+    KeymapKey  key_ply  = KeymapKey(0, 2, 0, DM_PLY1);
+    KeymapKey  key_mo   = KeymapKey(0, 3, 0, MO(1));
+    KeymapKey  key_a    = KeymapKey(0, 4, 0, KC_A);
+    KeymapKey  key_b    = KeymapKey(1, 4, 0, KC_B);
+
+    set_keymap({key_rec, key_stop, key_ply, key_mo, key_a, key_b});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    tap_key(key_rec);
+    key_mo.press();
+    run_one_scan_loop();
+    tap_key(key_b);
+    key_mo.release();
+    run_one_scan_loop();
+    tap_key(key_stop);
+    VERIFY_AND_CLEAR(driver);
+
+    // The macro's MO(1) is only in effect for its own events
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_ply);
+    EXPECT_TRUE(dynamic_macro_is_playing());
+    EXPECT_FALSE(layer_state_is(1));
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(1));
+    for (int i = 0; i < 5; i++) {
+        run_one_scan_loop();
+    }
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(dynamic_macro_is_playing());
+}
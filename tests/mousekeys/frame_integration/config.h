@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define MOUSEKEY_FRAME_INTEGRATION
+#define MOUSEKEY_INTERVAL 8
@@ -0,0 +1,179 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+
+class MousekeyFrameIntegration : public TestFixture {};
+
+TEST_F(MousekeyFrameIntegration, TapMovesOnePixel) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_RIGHT};
+
+    set_keymap({mouse_key});
+
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Nothing is left to report once the key is released, not even an empty report
+    EXPECT_NO_MOUSE_REPORT(driver);
+    mouse_key.release();
+    run_one_scan_loop();
+    idle_for(MOUSEKEY_INTERVAL * 2);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MousekeyFrameIntegration, SlowSpeedCarriesSubPixelRemainder) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_LEFT};
+
+    set_keymap({mouse_key});
+
+    EXPECT_MOUSE_REPORT(driver, (-1, 0, 0, 0, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The initial speed is a tenth of a pixel per frame
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(9);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (-1, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The fraction gathered since is dropped on release, so the next press starts from the same single step
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(5);
+    mouse_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (-1, 0, 0, 0, 0));
+    mouse_key.press();
+    idle_for(MOUSEKEY_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    mouse_key.release();
+    run_one_scan_loop();
+}
+
+TEST_F(MousekeyFrameIntegration, AtMostOneReportPerInterval) {
+    TestDriver driver;
+    KeymapKey  accel_key = KeymapKey{0, 0, 0, QK_MOUSE_ACCELERATION_2};
+    KeymapKey  mouse_key = KeymapKey{0, 1, 0, QK_MOUSE_CURSOR_DOWN};
+
+    set_keymap({accel_key, mouse_key});
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    accel_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 1, 0, 0, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 3 pixels per frame pile up until the interval has passed, then go out in a single report
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(MOUSEKEY_INTERVAL - 1);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 3 * MOUSEKEY_INTERVAL, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 3 * MOUSEKEY_INTERVAL, 0, 0, 0));
+    idle_for(MOUSEKEY_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    mouse_key.release();
+    accel_key.release();
+    run_one_scan_loop();
+}
+
+TEST_F(MousekeyFrameIntegration, DiagonalIsScaled) {
+    TestDriver driver;
+    KeymapKey  accel_key = KeymapKey{0, 0, 0, QK_MOUSE_ACCELERATION_2};
+    KeymapKey  right_key = KeymapKey{0, 1, 0, QK_MOUSE_CURSOR_RIGHT};
+    KeymapKey  up_key    = KeymapKey{0, 2, 0, QK_MOUSE_CURSOR_UP};
+
+    set_keymap({accel_key, right_key, up_key});
+
+    accel_key.press();
+    run_one_scan_loop();
+
+    EXPECT_MOUSE_REPORT(driver, (1, -1, 0, 0, 0));
+    right_key.press();
+    up_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 3000 * 181 / 256 = 2121 thousandths of a pixel per frame on each axis
+    EXPECT_MOUSE_REPORT(driver, (16, -16, 0, 0, 0));
+    idle_for(MOUSEKEY_INTERVAL);
+    VERIFY_AND_CLEAR(driver);
+
+    right_key.release();
+    up_key.release();
+    accel_key.release();
+    run_one_scan_loop();
+}
+
+TEST_F(MousekeyFrameIntegration, WheelIntegratesDetents) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_WHEEL_UP};
+
+    set_keymap({mouse_key});
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 16 detents per second, picking up to 17 after 50ms -- the next one is due after 62 frames
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(61);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    mouse_key.release();
+    run_one_scan_loop();
+}
+
+TEST_F(MousekeyFrameIntegration, ButtonsAreSentStraightAway) {
+    TestDriver driver;
+    KeymapKey  move_key   = KeymapKey{0, 0, 0, QK_MOUSE_CURSOR_RIGHT};
+    KeymapKey  button_key = KeymapKey{0, 1, 0, QK_MOUSE_BUTTON_1};
+
+    set_keymap({move_key, button_key});
+
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    move_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Within the interval of the last report, but a button change can't wait
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 0, 1));
+    button_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_MOUSE_REPORT(driver);
+    button_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    move_key.release();
+    run_one_scan_loop();
+}
@@ -0,0 +1,385 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "painter_host.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" {
+#include "qgf.h"
+#include "qff.h"
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Host rendering backend
+
+namespace {
+
+surface_painter_driver_vtable_t  counting_vtable;
+const painter_driver_vtable_t   *original_vtable = nullptr;
+std::vector<PainterHost *>       active_hosts;
+
+} // namespace
+
+PainterHost::PainterHost(uint16_t width, uint16_t height) : surface{}, buffer((size_t)width * height), counters{} {
+    painter_device_t device = qp_make_rgb565_surface_advanced(&surface, 1, width, height, buffer.data());
+
+    // Wrap the surface vtable so that everything streamed into the device gets counted
+    if (!original_vtable) {
+        original_vtable                      = surface.base.driver_vtable;
+        counting_vtable                      = *(const surface_painter_driver_vtable_t *)original_vtable;
+        counting_vtable.base.viewport        = counting_viewport;
+        counting_vtable.base.pixdata         = counting_pixdata;
+    }
+    surface.base.driver_vtable = (const painter_driver_vtable_t *)&counting_vtable;
+
+    active_hosts.push_back(this);
+    qp_init(device, QP_ROTATION_0);
+    reset_stats();
+}
+
+PainterHost::~PainterHost() {
+    active_hosts.erase(std::remove(active_hosts.begin(), active_hosts.end(), this), active_hosts.end());
+}
+
+PainterHost *PainterHost::from_device(painter_device_t device) {
+    for (auto host : active_hosts) {
+        if (host->device() == device) {
+            return host;
+        }
+    }
+    return nullptr;
+}
+
+bool PainterHost::counting_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    PainterHost *host = from_device(device);
+    if (host) {
+        host->counters.viewports++;
+    }
+    return original_vtable->viewport(device, left, top, right, bottom);
+}
+
+bool PainterHost::counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
+    PainterHost *host = from_device(device);
+    if (host) {
+        host->counters.transfers++;
+        host->counters.pixels += native_pixel_count;
+        host->counters.bytes += native_pixel_count * sizeof(uint16_t);
+    }
+    return original_vtable->pixdata(device, pixel_data, native_pixel_count);
+}
+
+void PainterHost::reset_stats() {
+    counters = Stats{};
+}
+
+uint16_t PainterHost::pixel(uint16_t x, uint16_t y) const {
+    // The surface holds pixels byte-swapped, ready for streaming to a panel
+    uint16_t v = buffer[(size_t)y * width() + x];
+    return (uint16_t)((v >> 8) | (v << 8));
+}
+
+uint32_t PainterHost::lit_pixels(uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) const {
+    uint32_t count = 0;
+    for (uint16_t y = top; y <= bottom; ++y) {
+        for (uint16_t x = left; x <= right; ++x) {
+            if (pixel(x, y) != 0) {
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+std::vector<std::string> PainterHost::to_text(const std::vector<std::pair<uint16_t, char>> &legend) const {
+    std::vector<std::string> rows;
+    for (uint16_t y = 0; y < height(); ++y) {
+        std::string row(width(), '?');
+        for (uint16_t x = 0; x < width(); ++x) {
+            for (auto &entry : legend) {
+                if (entry.first == pixel(x, y)) {
+                    row[x] = entry.second;
+                    break;
+                }
+            }
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+namespace {
+
+uint32_t png_crc(const uint8_t *data, size_t len, uint32_t crc = 0) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+void put_be32(std::vector<uint8_t> &out, uint32_t v) {
+    out.push_back(v >> 24);
+    out.push_back(v >> 16);
+    out.push_back(v >> 8);
+    out.push_back(v);
+}
+
+void put_png_chunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data) {
+    put_be32(out, data.size());
+    std::vector<uint8_t> body(type, type + 4);
+    body.insert(body.end(), data.begin(), data.end());
+    out.insert(out.end(), body.begin(), body.end());
+    put_be32(out, png_crc(body.data(), body.size()));
+}
+
+} // namespace
+
+bool PainterHost::write_png(const std::string &path) const {
+    // Raw scanlines, each prefixed with filter type 0
+    std::vector<uint8_t> raw;
+    for (uint16_t y = 0; y < height(); ++y) {
+        raw.push_back(0);
+        for (uint16_t x = 0; x < width(); ++x) {
+            uint16_t v = pixel(x, y);
+            uint8_t  r = (v >> 11) & 0x1F, g = (v >> 5) & 0x3F, b = v & 0x1F;
+            raw.push_back((r << 3) | (r >> 2));
+            raw.push_back((g << 2) | (g >> 4));
+            raw.push_back((b << 3) | (b >> 2));
+        }
+    }
+
+    // zlib stream using stored (uncompressed) deflate blocks -- output size doesn't matter here
+    std::vector<uint8_t> zlib = {0x78, 0x01};
+    size_t               pos  = 0;
+    do {
+        size_t len = std::min<size_t>(raw.size() - pos, 0xFFFF);
+        zlib.push_back(pos + len == raw.size() ? 1 : 0);
+        zlib.push_back(len & 0xFF);
+        zlib.push_back(len >> 8);
+        zlib.push_back(~len & 0xFF);
+        zlib.push_back((~len >> 8) & 0xFF);
+        zlib.insert(zlib.end(), raw.begin() + pos, raw.begin() + pos + len);
+        pos += len;
+    } while (pos < raw.size());
+    uint32_t a = 1, b = 0;
+    for (auto c : raw) {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+    put_be32(zlib, (b << 16) | a);
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> ihdr;
+    put_be32(ihdr, width());
+    put_be32(ihdr, height());
+    ihdr.insert(ihdr.end(), {8, 2, 0, 0, 0}); // 8-bit depth, truecolour, no interlace
+    put_png_chunk(png, "IHDR", ihdr);
+    put_png_chunk(png, "IDAT", zlib);
+    put_png_chunk(png, "IEND", {});
+
+    FILE *fp = fopen(path.c_str(), "wb");
+    if (!fp) {
+        return false;
+    }
+    bool ok = fwrite(png.data(), 1, png.size(), fp) == png.size();
+    fclose(fp);
+    return ok;
+}
+
+void PainterHost::dump(const std::string &name) const {
+    const char *dir = getenv("QP_TEST_OUTPUT_DIR");
+    if (dir && *dir) {
+        // Parameterised test names contain slashes
+        std::string filename = name;
+        std::replace(filename.begin(), filename.end(), '/', '_');
+        write_png(std::string(dir) + "/" + filename + ".png");
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QGF/QFF generation
+
+std::vector<uint8_t> qp_test_pack_pixels(qp_image_format_t format, const std::vector<uint16_t> &values) {
+    std::vector<uint8_t> out;
+    if (format == RGB565_16BPP) {
+        for (auto v : values) {
+            out.push_back(v >> 8);
+            out.push_back(v & 0xFF);
+        }
+        return out;
+    }
+
+    uint8_t bpp;
+    bool    has_palette, is_panel_native;
+    qgf_parse_format(format, &bpp, &has_palette, &is_panel_native);
+
+    // Pixels are packed least-significant bits first
+    const uint8_t pixels_per_byte = 8 / bpp;
+    for (size_t i = 0; i < values.size(); i += pixels_per_byte) {
+        uint8_t b = 0;
+        for (uint8_t q = 0; q < pixels_per_byte && i + q < values.size(); ++q) {
+            b |= (values[i + q] & ((1 << bpp) - 1)) << (q * bpp);
+        }
+        out.push_back(b);
+    }
+    return out;
+}
+
+std::vector<uint8_t> qp_test_rle_encode(const std::vector<uint8_t> &data) {
+    std::vector<uint8_t> out;
+    size_t               i = 0;
+    while (i < data.size()) {
+        // Repeated runs are at most 127 bytes long
+        size_t run = 1;
+        while (i + run < data.size() && run < 127 && data[i + run] == data[i]) {
+            ++run;
+        }
+        if (run >= 3) {
+            out.push_back(run);
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+
+        // Otherwise emit literals until the next worthwhile run, at most 128 bytes long
+        size_t start = i;
+        while (i < data.size() && i - start < 128) {
+            if (i + 2 < data.size() && data[i] == data[i + 1] && data[i] == data[i + 2]) {
+                break;
+            }
+            ++i;
+        }
+        out.push_back(127 + (i - start));
+        out.insert(out.end(), data.begin() + start, data.begin() + i);
+    }
+    return out;
+}
+
+namespace {
+
+// Matches `QFFFontDataDescriptorV1` in the python font converter
+constexpr uint8_t qff_font_data_typeid = 0x04;
+
+void put_le(std::vector<uint8_t> &out, uint32_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back((v >> (8 * i)) & 0xFF);
+    }
+}
+
+void put_block_header(std::vector<uint8_t> &out, uint8_t type_id, uint32_t length) {
+    out.push_back(type_id);
+    out.push_back(~type_id);
+    put_le(out, length, 3);
+}
+
+void patch_file_size(std::vector<uint8_t> &out, size_t offset) {
+    uint32_t total = out.size();
+    for (int i = 0; i < 4; ++i) {
+        out[offset + i]     = (total >> (8 * i)) & 0xFF;
+        out[offset + 4 + i] = (~total >> (8 * i)) & 0xFF;
+    }
+}
+
+} // namespace
+
+std::vector<uint8_t> qp_test_make_qgf(uint16_t width, uint16_t height, const std::vector<QgfFrameSpec> &frames) {
+    std::vector<uint8_t> out;
+
+    // Graphics descriptor, file size patched in at the end
+    put_block_header(out, QGF_GRAPHICS_DESCRIPTOR_TYPEID, sizeof(qgf_graphics_descriptor_v1_t) - sizeof(qgf_block_header_v1_t));
+    put_le(out, QGF_MAGIC, 3);
+    out.push_back(0x01);
+    size_t size_offset = out.size();
+    put_le(out, 0, 4);
+    put_le(out, 0, 4);
+    put_le(out, width, 2);
+    put_le(out, height, 2);
+    put_le(out, frames.size(), 2);
+
+    // Frame offsets, patched in as each frame is written
+    put_block_header(out, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, frames.size() * sizeof(uint32_t));
+    size_t offsets_offset = out.size();
+    out.resize(out.size() + frames.size() * sizeof(uint32_t));
+
+    for (size_t n = 0; n < frames.size(); ++n) {
+        const QgfFrameSpec &frame = frames[n];
+        for (int i = 0; i < 4; ++i) {
+            out[offsets_offset + n * 4 + i] = (out.size() >> (8 * i)) & 0xFF;
+        }
+
+        put_block_header(out, QGF_FRAME_DESCRIPTOR_TYPEID, sizeof(qgf_frame_v1_t) - sizeof(qgf_block_header_v1_t));
+        out.push_back(frame.format);
+        out.push_back(frame.is_delta ? QGF_FRAME_FLAG_DELTA : 0);
+        out.push_back(frame.compression);
+        out.push_back(0xFF);
+        put_le(out, frame.delay, 2);
+
+        if (!frame.palette.empty()) {
+            put_block_header(out, QGF_FRAME_PALETTE_DESCRIPTOR_TYPEID, frame.palette.size() * sizeof(qgf_palette_entry_v1_t));
+            for (auto &hsv : frame.palette) {
+                out.insert(out.end(), hsv.begin(), hsv.end());
+            }
+        }
+
+        if (frame.is_delta) {
+            put_block_header(out, QGF_FRAME_DELTA_DESCRIPTOR_TYPEID, sizeof(qgf_delta_v1_t) - sizeof(qgf_block_header_v1_t));
+            put_le(out, frame.left, 2);
+            put_le(out, frame.top, 2);
+            put_le(out, frame.right, 2);
+            put_le(out, frame.bottom, 2);
+        }
+
+        std::vector<uint8_t> data = qp_test_pack_pixels(frame.format, frame.values);
+        if (frame.compression == IMAGE_COMPRESSED_RLE) {
+            data = qp_test_rle_encode(data);
+        }
+        put_block_header(out, QGF_FRAME_DATA_DESCRIPTOR_TYPEID, data.size());
+        out.insert(out.end(), data.begin(), data.end());
+    }
+
+    patch_file_size(out, size_offset);
+    return out;
+}
+
+std::vector<uint8_t> qp_test_make_qff(uint8_t line_height, qp_image_format_t format, painter_compression_t compression, const std::vector<std::vector<uint16_t>> &glyph_values, const std::vector<uint8_t> &glyph_widths) {
+    std::vector<uint8_t> out;
+
+    // Font descriptor, file size patched in at the end
+    put_block_header(out, QFF_FONT_DESCRIPTOR_TYPEID, sizeof(qff_font_descriptor_v1_t) - sizeof(qgf_block_header_v1_t));
+    put_le(out, QFF_MAGIC, 3);
+    out.push_back(0x01);
+    size_t size_offset = out.size();
+    put_le(out, 0, 4);
+    put_le(out, 0, 4);
+    out.push_back(line_height);
+    out.push_back(1); // has ascii table
+    put_le(out, 0, 2); // no unicode glyphs
+    out.push_back(format);
+    out.push_back(0);
+    out.push_back(compression);
+    out.push_back(0xFF);
+
+    // Each glyph is packed (and compressed) individually, so it can be located directly from its table entry
+    std::vector<uint8_t> data;
+    put_block_header(out, QFF_ASCII_GLYPH_DESCRIPTOR_TYPEID, 95 * sizeof(qff_ascii_glyph_v1_t));
+    for (size_t n = 0; n < 95; ++n) {
+        put_le(out, ((data.size() << QFF_GLYPH_WIDTH_BITS) & QFF_GLYPH_OFFSET_MASK) | (glyph_widths[n] & QFF_GLYPH_WIDTH_MASK), 3);
+        std::vector<uint8_t> glyph = qp_test_pack_pixels(format, glyph_values[n]);
+        if (compression == IMAGE_COMPRESSED_RLE) {
+            glyph = qp_test_rle_encode(glyph);
+        }
+        data.insert(data.end(), glyph.begin(), glyph.end());
+    }
+
+    put_block_header(out, qff_font_data_typeid, data.size());
+    out.insert(out.end(), data.begin(), data.end());
+
+    patch_file_size(out, size_offset);
+    return out;
+}
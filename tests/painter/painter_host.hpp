@@ -0,0 +1,106 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include "qp_internal.h"
+#include "qp_surface_internal.h"
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Host rendering backend
+
+/**
+ * An RGB565 surface living in host memory, standing in for a real display.
+ *
+ * The surface's driver vtable is wrapped so that every viewport change and every chunk of pixel data streamed into the
+ * device is counted, which is the same traffic a real panel would see over SPI/I2C. Frames can be rendered as text for
+ * golden comparisons and written out as PNG files for inspection.
+ */
+class PainterHost {
+   public:
+    struct Stats {
+        uint32_t viewports;
+        uint32_t transfers;
+        uint64_t pixels;
+        uint64_t bytes;
+    };
+
+    PainterHost(uint16_t width, uint16_t height);
+    ~PainterHost();
+
+    PainterHost(const PainterHost &) = delete;
+    PainterHost &operator=(const PainterHost &) = delete;
+
+    painter_device_t device() {
+        return (painter_device_t)&surface;
+    }
+    uint16_t width() const {
+        return surface.base.panel_width;
+    }
+    uint16_t height() const {
+        return surface.base.panel_height;
+    }
+
+    // Native RGB565 value of the pixel at the given location
+    uint16_t pixel(uint16_t x, uint16_t y) const;
+
+    // Number of pixels in the given region which aren't black
+    uint32_t lit_pixels(uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) const;
+
+    // The current frame as text, one row per string and one character per pixel, mapping native RGB565 values to
+    // characters through `legend` -- pixels with a value not listed there are rendered as '?'
+    std::vector<std::string> to_text(const std::vector<std::pair<uint16_t, char>> &legend) const;
+
+    const Stats &stats() const {
+        return counters;
+    }
+    void reset_stats();
+
+    // Writes the current frame as an RGB PNG
+    bool write_png(const std::string &path) const;
+
+    // Writes the current frame to `$QP_TEST_OUTPUT_DIR/<name>.png`, if the environment variable is set
+    void dump(const std::string &name) const;
+
+   private:
+    static bool counting_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom);
+    static bool counting_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count);
+    static PainterHost *from_device(painter_device_t device);
+
+    surface_painter_device_t surface;
+    std::vector<uint16_t>    buffer;
+    Stats                    counters;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// QGF/QFF generation
+
+// Packs one value per pixel (grayscale level, palette index, or RGB565 colour) into the byte layout used by `format`
+std::vector<uint8_t> qp_test_pack_pixels(qp_image_format_t format, const std::vector<uint16_t> &values);
+
+// Compresses data using the QMK RLE scheme understood by Quantum Painter
+std::vector<uint8_t> qp_test_rle_encode(const std::vector<uint8_t> &data);
+
+struct QgfFrameSpec {
+    qp_image_format_t                   format;
+    painter_compression_t               compression;
+    uint16_t                            delay;
+    std::vector<std::array<uint8_t, 3>> palette; // HSV entries, only used by palette formats
+    bool                                is_delta;
+    uint16_t                            left, top, right, bottom; // delta region, inclusive
+    std::vector<uint16_t>               values;                   // one value per pixel in the frame (or delta region)
+};
+
+// Builds a QGF image in memory, equivalent to the output of `qmk painter-convert-graphics`
+std::vector<uint8_t> qp_test_make_qgf(uint16_t width, uint16_t height, const std::vector<QgfFrameSpec> &frames);
+
+// Builds a QFF font in memory containing the full ASCII table; each glyph is a `width` x `line_height` grid of values
+std::vector<uint8_t> qp_test_make_qff(uint8_t line_height, qp_image_format_t format, painter_compression_t compression, const std::vector<std::vector<uint16_t>> &glyph_values, const std::vector<uint8_t> &glyph_widths);
@@ -0,0 +1,425 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "painter_host.hpp"
+
+extern "C" {
+#include "color.h"
+#include "qgf.h"
+void advance_time(uint32_t ms);
+void qp_internal_task(void);
+}
+
+namespace {
+
+constexpr uint16_t kWidth  = 64;
+constexpr uint16_t kHeight = 64;
+
+uint16_t rgb565_from_hsv(uint8_t h, uint8_t s, uint8_t v) {
+    hsv_t hsv = {h, s, v};
+    rgb_t rgb = hsv_to_rgb_nocie(hsv);
+    return (((uint16_t)rgb.r) >> 3) << 11 | (((uint16_t)rgb.g) >> 2) << 5 | (((uint16_t)rgb.b) >> 3);
+}
+
+// Test pattern with flat bands on the left half (so RLE has something to work with) and noise on the right
+std::vector<uint16_t> make_pattern(uint16_t w, uint16_t h, uint16_t levels) {
+    std::vector<uint16_t> values;
+    for (uint16_t y = 0; y < h; ++y) {
+        for (uint16_t x = 0; x < w; ++x) {
+            values.push_back((x < w / 2 ? (y / 2) : (x * 7 + y * 13)) % levels);
+        }
+    }
+    return values;
+}
+
+std::vector<std::array<uint8_t, 3>> make_palette(uint16_t levels) {
+    std::vector<std::array<uint8_t, 3>> palette;
+    for (uint16_t i = 0; i < levels; ++i) {
+        palette.push_back({(uint8_t)(i * 256 / levels), 255, 255});
+    }
+    return palette;
+}
+
+// Compares two frames rendered with PainterHost::to_text(), describing where they differ
+::testing::AssertionResult frames_match(const std::vector<std::string> &actual, const std::vector<std::string> &expected) {
+    if (actual == expected) {
+        return ::testing::AssertionSuccess();
+    }
+    if (actual.size() != expected.size() || actual[0].size() != expected[0].size()) {
+        return ::testing::AssertionFailure() << "frame is " << actual[0].size() << "x" << actual.size() << ", expected " << expected[0].size() << "x" << expected.size();
+    }
+
+    ::testing::AssertionResult failure    = ::testing::AssertionFailure();
+    uint32_t                   mismatches = 0;
+    for (size_t y = 0; y < actual.size(); ++y) {
+        for (size_t x = 0; x < actual[y].size(); ++x) {
+            if (actual[y][x] != expected[y][x] && mismatches++ < 8) {
+                failure << "(" << x << ", " << y << "): '" << actual[y][x] << "', expected '" << expected[y][x] << "'\n";
+            }
+        }
+    }
+    failure << mismatches << " pixel(s) differ, actual frame:\n";
+    for (auto &row : actual) {
+        failure << row << "\n";
+    }
+    return failure;
+}
+
+QgfFrameSpec make_frame(qp_image_format_t format, painter_compression_t compression, const std::vector<uint16_t> &values) {
+    QgfFrameSpec frame{};
+    frame.format      = format;
+    frame.compression = compression;
+    frame.values      = values;
+    return frame;
+}
+
+} // namespace
+
+class QuantumPainter : public ::testing::Test {
+   protected:
+    PainterHost host{kWidth, kHeight};
+
+    void TearDown() override {
+        const ::testing::TestInfo *info = ::testing::UnitTest::GetInstance()->current_test_info();
+        host.dump(std::string(info->test_suite_name()) + "." + info->name());
+    }
+};
+
+TEST_F(QuantumPainter, SurfaceStartsCleared) {
+    EXPECT_EQ(host.lit_pixels(0, 0, kWidth - 1, kHeight - 1), 0);
+}
+
+TEST_F(QuantumPainter, FilledRectCoversExactRegion) {
+    ASSERT_TRUE(qp_rect(host.device(), 10, 12, 19, 15, 0, 0, 255, true));
+    EXPECT_EQ(host.lit_pixels(0, 0, kWidth - 1, kHeight - 1), 10 * 4);
+    EXPECT_EQ(host.lit_pixels(10, 12, 19, 15), 10 * 4);
+    EXPECT_EQ(host.pixel(10, 12), 0xFFFF);
+    EXPECT_EQ(host.pixel(9, 12), 0x0000);
+    EXPECT_EQ(host.pixel(20, 15), 0x0000);
+}
+
+TEST_F(QuantumPainter, OutlineRectOnlyDrawsBorder) {
+    ASSERT_TRUE(qp_rect(host.device(), 10, 10, 19, 19, 0, 255, 255, false));
+    EXPECT_EQ(host.lit_pixels(0, 0, kWidth - 1, kHeight - 1), 4 * 9);
+    EXPECT_EQ(host.lit_pixels(11, 11, 18, 18), 0);
+    EXPECT_EQ(host.pixel(10, 10), rgb565_from_hsv(0, 255, 255));
+}
+
+TEST_F(QuantumPainter, SetPixelAndLines) {
+    ASSERT_TRUE(qp_setpixel(host.device(), 3, 4, 0, 0, 255));
+    EXPECT_EQ(host.pixel(3, 4), 0xFFFF);
+
+    ASSERT_TRUE(qp_line(host.device(), 0, 20, kWidth - 1, 20, 0, 0, 255));
+    EXPECT_EQ(host.lit_pixels(0, 20, kWidth - 1, 20), kWidth);
+
+    ASSERT_TRUE(qp_line(host.device(), 30, 30, 40, 40, 0, 0, 255));
+    for (uint16_t i = 30; i <= 40; ++i) {
+        EXPECT_EQ(host.pixel(i, i), 0xFFFF);
+    }
+}
+
+TEST_F(QuantumPainter, CircleIsSymmetric) {
+    ASSERT_TRUE(qp_circle(host.device(), 32, 32, 10, 0, 0, 255, true));
+    for (uint16_t y = 0; y < kHeight; ++y) {
+        for (uint16_t x = 0; x < kWidth; ++x) {
+            ASSERT_EQ(host.pixel(x, y), host.pixel(64 - x < kWidth ? 64 - x : x, y)) << "x=" << x << " y=" << y;
+            ASSERT_EQ(host.pixel(x, y), host.pixel(x, 64 - y < kHeight ? 64 - y : y)) << "x=" << x << " y=" << y;
+        }
+    }
+    EXPECT_EQ(host.pixel(32, 32), 0xFFFF);
+    EXPECT_EQ(host.pixel(32, 22), 0xFFFF);
+    EXPECT_EQ(host.pixel(32, 21), 0x0000);
+}
+
+TEST_F(QuantumPainter, SceneMatchesGolden) {
+    ASSERT_TRUE(qp_rect(host.device(), 0, 0, kWidth - 1, kHeight - 1, 170, 255, 64, true));
+    ASSERT_TRUE(qp_circle(host.device(), 20, 20, 12, 0, 255, 255, true));
+    ASSERT_TRUE(qp_circle(host.device(), 44, 44, 12, 85, 255, 255, false));
+    ASSERT_TRUE(qp_ellipse(host.device(), 40, 16, 14, 6, 43, 255, 255, true));
+    ASSERT_TRUE(qp_line(host.device(), 0, kHeight - 1, kWidth - 1, 0, 0, 0, 255));
+    ASSERT_TRUE(qp_rect(host.device(), 4, 48, 20, 60, 213, 128, 255, false));
+
+    // If rendering changes intentionally, run with QP_TEST_OUTPUT_DIR set, inspect the PNG and update the golden frame
+    const std::vector<std::pair<uint16_t, char>> legend = {
+        {rgb565_from_hsv(170, 255, 64), '.'}, {rgb565_from_hsv(0, 255, 255), 'R'}, {rgb565_from_hsv(85, 255, 255), 'G'}, {rgb565_from_hsv(43, 255, 255), 'Y'}, {rgb565_from_hsv(0, 0, 255), 'W'}, {rgb565_from_hsv(213, 128, 255), 'P'},
+    };
+    const std::vector<std::string> golden = {
+        "...............................................................W",
+        "..............................................................W.",
+        ".............................................................W..",
+        "............................................................W...",
+        "...........................................................W....",
+        "..........................................................W.....",
+        ".........................................................W......",
+        "........................................................W.......",
+        "....................R..................................W........",
+        "................RRRRRRRRR.............................W.........",
+        "..............RRRRRRRRRRRRR........YYYYYYYYYYY.......W..........",
+        ".............RRRRRRRRRRRRRRR...YYYYYYYYYYYYYYGGGGG..W...........",
+        "............RRRRRRRRRRRRRRRRRYYYYYYYYYYYYYYGGGGGGGGW............",
+        "...........RRRRRRRRRRRRRRRRRYYYYYYYYYYYYYYGGGGGGGGWGG...........",
+        "..........RRRRRRRRRRRRRRRRRYYYYYYYYYYYYYYGGGGGGGGWGG............",
+        "..........RRRRRRRRRRRRRRRRYYYYYYYYYYYYYYGGGGGGGGWGG.............",
+        ".........RRRRRRRRRRRRRRRRRYYYYYYYYYYYYYYGGGGGGGWGGG.............",
+        ".........RRRRRRRRRRRRRRRRRYYYYYYYYYYYYYYGGGGGGWGGGG.............",
+        ".........RRRRRRRRRRRRRRRRRRYYYYYYYYYYYYYYGGGGWGGGGGG............",
+        ".........RRRRRRRRRRRRRRRRRRRYYYYYYYYYYYYYYGGWGGGGGGGG...........",
+        "........RRRRRRRRRRRRRRRRRRRRRYYYYYYYYYYYYYYWGGGGGGGG............",
+        ".........RRRRRRRRRRRRRRRRRRRRRRYYYYYYYYYYYWYYGGGGG..............",
+        ".........RRRRRRRRRRRRRRRRRRRRRRR...YYYYYYWYYYY..................",
+        ".........RRRRRRRRRRRRRRRRRRRRRRR........W.......................",
+        ".........RRRRRRRRRRRRRRRRRRRRRRR.......W........................",
+        "..........RRRRRRRRRRRRRRRRRRRRR.......W.........................",
+        "..........RRRRRRRRRRRRRRRRRRRRR......W..........................",
+        "...........RRRRRRRRRRRRRRRRRRR......W...........................",
+        "............RRRRRRRRRRRRRRRRR......W............................",
+        ".............RRRRRRRRRRRRRRR......W.............................",
+        "..............RRRRRRRRRRRRR......W..............................",
+        "................RRRRRRRRR.......W...............................",
+        "....................R..........W............G...................",
+        "..............................W.........GGGG.GGGG...............",
+        ".............................W........GG.........GG.............",
+        "............................W........G.............G............",
+        "...........................W........G...............G...........",
+        "..........................W........G.................G..........",
+        ".........................W........G...................G.........",
+        "........................W.........G...................G.........",
+        ".......................W.........G.....................G........",
+        "......................W..........G.....................G........",
+        ".....................W...........G.....................G........",
+        "....................W............G.....................G........",
+        "...................W............G.......................G.......",
+        "..................W..............G.....................G........",
+        ".................W...............G.....................G........",
+        "................W................G.....................G........",
+        "....PPPPPPPPPPPPPPPPP............G.....................G........",
+        "....P.........W.....P.............G...................G.........",
+        "....P........W......P.............G...................G.........",
+        "....P.......W.......P..............G.................G..........",
+        "....P......W........P...............G...............G...........",
+        "....P.....W.........P................G.............G............",
+        "....P....W..........P.................GG.........GG.............",
+        "....P...W...........P...................GGGG.GGGG...............",
+        "....P..W............P.......................G...................",
+        "....P.W.............P...........................................",
+        "....PW..............P...........................................",
+        "....P...............P...........................................",
+        "...WPPPPPPPPPPPPPPPPP...........................................",
+        "..W.............................................................",
+        ".W..............................................................",
+        "W..............................................................."
+    };
+    EXPECT_TRUE(frames_match(host.to_text(legend), golden));
+}
+
+class QuantumPainterImage : public QuantumPainter, public ::testing::WithParamInterface<qp_image_format_t> {};
+
+TEST_P(QuantumPainterImage, RawAndRleDecodeIdentically) {
+    const qp_image_format_t format = GetParam();
+    uint8_t                 bpp;
+    bool                    has_palette, is_panel_native;
+    qgf_parse_format(format, &bpp, &has_palette, &is_panel_native);
+
+    const uint16_t        levels = is_panel_native ? 0 : (1 << bpp);
+    std::vector<uint16_t> values = make_pattern(64, 24, is_panel_native ? 0xFFFF : levels);
+    if (is_panel_native) {
+        for (auto &v : values) {
+            v = (uint16_t)(v * 0x0841 + 0x1234);
+        }
+    }
+
+    QgfFrameSpec raw = make_frame(format, IMAGE_UNCOMPRESSED, values);
+    QgfFrameSpec rle = make_frame(format, IMAGE_COMPRESSED_RLE, values);
+    if (has_palette) {
+        raw.palette = rle.palette = make_palette(levels);
+    }
+    std::vector<uint8_t> raw_qgf = qp_test_make_qgf(64, 24, {raw});
+    std::vector<uint8_t> rle_qgf = qp_test_make_qgf(64, 24, {rle});
+    if (!is_panel_native) {
+        EXPECT_LT(rle_qgf.size(), raw_qgf.size());
+    }
+
+    painter_image_handle_t raw_image = qp_load_image_mem(raw_qgf.data());
+    painter_image_handle_t rle_image = qp_load_image_mem(rle_qgf.data());
+    ASSERT_NE(raw_image, nullptr);
+    ASSERT_NE(rle_image, nullptr);
+    EXPECT_EQ(raw_image->width, 64);
+    EXPECT_EQ(raw_image->height, 24);
+
+    ASSERT_TRUE(qp_drawimage(host.device(), 0, 0, raw_image));
+    ASSERT_TRUE(qp_drawimage(host.device(), 0, 32, rle_image));
+
+    for (uint16_t y = 0; y < 24; ++y) {
+        for (uint16_t x = 0; x < 64; ++x) {
+            uint16_t value = values[y * 64 + x];
+            uint16_t expected;
+            if (is_panel_native) {
+                expected = value;
+            } else if (has_palette) {
+                expected = rgb565_from_hsv(value * 256 / levels, 255, 255);
+            } else if (value == 0) {
+                expected = 0x0000;
+            } else if (value == levels - 1) {
+                expected = 0xFFFF;
+            } else {
+                expected = host.pixel(x, y); // intermediate grey levels are interpolated, just check raw vs RLE
+            }
+            ASSERT_EQ(host.pixel(x, y), expected) << "x=" << x << " y=" << y;
+            ASSERT_EQ(host.pixel(x, 32 + y), host.pixel(x, y)) << "x=" << x << " y=" << y;
+        }
+    }
+
+    qp_close_image(raw_image);
+    qp_close_image(rle_image);
+}
+
+INSTANTIATE_TEST_CASE_P(Formats, QuantumPainterImage, ::testing::Values(GRAYSCALE_1BPP, GRAYSCALE_2BPP, GRAYSCALE_4BPP, GRAYSCALE_8BPP, PALETTE_1BPP, PALETTE_2BPP, PALETTE_4BPP, PALETTE_8BPP, RGB565_16BPP));
+
+TEST_F(QuantumPainter, TextRendersGlyphs) {
+    // Every glyph is a solid block as wide as (code point % 4) + 2 pixels
+    std::vector<std::vector<uint16_t>> glyphs;
+    std::vector<uint8_t>               widths;
+    for (uint8_t n = 0; n < 95; ++n) {
+        uint8_t w = ((n + 0x20) % 4) + 2;
+        widths.push_back(w);
+        glyphs.push_back(std::vector<uint16_t>(w * 8, n == 0 ? 0 : 1));
+    }
+    std::vector<uint8_t>  qff  = qp_test_make_qff(8, GRAYSCALE_1BPP, IMAGE_COMPRESSED_RLE, glyphs, widths);
+    painter_font_handle_t font = qp_load_font_mem(qff.data());
+    ASSERT_NE(font, nullptr);
+    EXPECT_EQ(font->line_height, 8);
+
+    const char *str = "Hi QMK";
+    int16_t     expected_width = 0;
+    uint32_t    expected_lit   = 0;
+    for (const char *c = str; *c; ++c) {
+        uint8_t w = (*c % 4) + 2;
+        expected_width += w;
+        expected_lit += (*c == ' ') ? 0 : w * 8;
+    }
+    EXPECT_EQ(qp_textwidth(font, str), expected_width);
+    EXPECT_EQ(qp_drawtext(host.device(), 2, 10, font, str), expected_width);
+    EXPECT_EQ(host.lit_pixels(0, 0, kWidth - 1, kHeight - 1), expected_lit);
+    EXPECT_EQ(host.lit_pixels(2, 10, 2 + expected_width - 1, 17), expected_lit);
+
+    qp_close_font(font);
+}
+
+class QuantumPainterAnimation : public QuantumPainter {
+   protected:
+    std::vector<uint8_t>   qgf;
+    painter_image_handle_t image = nullptr;
+
+    void SetUp() override {
+        // Frame 0: full keyframe. Frame 1: delta touching a small square. Frame 2: delta touching another square.
+        std::vector<uint16_t> keyframe(16 * 16, 0);
+        for (uint16_t i = 0; i < 16; ++i) {
+            keyframe[i * 16 + i] = 1;
+        }
+        QgfFrameSpec frame0 = make_frame(GRAYSCALE_1BPP, IMAGE_COMPRESSED_RLE, keyframe);
+        frame0.delay        = 50;
+
+        QgfFrameSpec frame1 = make_frame(GRAYSCALE_1BPP, IMAGE_COMPRESSED_RLE, std::vector<uint16_t>(4 * 4, 1));
+        frame1.delay        = 50;
+        frame1.is_delta     = true;
+        frame1.left         = 2;
+        frame1.top          = 10;
+        frame1.right        = 5;
+        frame1.bottom       = 13;
+
+        QgfFrameSpec frame2 = make_frame(GRAYSCALE_1BPP, IMAGE_COMPRESSED_RLE, std::vector<uint16_t>(2 * 2, 1));
+        frame2.delay        = 50;
+        frame2.is_delta     = true;
+        frame2.left         = 12;
+        frame2.top          = 2;
+        frame2.right        = 13;
+        frame2.bottom       = 3;
+
+        qgf   = qp_test_make_qgf(16, 16, {frame0, frame1, frame2});
+        image = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr);
+        EXPECT_EQ(image->frame_count, 3);
+    }
+
+    void TearDown() override {
+        qp_close_image(image);
+        QuantumPainter::TearDown();
+    }
+
+    void advance_frame() {
+        advance_time(50);
+        qp_internal_task();
+    }
+};
+
+TEST_F(QuantumPainterAnimation, DeltaFramesOnlySendChangedRegion) {
+    deferred_token token = qp_animate(host.device(), 8, 8, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(host.stats().pixels, 16 * 16);
+    EXPECT_EQ(host.lit_pixels(8, 8, 23, 23), 16);
+
+    host.reset_stats();
+    advance_frame();
+    EXPECT_EQ(host.stats().pixels, 4 * 4);
+    EXPECT_EQ(host.lit_pixels(8 + 2, 8 + 10, 8 + 5, 8 + 13), 16);
+
+    host.reset_stats();
+    advance_frame();
+    EXPECT_EQ(host.stats().pixels, 2 * 2);
+    EXPECT_EQ(host.lit_pixels(8 + 12, 8 + 2, 8 + 13, 8 + 3), 4);
+
+    qp_stop_animation(token);
+}
+
+TEST_F(QuantumPainterAnimation, SurfaceAnimationMatchesDirectAnimation) {
+    PainterHost    keyframe{16, 16};
+    PainterHost    direct{kWidth, kHeight};
+    deferred_token via_surface = qp_animate_via_surface(host.device(), keyframe.device(), 8, 8, image);
+    deferred_token direct_anim = qp_animate(direct.device(), 8, 8, image);
+    ASSERT_NE(via_surface, INVALID_DEFERRED_TOKEN);
+    ASSERT_NE(direct_anim, INVALID_DEFERRED_TOKEN);
+    const std::vector<std::pair<uint16_t, char>> legend = {{0x0000, '.'}, {0xFFFF, '#'}};
+    EXPECT_TRUE(frames_match(host.to_text(legend), direct.to_text(legend)));
+
+    for (int i = 0; i < 5; ++i) {
+        advance_frame();
+        EXPECT_TRUE(frames_match(host.to_text(legend), direct.to_text(legend))) << "frame " << i + 1;
+    }
+
+    qp_stop_animation(via_surface);
+    qp_stop_animation(direct_anim);
+}
+
+TEST_F(QuantumPainterAnimation, SurfaceAnimationOnlySendsChangedPixels) {
+    PainterHost    keyframe{16, 16};
+    deferred_token token = qp_animate_via_surface(host.device(), keyframe.device(), 8, 8, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(host.stats().pixels, 16 * 16);
+
+    host.reset_stats();
+    advance_frame();
+    EXPECT_EQ(host.stats().pixels, 4 * 4);
+
+    host.reset_stats();
+    advance_frame();
+    EXPECT_EQ(host.stats().pixels, 2 * 2);
+
+    // Looping back to the keyframe only resends the area the delta frames touched, rather than the whole 16x16 frame
+    host.reset_stats();
+    advance_frame();
+    EXPECT_EQ(host.stats().pixels, 12 * 12);
+    EXPECT_EQ(host.lit_pixels(8, 8, 23, 23), 16);
+
+    qp_stop_animation(token);
+}
+
+TEST_F(QuantumPainterAnimation, SurfaceAnimationRejectsMismatchedSurface) {
+    surface_painter_device_t mono{};
+    uint8_t                  buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(16, 16, 1)] = {0};
+    painter_device_t         surface = qp_make_mono1bpp_surface_advanced(&mono, 1, 16, 16, buffer);
+    ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+
+    EXPECT_EQ(qp_animate_via_surface(host.device(), surface, 8, 8, image), INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(host.stats().pixels, 0);
+}
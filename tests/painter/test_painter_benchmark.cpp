@@ -0,0 +1,197 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+#include "gtest/gtest.h"
+#include "painter_host.hpp"
+
+extern "C" {
+#include "qgf.h"
+void advance_time(uint32_t ms);
+void qp_internal_task(void);
+}
+
+// Reports pixel throughput and panel traffic for each drawing primitive and image codec. Host timings are only
+// comparable against other runs on the same machine, so they're printed rather than asserted -- compare the output
+// before and after a change instead. The panel traffic doesn't depend on the host though, so every operation is checked
+// against a budget of pixels, transfers and viewport changes, and sending more than that fails the test. Set
+// QP_BENCHMARK_ITERATIONS to trade runtime for stability.
+class QuantumPainterBenchmark : public ::testing::Test {
+   protected:
+    static constexpr uint16_t kWidth  = 128;
+    static constexpr uint16_t kHeight = 128;
+
+    // Upper bounds on the panel traffic of a single operation
+    struct Budget {
+        uint32_t pixels;
+        uint32_t transfers;
+        uint32_t viewports;
+    };
+
+    PainterHost host{kWidth, kHeight};
+    uint32_t    iterations = 20;
+
+    void SetUp() override {
+        const char *env = getenv("QP_BENCHMARK_ITERATIONS");
+        if (env && atoi(env) > 0) {
+            iterations = atoi(env);
+        }
+    }
+
+    void measure(const char *name, size_t input_bytes, const Budget &budget, const std::function<bool(uint32_t)> &op, uint32_t count = 0) {
+        if (count == 0) {
+            count = iterations;
+        }
+
+        host.reset_stats();
+        PainterHost::Stats before  = host.stats();
+        double             seconds = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            ASSERT_TRUE(op(i)) << name;
+            seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            const PainterHost::Stats &after = host.stats();
+            EXPECT_LE(after.pixels - before.pixels, budget.pixels) << name << " (op " << i << ")";
+            EXPECT_LE(after.transfers - before.transfers, budget.transfers) << name << " (op " << i << ")";
+            EXPECT_LE(after.viewports - before.viewports, budget.viewports) << name << " (op " << i << ")";
+            before = after;
+        }
+
+        const PainterHost::Stats &stats = host.stats();
+        printf("%-28s %12.0f px/s %10.1f bytes/op %8.1f transfers/op %8.1f viewports/op %8zu input bytes\n", name, seconds > 0 ? stats.pixels / seconds : 0.0, (double)stats.bytes / count, (double)stats.transfers / count, (double)stats.viewports / count, input_bytes);
+    }
+
+    static std::vector<uint16_t> make_gradient(uint16_t levels, bool native) {
+        std::vector<uint16_t> values;
+        for (uint16_t y = 0; y < kHeight; ++y) {
+            for (uint16_t x = 0; x < kWidth; ++x) {
+                values.push_back(native ? (uint16_t)((x >> 2) << 11 | (y >> 1) << 5 | ((x + y) >> 3)) : (x / 8 + y / 8) % levels);
+            }
+        }
+        return values;
+    }
+};
+
+TEST_F(QuantumPainterBenchmark, Primitives) {
+    // Each pixel of a filled shape is only sent once, and lines and outlines use one viewport per straight run
+    measure("rect (filled)", 0, {kWidth * kHeight, 32, 1}, [&](uint32_t i) { return qp_rect(host.device(), 0, 0, kWidth - 1, kHeight - 1, i, 255, 255, true); });
+    measure("rect (outline)", 0, {2 * kWidth + 2 * kHeight - 4, 4, 4}, [&](uint32_t i) { return qp_rect(host.device(), 0, 0, kWidth - 1, kHeight - 1, i, 255, 255, false); });
+    measure("line (diagonal)", 0, {kWidth, kWidth, kWidth}, [&](uint32_t i) { return qp_line(host.device(), 0, 0, kWidth - 1, kHeight - 1, i, 255, 255); });
+    measure("line (horizontal)", 0, {kWidth, 1, 1}, [&](uint32_t i) { return qp_line(host.device(), 0, 5, kWidth - 1, 5, i, 255, 255); });
+    measure("circle (filled)", 0, {12789, 169, 169}, [&](uint32_t i) { return qp_circle(host.device(), 64, 64, 60, i, 255, 255, true); });
+    measure("circle (outline)", 0, {336, 336, 336}, [&](uint32_t i) { return qp_circle(host.device(), 64, 64, 60, i, 255, 255, false); });
+    measure("ellipse (filled)", 0, {8987, 135, 135}, [&](uint32_t i) { return qp_ellipse(host.device(), 64, 64, 60, 30, i, 255, 255, true); });
+}
+
+TEST_F(QuantumPainterBenchmark, Images) {
+    struct {
+        const char       *name;
+        qp_image_format_t format;
+    } formats[] = {
+        {"mono2", GRAYSCALE_1BPP}, {"mono4", GRAYSCALE_2BPP}, {"mono16", GRAYSCALE_4BPP}, {"mono256", GRAYSCALE_8BPP}, {"pal2", PALETTE_1BPP}, {"pal4", PALETTE_2BPP}, {"pal16", PALETTE_4BPP}, {"pal256", PALETTE_8BPP}, {"rgb565", RGB565_16BPP},
+    };
+
+    for (auto &f : formats) {
+        uint8_t bpp;
+        bool    has_palette, is_panel_native;
+        qgf_parse_format(f.format, &bpp, &has_palette, &is_panel_native);
+        const uint16_t levels = is_panel_native ? 0 : (1 << bpp);
+
+        for (auto compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+            QgfFrameSpec frame{};
+            frame.format      = f.format;
+            frame.compression = compression;
+            frame.values      = make_gradient(levels, is_panel_native);
+            for (uint16_t i = 0; has_palette && i < levels; ++i) {
+                frame.palette.push_back({(uint8_t)(i * 256 / levels), 255, 255});
+            }
+
+            std::vector<uint8_t>   qgf   = qp_test_make_qgf(kWidth, kHeight, {frame});
+            painter_image_handle_t image = qp_load_image_mem(qgf.data());
+            ASSERT_NE(image, nullptr);
+
+            char name[32];
+            snprintf(name, sizeof(name), "image %s %s", f.name, compression == IMAGE_COMPRESSED_RLE ? "rle" : "raw");
+            measure(name, qgf.size(), {kWidth * kHeight, 32, 1}, [&](uint32_t) { return qp_drawimage(host.device(), 0, 0, image); });
+            qp_close_image(image);
+        }
+    }
+}
+
+TEST_F(QuantumPainterBenchmark, Text) {
+    for (auto format : {GRAYSCALE_1BPP, GRAYSCALE_4BPP}) {
+        for (auto compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+            // Synthetic glyphs: a 6x12 box with a diagonal stroke, which is roughly the density of a real font
+            std::vector<std::vector<uint16_t>> glyphs;
+            std::vector<uint8_t>               widths;
+            for (uint8_t n = 0; n < 95; ++n) {
+                std::vector<uint16_t> glyph(6 * 12, 0);
+                for (uint8_t y = 0; y < 12; ++y) {
+                    glyph[y * 6 + 0]           = format == GRAYSCALE_1BPP ? 1 : 15;
+                    glyph[y * 6 + (y + n) % 6] = format == GRAYSCALE_1BPP ? 1 : 8;
+                }
+                glyphs.push_back(glyph);
+                widths.push_back(6);
+            }
+
+            std::vector<uint8_t>  qff  = qp_test_make_qff(12, format, compression, glyphs, widths);
+            painter_font_handle_t font = qp_load_font_mem(qff.data());
+            ASSERT_NE(font, nullptr);
+
+            char name[32];
+            snprintf(name, sizeof(name), "text %s %s", format == GRAYSCALE_1BPP ? "mono2" : "mono16", compression == IMAGE_COMPRESSED_RLE ? "rle" : "raw");
+            measure(name, qff.size(), {25 * 6 * 12, 25, 25}, [&](uint32_t) { return qp_drawtext(host.device(), 0, 0, font, "The quick brown fox jumps") > 0; });
+            qp_close_font(font);
+        }
+    }
+}
+
+TEST_F(QuantumPainterBenchmark, AnimationFrames) {
+    // A spinner-like animation: a static background with a small block moving each frame, stored as delta frames
+    std::vector<QgfFrameSpec> frames;
+    for (uint16_t n = 0; n < 8; ++n) {
+        QgfFrameSpec frame{};
+        frame.format      = PALETTE_4BPP;
+        frame.compression = IMAGE_COMPRESSED_RLE;
+        frame.delay       = 10;
+        for (uint16_t i = 0; i < 16; ++i) {
+            frame.palette.push_back({(uint8_t)(i * 16), 255, 255});
+        }
+        if (n == 0) {
+            frame.values = make_gradient(16, false);
+        } else {
+            frame.is_delta = true;
+            frame.left     = 8 * n;
+            frame.top      = 8 * n;
+            frame.right    = 8 * n + 15;
+            frame.bottom   = 8 * n + 15;
+            frame.values.assign(16 * 16, n);
+        }
+        frames.push_back(frame);
+    }
+
+    std::vector<uint8_t>   qgf   = qp_test_make_qgf(kWidth, kHeight, frames);
+    painter_image_handle_t image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+
+    measure("animation keyframe", qgf.size(), {kWidth * kHeight, 32, 1}, [&](uint32_t) { return qp_drawimage(host.device(), 0, 0, image); });
+
+    // One pass over the delta frames, stopping short of looping back to the keyframe
+    deferred_token token = qp_animate(host.device(), 0, 0, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    measure(
+        "animation delta frame", qgf.size(), {16 * 16, 1, 1},
+        [&](uint32_t) {
+            advance_time(10);
+            qp_internal_task();
+            return true;
+        },
+        frames.size() - 1);
+    qp_stop_animation(token);
+    qp_close_image(image);
+}
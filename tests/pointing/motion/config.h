@@ -0,0 +1,13 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define POINTING_DEVICE_ACCEL_ENABLE
+#define POINTING_DEVICE_ACCEL_CURVE {{0, 128}, {8, 128}, {16, 512}}
+#define POINTING_DEVICE_DRAG_SCROLL_DIVISOR_H 10
+#define POINTING_DEVICE_DRAG_SCROLL_DIVISOR_V 10
+#define POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#define POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER 8
@@ -0,0 +1,114 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+extern "C" {
+#include "usb_device_state.h"
+}
+
+using testing::_;
+
+class PointingMotion : public TestFixture {
+   protected:
+    void TearDown() override {
+        // Toggling drag scroll drops any remainder carried over from the test
+        pointing_device_set_drag_scroll(true);
+        pointing_device_set_drag_scroll(false);
+        usb_device_state_set_resolution_multiplier(0);
+        pd_clear_movement();
+        TestFixture::TearDown();
+    }
+};
+
+TEST_F(PointingMotion, SlowMovementKeepsSubCountRemainder) {
+    TestDriver driver;
+
+    // Gain is 0.5 at low speed, so every other report carries a whole count
+    pd_set_x(1);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_MOUSE_REPORT(driver, (1, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotion, AccelerationCurveIsInterpolated) {
+    TestDriver driver;
+
+    // Speed 12 sits halfway between the 0.5 and 2.0 points of the curve
+    pd_set_x(12);
+    EXPECT_MOUSE_REPORT(driver, (15, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Beyond the last point the gain holds at 2.0
+    pd_set_x(-40);
+    EXPECT_MOUSE_REPORT(driver, (-80, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotion, DragScrollCarriesResidual) {
+    TestDriver driver;
+
+    pointing_device_set_drag_scroll(true);
+
+    // 4 counts per report against 10 counts per detent
+    pd_set_y(4);
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 12 counts -- one detent with 2 counts left over
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 10 counts including the left over ones
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotion, DragScrollUsesHighResolutionUnits) {
+    TestDriver driver;
+
+    pointing_device_set_drag_scroll(true);
+    usb_device_state_set_resolution_multiplier(0x05);
+
+    // 5 counts at 8 units per 10 counts
+    pd_set_x(5);
+    pd_set_y(5);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 4, 4, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMotion, WheelIsScaledForHighResolutionHost) {
+    TestDriver driver;
+
+    pd_set_v(1);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 1, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    usb_device_state_set_resolution_multiplier(0x01);
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, 8, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,79 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+#include "mouse_report_util.hpp"
+#include "test_common.hpp"
+#include "test_pointing_device_driver.h"
+
+using testing::_;
+
+class PointingMousekeys : public TestFixture {
+   protected:
+    void TearDown() override {
+        pd_clear_movement();
+        TestFixture::TearDown();
+    }
+};
+
+TEST_F(PointingMousekeys, MotionIsMergedIntoPointingReport) {
+    TestDriver driver;
+    KeymapKey  accel_key = KeymapKey{0, 0, 0, QK_MOUSE_ACCELERATION_2};
+    KeymapKey  mouse_key = KeymapKey{0, 1, 0, QK_MOUSE_CURSOR_RIGHT};
+
+    set_keymap({accel_key, mouse_key});
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    accel_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The step of the initial press goes out with the pointing device report of the same scan
+    pd_set_x(5);
+    EXPECT_MOUSE_REPORT(driver, (6, 0, 0, 0, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The pointing device task runs first, so each report carries the frame integrated by the previous scan
+    EXPECT_MOUSE_REPORT(driver, (5, 0, 0, 0, 0));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 3 pixels per frame on top of the sensor, still a single report per scan
+    EXPECT_MOUSE_REPORT(driver, (8, 0, 0, 0, 0)).Times(2);
+    run_one_scan_loop();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    pd_clear_movement();
+    EXPECT_MOUSE_REPORT(driver, (3, 0, 0, 0, 0)).Times(2);
+    run_one_scan_loop();
+    mouse_key.release();
+    accel_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(PointingMousekeys, MotionWithoutSensorInput) {
+    TestDriver driver;
+    KeymapKey  mouse_key = KeymapKey{0, 0, 0, QK_MOUSE_WHEEL_DOWN};
+
+    set_keymap({mouse_key});
+
+    EXPECT_MOUSE_REPORT(driver, (0, 0, 0, -1, 0));
+    mouse_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_NO_MOUSE_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+
+    mouse_key.release();
+    run_one_scan_loop();
+}
@@ -0,0 +1 @@
+RAW_HID_STREAM_ENABLE = yes
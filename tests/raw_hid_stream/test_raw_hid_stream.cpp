@@ -0,0 +1,194 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "raw_hid.h"
+#include "raw_hid_stream.h"
+}
+
+namespace {
+constexpr uint8_t    kReportSize = 64;
+constexpr uint8_t    kSource     = RAW_HID_STREAM_SOURCE_KB;
+std::vector<uint8_t> source_data;
+std::vector<uint8_t> sent_reports;
+bool                 send_ready = true;
+size_t               send_capacity;
+
+void read_source(uint32_t offset, uint8_t size, uint8_t *data) {
+    memcpy(data, &source_data[offset], size);
+}
+} // namespace
+
+extern "C" {
+void raw_hid_send(uint8_t *data, uint8_t length) {
+    EXPECT_EQ(length, kReportSize);
+    sent_reports.insert(sent_reports.end(), data, data + length);
+    send_capacity--;
+}
+
+bool raw_hid_send_ready(void) {
+    return send_ready && send_capacity > 0;
+}
+
+bool raw_hid_stream_get_source_user(uint8_t id, raw_hid_stream_source_t *source) {
+    if (id != kSource) {
+        return false;
+    }
+    source->size = source_data.size();
+    source->read = read_source;
+    return true;
+}
+}
+
+class RawHidStream : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        source_data.clear();
+        for (int i = 0; i < 1000; i++) {
+            source_data.push_back(i * 7);
+        }
+        sent_reports.clear();
+        send_ready    = true;
+        send_capacity = SIZE_MAX;
+    }
+
+    void TearDown() override {
+        uint8_t report[kReportSize] = {RAW_HID_STREAM_COMMAND_ID, RAW_HID_STREAM_OP_ABORT};
+        raw_hid_stream_receive(report, kReportSize);
+    }
+
+    size_t sent_count() {
+        return sent_reports.size() / kReportSize;
+    }
+
+    const uint8_t *sent(size_t index) {
+        return &sent_reports[index * kReportSize];
+    }
+
+    void request_read(uint32_t offset, uint32_t length, uint8_t window) {
+        uint8_t report[kReportSize];
+        raw_hid_stream_build_read(report, kReportSize, kSource, offset, length, window);
+        EXPECT_TRUE(raw_hid_stream_receive(report, kReportSize));
+    }
+
+    // Feeds everything sent so far into the reader, acknowledging as requested
+    raw_hid_stream_reader_result_t drain(raw_hid_stream_reader_t *reader, std::vector<uint8_t> *received) {
+        raw_hid_stream_reader_result_t result = RAW_HID_STREAM_READER_DATA;
+        std::vector<uint8_t>           reports;
+        reports.swap(sent_reports);
+        for (size_t i = 0; i < reports.size(); i += kReportSize) {
+            const uint8_t *payload;
+            uint8_t        length;
+            result = raw_hid_stream_reader_feed(reader, &reports[i], kReportSize, &payload, &length);
+            if (result == RAW_HID_STREAM_READER_ERROR || result == RAW_HID_STREAM_READER_IGNORED) {
+                return result;
+            }
+            received->insert(received->end(), payload, payload + length);
+            if (result == RAW_HID_STREAM_READER_ACK) {
+                uint8_t ack[kReportSize];
+                raw_hid_stream_reader_build_ack(reader, ack, kReportSize);
+                EXPECT_TRUE(raw_hid_stream_receive(ack, kReportSize));
+            }
+        }
+        return result;
+    }
+};
+
+TEST_F(RawHidStream, OtherReportsAreNotConsumed) {
+    uint8_t report[kReportSize] = {0x01};
+    EXPECT_FALSE(raw_hid_stream_receive(report, kReportSize));
+    EXPECT_EQ(sent_count(), 0);
+}
+
+TEST_F(RawHidStream, InfoReportsSourceSize) {
+    uint8_t report[kReportSize] = {RAW_HID_STREAM_COMMAND_ID, RAW_HID_STREAM_OP_INFO, kSource};
+    EXPECT_TRUE(raw_hid_stream_receive(report, kReportSize));
+    ASSERT_EQ(sent_count(), 1);
+    EXPECT_EQ(sent(0)[3], RAW_HID_STREAM_STATUS_OK);
+    EXPECT_EQ(raw_hid_stream_read_u32(&sent(0)[4]), 1000);
+    EXPECT_EQ(sent(0)[8], RAW_HID_STREAM_PAYLOAD_SIZE(kReportSize));
+}
+
+TEST_F(RawHidStream, UnwindowedReadSendsEverything) {
+    raw_hid_stream_reader_t reader;
+    std::vector<uint8_t>    received;
+
+    request_read(100, 500, 0);
+    raw_hid_stream_reader_init(&reader, 500, 0);
+    raw_hid_stream_task();
+
+    EXPECT_EQ(sent_count(), (500 + RAW_HID_STREAM_PAYLOAD_SIZE(kReportSize) - 1) / RAW_HID_STREAM_PAYLOAD_SIZE(kReportSize));
+    EXPECT_EQ(drain(&reader, &received), RAW_HID_STREAM_READER_DONE);
+    EXPECT_EQ(received, std::vector<uint8_t>(source_data.begin() + 100, source_data.begin() + 600));
+    EXPECT_FALSE(raw_hid_stream_is_active());
+}
+
+TEST_F(RawHidStream, WindowedReadWaitsForAcknowledgement) {
+    raw_hid_stream_reader_t reader;
+    std::vector<uint8_t>    received;
+
+    request_read(0, 1000, 4);
+    raw_hid_stream_reader_init(&reader, 1000, 4);
+
+    raw_hid_stream_task();
+    EXPECT_EQ(sent_count(), 4);
+    raw_hid_stream_task();
+    EXPECT_EQ(sent_count(), 4);
+
+    raw_hid_stream_reader_result_t result;
+    do {
+        result = drain(&reader, &received);
+        raw_hid_stream_task();
+    } while (result != RAW_HID_STREAM_READER_DONE && result != RAW_HID_STREAM_READER_ERROR);
+
+    EXPECT_EQ(result, RAW_HID_STREAM_READER_DONE);
+    EXPECT_EQ(received, source_data);
+}
+
+TEST_F(RawHidStream, StopsWhenEndpointIsBusy) {
+    request_read(0, 1000, 0);
+    send_capacity = 3;
+    raw_hid_stream_task();
+    EXPECT_EQ(sent_count(), 3);
+
+    send_ready    = false;
+    send_capacity = SIZE_MAX;
+    raw_hid_stream_task();
+    EXPECT_EQ(sent_count(), 3);
+    EXPECT_TRUE(raw_hid_stream_is_active());
+}
+
+TEST_F(RawHidStream, StaleAcknowledgementIsIgnored) {
+    request_read(0, 1000, 4);
+    raw_hid_stream_task();
+    ASSERT_EQ(sent_count(), 4);
+
+    // Acknowledging a report that hasn't been sent yet must not open the window
+    uint8_t ack[kReportSize] = {RAW_HID_STREAM_COMMAND_ID, RAW_HID_STREAM_OP_ACK, 10};
+    raw_hid_stream_receive(ack, kReportSize);
+    raw_hid_stream_task();
+    EXPECT_EQ(sent_count(), 4);
+
+    ack[2] = 1;
+    raw_hid_stream_receive(ack, kReportSize);
+    raw_hid_stream_task();
+    EXPECT_EQ(sent_count(), 6);
+}
+
+TEST_F(RawHidStream, OutOfRangeReadFails) {
+    raw_hid_stream_reader_t reader;
+    std::vector<uint8_t>    received;
+
+    request_read(900, 200, 0);
+    raw_hid_stream_reader_init(&reader, 200, 0);
+    raw_hid_stream_task();
+
+    ASSERT_EQ(sent_count(), 1);
+    EXPECT_EQ(sent(0)[5], RAW_HID_STREAM_STATUS_OUT_OF_RANGE);
+    EXPECT_EQ(drain(&reader, &received), RAW_HID_STREAM_READER_ERROR);
+    EXPECT_FALSE(raw_hid_stream_is_active());
+}
@@ -199,6 +199,10 @@ void protocol_pre_task(void) {
         /* Woken up */
     }
 #endif
+
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_sync_task();
+#endif
 }
 
 void protocol_post_task(void) {
@@ -320,6 +320,16 @@ bool usb_endpoint_in_is_inactive(usb_endpoint_in_t *endpoint) {
     return inactive;
 }
 
+bool usb_endpoint_in_has_space(usb_endpoint_in_t *endpoint) {
+    osalDbgCheck(endpoint != NULL);
+
+    osalSysLock();
+    bool has_space = usbGetDriverStateI(endpoint->config.usbp) == USB_ACTIVE && !obqIsFullI(&endpoint->obqueue);
+    osalSysUnlock();
+
+    return has_space;
+}
+
 bool usb_endpoint_out_receive(usb_endpoint_out_t *endpoint, uint8_t *data, size_t size, sysinterval_t timeout) {
     osalDbgCheck((endpoint != NULL) && (data != NULL) && (size > 0U));
 
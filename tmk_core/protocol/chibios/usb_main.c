@@ -26,6 +26,9 @@
 #    include "led.h"
 #endif
 #include "wait.h"
+#ifdef USB_SOF_SYNC_ENABLE
+#    include "debug.h"
+#endif
 #include "usb_endpoints.h"
 #include "usb_device_state.h"
 #include "usb_descriptor.h"
@@ -226,6 +229,124 @@ static void usb_event_cb(USBDriver *usbp, usbevent_t event) {
     }
 }
 
+/* ---------------------------------------------------------
+ *                 Start-of-Frame synchronisation
+ * ---------------------------------------------------------
+ */
+
+#ifdef USB_SOF_SYNC_ENABLE
+
+/* Duration of a full speed USB frame */
+#    define USB_FRAME_US 1000
+
+#    if USB_SOF_SYNC_LEAD_US >= USB_FRAME_US
+#        error "USB_SOF_SYNC_LEAD_US must be less than a USB frame (1000us)"
+#    endif
+
+static volatile systime_t usb_last_sof_time;
+static systime_t          usb_sampled_sof_time;
+
+static systime_t       report_submit_time[USB_ENDPOINT_IN_COUNT];
+static bool            report_pending[USB_ENDPOINT_IN_COUNT];
+static usb_sof_stats_t report_stats[USB_ENDPOINT_IN_COUNT];
+
+/*
+ * Called from interrupt context at the start of every USB frame. The age of
+ * each report submitted since the previous frame is recorded, this is how long
+ * it waited in the endpoint before the host could have collected it.
+ */
+static void usb_sof_cb(USBDriver *usbp) {
+    (void)usbp;
+
+    osalSysLockFromISR();
+    systime_t now     = chVTGetSystemTimeX();
+    usb_last_sof_time = now;
+    for (int i = 0; i < USB_ENDPOINT_IN_COUNT; i++) {
+        if (report_pending[i]) {
+            uint32_t age_us = TIME_I2US(chTimeDiffX(report_submit_time[i], now));
+            report_stats[i].reports++;
+            report_stats[i].total_age_us += age_us;
+            if (age_us > report_stats[i].max_age_us) {
+                report_stats[i].max_age_us = age_us;
+            }
+            report_pending[i] = false;
+        }
+    }
+    osalSysUnlockFromISR();
+}
+
+static void usb_sof_record_report(usb_endpoint_in_lut_t endpoint) {
+    osalSysLock();
+    report_submit_time[endpoint] = chVTGetSystemTimeX();
+    report_pending[endpoint]     = true;
+    osalSysUnlock();
+}
+
+bool usb_sof_get_stats(usb_endpoint_in_lut_t endpoint, usb_sof_stats_t *stats, bool reset) {
+    if (endpoint >= USB_ENDPOINT_IN_COUNT || stats == NULL) {
+        return false;
+    }
+
+    osalSysLock();
+    *stats = report_stats[endpoint];
+    if (reset) {
+        memset(&report_stats[endpoint], 0, sizeof(usb_sof_stats_t));
+    }
+    osalSysUnlock();
+    return true;
+}
+
+static void usb_sof_print_stats(void) {
+#    if USB_SOF_SYNC_STATS_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (!debug_enable || timer_elapsed32(last_print) < USB_SOF_SYNC_STATS_INTERVAL) {
+        return;
+    }
+    last_print = timer_read32();
+
+    for (int i = 0; i < USB_ENDPOINT_IN_COUNT; i++) {
+        usb_sof_stats_t stats;
+        if (usb_sof_get_stats(i, &stats, true) && stats.reports > 0) {
+            dprintf("usb sof: ep %d: %lu reports, age avg %luus max %luus\n", i, stats.reports, stats.total_age_us / stats.reports, stats.max_age_us);
+        }
+    }
+#    endif // USB_SOF_SYNC_STATS_INTERVAL > 0
+}
+
+void usb_sof_sync_task(void) {
+    usb_sof_print_stats();
+
+    if (USB_DRIVER.state != USB_ACTIVE) {
+        return;
+    }
+
+    osalSysLock();
+    systime_t     sof   = usb_last_sof_time;
+    sysinterval_t since = chTimeDiffX(sof, chVTGetSystemTimeX());
+    osalSysUnlock();
+
+    // Without a recent SOF there's nothing to synchronise to, so keep running freely
+    if (since > TIME_US2I(USB_FRAME_US)) {
+        return;
+    }
+
+    // Sample once per frame, USB_SOF_SYNC_LEAD_US before the next SOF. If this
+    // frame's sample has already been taken, wait for the next frame's.
+    sysinterval_t sample_point = TIME_US2I(USB_FRAME_US - USB_SOF_SYNC_LEAD_US);
+    if (sof == usb_sampled_sof_time) {
+        sample_point += TIME_US2I(USB_FRAME_US);
+    }
+    if (since < sample_point) {
+        chThdSleep(sample_point - since);
+    }
+
+    osalSysLock();
+    usb_sampled_sof_time = usb_last_sof_time;
+    osalSysUnlock();
+}
+
+#endif // USB_SOF_SYNC_ENABLE
+
 /*
  * Appendix G: HID Request Support Requirements
  *
@@ -254,6 +375,26 @@ static void set_led_transfer_cb(USBDriver *usbp) {
     }
 }
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+static void set_resolution_multiplier_transfer_cb(USBDriver *usbp) {
+    usb_control_request_t *setup = (usb_control_request_t *)usbp->setup;
+
+#    ifdef MOUSE_SHARED_EP
+    if (setup->wLength == 2 && set_report_buf[0] == REPORT_ID_MOUSE) {
+        usb_device_state_set_resolution_multiplier(set_report_buf[1]);
+    }
+#    else
+    if (setup->wLength == 1) {
+        usb_device_state_set_resolution_multiplier(set_report_buf[0]);
+    }
+#    endif
+}
+
+static bool is_resolution_multiplier_request(usb_control_request_t *setup) {
+    return setup->wIndex == MOUSE_REPORT_INTERFACE && setup->wValue.hbyte == USB_HID_REPORT_TYPE_FEATURE;
+}
+#endif
+
 static bool usb_requests_hook_cb(USBDriver *usbp) {
     usb_control_request_t *setup = (usb_control_request_t *)usbp->setup;
 
@@ -263,6 +404,20 @@ static bool usb_requests_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_DEV2HOST:
                 switch (setup->bRequest) {
                     case HID_REQ_GetReport:
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                        if (is_resolution_multiplier_request(setup)) {
+                            static uint8_t _Alignas(4) resolution_multiplier_report[2];
+#    ifdef MOUSE_SHARED_EP
+                            resolution_multiplier_report[0] = REPORT_ID_MOUSE;
+                            resolution_multiplier_report[1] = usb_device_state_get_resolution_multiplier();
+                            usbSetupTransfer(usbp, resolution_multiplier_report, 2, NULL);
+#    else
+                            resolution_multiplier_report[0] = usb_device_state_get_resolution_multiplier();
+                            usbSetupTransfer(usbp, resolution_multiplier_report, 1, NULL);
+#    endif
+                            return true;
+                        }
+#endif
                         return usb_get_report_cb(usbp);
                     case HID_REQ_GetProtocol:
                         if (setup->wIndex == KEYBOARD_INTERFACE) {
@@ -280,6 +435,12 @@ static bool usb_requests_hook_cb(USBDriver *usbp) {
             case USB_RTYPE_DIR_HOST2DEV:
                 switch (setup->bRequest) {
                     case HID_REQ_SetReport:
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                        if (is_resolution_multiplier_request(setup)) {
+                            usbSetupTransfer(usbp, set_report_buf, sizeof(set_report_buf), set_resolution_multiplier_transfer_cb);
+                            return true;
+                        }
+#endif
                         switch (setup->wIndex) {
                             case KEYBOARD_INTERFACE:
 #if defined(SHARED_EP_ENABLE) && !defined(KEYBOARD_SHARED_EP)
@@ -329,6 +490,9 @@ static const USBConfig usbcfg = {
     usb_event_cb,          /* USB events callback */
     usb_get_descriptor_cb, /* Device GET_DESCRIPTOR request callback */
     usb_requests_hook_cb,  /* Requests hook callback */
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_cb, /* Start of frame callback */
+#endif
 };
 
 void init_usb_driver(USBDriver *usbp) {
@@ -398,6 +562,9 @@ __attribute__((weak)) void restart_usb_driver(USBDriver *usbp) {
  * @return false Failure
  */
 bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size) {
+#ifdef USB_SOF_SYNC_ENABLE
+    usb_sof_record_report(endpoint);
+#endif
     return usb_endpoint_in_send(&usb_endpoints_in[endpoint], (uint8_t *)report, size, TIME_MS2I(100), false);
 }
 
@@ -522,6 +689,10 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     send_report(USB_ENDPOINT_IN_RAW, data, length);
 }
 
+bool raw_hid_send_ready(void) {
+    return usb_endpoint_in_has_space(&usb_endpoints_in[USB_ENDPOINT_IN_RAW]);
+}
+
 __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage
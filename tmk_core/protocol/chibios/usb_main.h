@@ -34,6 +34,37 @@ void restart_usb_driver(USBDriver *usbp);
 
 bool send_report(usb_endpoint_in_lut_t endpoint, void *report, size_t size);
 
+/* ----------------------------
+ * Start-of-Frame synchronisation
+ * ----------------------------
+ */
+
+#ifdef USB_SOF_SYNC_ENABLE
+
+/* How long before the next USB frame the matrix and pointing devices are sampled */
+#    ifndef USB_SOF_SYNC_LEAD_US
+#        define USB_SOF_SYNC_LEAD_US 250
+#    endif
+
+/* How often report latency statistics are printed to the console while debugging, 0 to disable */
+#    ifndef USB_SOF_SYNC_STATS_INTERVAL
+#        define USB_SOF_SYNC_STATS_INTERVAL 5000
+#    endif
+
+typedef struct {
+    uint32_t reports;      // Reports submitted
+    uint32_t total_age_us; // Sum of the time each report waited for the next start of frame
+    uint32_t max_age_us;   // Longest time a report waited for the next start of frame
+} usb_sof_stats_t;
+
+/* Waits until the sample point before the next USB frame, called on the main thread before each keyboard task */
+void usb_sof_sync_task(void);
+
+/* Retrieves the report latency statistics of an IN endpoint, optionally resetting them */
+bool usb_sof_get_stats(usb_endpoint_in_lut_t endpoint, usb_sof_stats_t *stats, bool reset);
+
+#endif
+
 /* ---------------
  * USB Event queue
  * ---------------
@@ -35,6 +35,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #    include "outputselect.h"
 #endif
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+#    include "usb_device_state.h"
+#endif
+
 #ifdef NKRO_ENABLE
 #    include "keycode_config.h"
 extern keymap_config_t keymap_config;
@@ -129,6 +133,20 @@ void host_mouse_send(report_mouse_t *report) {
     (*driver->send_mouse)(report);
 }
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+uint8_t host_mouse_wheel_multiplier(bool horizontal) {
+#    ifdef BLUETOOTH_ENABLE
+    if (where_to_send() == OUTPUT_BLUETOOTH) {
+        return 1;
+    }
+#    endif
+
+    // The vertical multiplier occupies bits 0-1 of the feature report, the horizontal one bits 2-3
+    uint8_t resolution_multiplier = usb_device_state_get_resolution_multiplier();
+    return (resolution_multiplier & (horizontal ? 0x04 : 0x01)) ? POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER : 1;
+}
+#endif
+
 void host_system_send(uint16_t usage) {
     if (usage == last_system_usage) return;
     last_system_usage = usage;
@@ -41,6 +41,11 @@ void    host_system_send(uint16_t usage);
 void    host_consumer_send(uint16_t usage);
 void    host_programmable_button_send(uint32_t data);
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+/* wheel units per detent the host currently expects, 1 unless it has enabled high resolution scrolling */
+uint8_t host_mouse_wheel_multiplier(bool horizontal);
+#endif
+
 uint16_t host_last_system_usage(void);
 uint16_t host_last_consumer_usage(void);
 
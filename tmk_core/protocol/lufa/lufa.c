@@ -136,6 +136,20 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     send_report(RAW_IN_EPNUM, data, RAW_EPSIZE);
 }
 
+/** \brief Raw HID Send Ready
+ *
+ * Whether the IN endpoint has a free bank, so that raw_hid_send() won't have to wait for the host.
+ */
+bool raw_hid_send_ready(void) {
+    if (USB_DeviceState != DEVICE_STATE_Configured) return false;
+
+    uint8_t ep = Endpoint_GetCurrentEndpoint();
+    Endpoint_SelectEndpoint(RAW_IN_EPNUM);
+    bool ready = Endpoint_IsReadWriteAllowed();
+    Endpoint_SelectEndpoint(ep);
+    return ready;
+}
+
 /** \brief Raw HID Receive
  *
  * FIXME: Needs doc
@@ -415,6 +429,20 @@ void EVENT_USB_Device_ControlRequest(void) {
             if (USB_ControlRequest.bmRequestType == (REQDIR_DEVICETOHOST | REQTYPE_CLASS | REQREC_INTERFACE)) {
                 Endpoint_ClearSETUP();
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                static uint8_t resolution_multiplier_report[2];
+                if (USB_ControlRequest.wIndex == MOUSE_REPORT_INTERFACE && (USB_ControlRequest.wValue >> 8) == USB_HID_REPORT_TYPE_FEATURE) {
+#    ifdef MOUSE_SHARED_EP
+                    resolution_multiplier_report[0] = REPORT_ID_MOUSE;
+                    resolution_multiplier_report[1] = usb_device_state_get_resolution_multiplier();
+                    ReportSize                      = 2;
+#    else
+                    resolution_multiplier_report[0] = usb_device_state_get_resolution_multiplier();
+                    ReportSize                      = 1;
+#    endif
+                    ReportData = resolution_multiplier_report;
+                } else
+#endif
                 // Interface
                 switch (USB_ControlRequest.wIndex) {
                     case KEYBOARD_INTERFACE:
@@ -432,6 +460,27 @@ void EVENT_USB_Device_ControlRequest(void) {
             break;
         case HID_REQ_SetReport:
             if (USB_ControlRequest.bmRequestType == (REQDIR_HOSTTODEVICE | REQTYPE_CLASS | REQREC_INTERFACE)) {
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+                if (USB_ControlRequest.wIndex == MOUSE_REPORT_INTERFACE && (USB_ControlRequest.wValue >> 8) == USB_HID_REPORT_TYPE_FEATURE) {
+                    Endpoint_ClearSETUP();
+
+                    while (!(Endpoint_IsOUTReceived())) {
+                        if (USB_DeviceState == DEVICE_STATE_Unattached) return;
+                    }
+
+#    ifdef MOUSE_SHARED_EP
+                    if (Endpoint_BytesInEndpoint() == 2 && Endpoint_Read_8() == REPORT_ID_MOUSE) {
+                        usb_device_state_set_resolution_multiplier(Endpoint_Read_8());
+                    }
+#    else
+                    usb_device_state_set_resolution_multiplier(Endpoint_Read_8());
+#    endif
+
+                    Endpoint_ClearOUT();
+                    Endpoint_ClearStatusStage();
+                    break;
+                }
+#endif
                 // Interface
                 switch (USB_ControlRequest.wIndex) {
                     case KEYBOARD_INTERFACE:
@@ -120,13 +120,22 @@ void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code) {
 }
 
 #ifdef NKRO_ENABLE
+_Static_assert(NKRO_REPORT_BITS <= 32, "NKRO change tracking holds one bit per report byte");
+
+// One bit per byte of the NKRO bitmap that has been modified since the last call to take_nkro_bits_changed()
+static uint32_t nkro_bits_changed = 0;
+
 /** \brief add key bit
  *
  * FIXME: Needs doc
  */
 void add_key_bit(report_nkro_t* nkro_report, uint8_t code) {
     if ((code >> 3) < NKRO_REPORT_BITS) {
-        nkro_report->bits[code >> 3] |= 1 << (code & 7);
+        uint8_t bits = nkro_report->bits[code >> 3] | 1 << (code & 7);
+        if (bits != nkro_report->bits[code >> 3]) {
+            nkro_report->bits[code >> 3] = bits;
+            nkro_bits_changed |= (uint32_t)1 << (code >> 3);
+        }
     } else {
         dprintf("add_key_bit: can't add: %02X\n", code);
     }
@@ -138,11 +147,33 @@ void add_key_bit(report_nkro_t* nkro_report, uint8_t code) {
  */
 void del_key_bit(report_nkro_t* nkro_report, uint8_t code) {
     if ((code >> 3) < NKRO_REPORT_BITS) {
-        nkro_report->bits[code >> 3] &= ~(1 << (code & 7));
+        uint8_t bits = nkro_report->bits[code >> 3] & ~(1 << (code & 7));
+        if (bits != nkro_report->bits[code >> 3]) {
+            nkro_report->bits[code >> 3] = bits;
+            nkro_bits_changed |= (uint32_t)1 << (code >> 3);
+        }
     } else {
         dprintf("del_key_bit: can't del: %02X\n", code);
     }
 }
+
+/** \brief Flags bytes of the NKRO bitmap as modified
+ *
+ * Code that writes to the bitmap directly, rather than through add_key_bit() and del_key_bit(), must call this so the change gets sent.
+ */
+void mark_nkro_bits_changed(uint8_t first, uint8_t count) {
+    for (uint8_t i = first; i < first + count && i < NKRO_REPORT_BITS; i++) {
+        nkro_bits_changed |= (uint32_t)1 << i;
+    }
+}
+
+/** \brief Returns the bytes of the NKRO bitmap modified since the previous call, one bit per byte
+ */
+uint32_t take_nkro_bits_changed(void) {
+    uint32_t changed  = nkro_bits_changed;
+    nkro_bits_changed = 0;
+    return changed;
+}
 #endif
 
 /** \brief add key to report
@@ -181,7 +212,12 @@ void clear_keys_from_report(void) {
     // not clear mods
 #ifdef NKRO_ENABLE
     if (usb_device_state_get_protocol() == USB_PROTOCOL_REPORT && keymap_config.nkro) {
-        memset(nkro_report->bits, 0, sizeof(nkro_report->bits));
+        for (uint8_t i = 0; i < NKRO_REPORT_BITS; i++) {
+            if (nkro_report->bits[i]) {
+                nkro_report->bits[i] = 0;
+                mark_nkro_bits_changed(i, 1);
+            }
+        }
         return;
     }
 #endif
@@ -205,6 +205,20 @@ typedef int16_t mouse_hv_report_t;
 typedef int8_t mouse_hv_report_t;
 #endif
 
+#ifdef POINTING_DEVICE_HIRES_SCROLL_ENABLE
+// Wheel units per detent once the host has enabled the HID Resolution Multiplier
+#    ifndef POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER
+#        ifdef WHEEL_EXTENDED_REPORT
+#            define POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER 120
+#        else
+#            define POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER 8
+#        endif
+#    endif
+#    if POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER < 2 || POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER > 255
+#        error "POINTING_DEVICE_HIRES_SCROLL_MULTIPLIER must be between 2 and 255"
+#    endif
+#endif
+
 typedef struct {
 #ifdef MOUSE_SHARED_EP
     uint8_t report_id;
@@ -339,8 +353,10 @@ bool    is_key_pressed(uint8_t key);
 void add_key_byte(report_keyboard_t* keyboard_report, uint8_t code);
 void del_key_byte(report_keyboard_t* keyboard_report, uint8_t code);
 #ifdef NKRO_ENABLE
-void add_key_bit(report_nkro_t* nkro_report, uint8_t code);
-void del_key_bit(report_nkro_t* nkro_report, uint8_t code);
+void     add_key_bit(report_nkro_t* nkro_report, uint8_t code);
+void     del_key_bit(report_nkro_t* nkro_report, uint8_t code);
+void     mark_nkro_bits_changed(uint8_t first, uint8_t count);
+uint32_t take_nkro_bits_changed(void);
 #endif
 
 void add_key_to_report(uint8_t key);
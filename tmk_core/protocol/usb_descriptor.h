@@ -198,6 +198,19 @@ enum usb_interfaces {
 
 #define IS_VALID_INTERFACE(i) ((i) >= 0 && (i) < TOTAL_INTERFACES)
 
+#if defined(MOUSE_ENABLE) && defined(MOUSE_SHARED_EP)
+#    define MOUSE_REPORT_INTERFACE SHARED_INTERFACE
+#elif defined(MOUSE_ENABLE)
+#    define MOUSE_REPORT_INTERFACE MOUSE_INTERFACE
+#endif
+
+/*
+ * HID report types, as carried in the high byte of wValue by GET_REPORT/SET_REPORT
+ */
+#define USB_HID_REPORT_TYPE_INPUT 0x01
+#define USB_HID_REPORT_TYPE_OUTPUT 0x02
+#define USB_HID_REPORT_TYPE_FEATURE 0x03
+
 #define NEXT_EPNUM __COUNTER__
 
 /*
@@ -286,7 +299,13 @@ enum usb_endpoints {
 #define KEYBOARD_EPSIZE 8
 #define SHARED_EPSIZE 32
 #define MOUSE_EPSIZE 16
-#define RAW_EPSIZE 32
+// Raw HID report size, 64 is the largest interrupt packet at full speed. VIA Configurator expects 32.
+#ifndef RAW_EPSIZE
+#    define RAW_EPSIZE 32
+#endif
+#if RAW_EPSIZE < 16 || RAW_EPSIZE > 64
+#    error "RAW_EPSIZE must be between 16 and 64"
+#endif
 #define CONSOLE_EPSIZE 32
 #define MIDI_STREAM_EPSIZE 64
 #define CDC_NOTIFICATION_EPSIZE 8
@@ -138,7 +138,9 @@ static void send_report(uint8_t endpoint, void *report, size_t size) {
  * RAW HID
  *------------------------------------------------------------------*/
 #ifdef RAW_ENABLE
+// V-USB reports are always 32 bytes, sent as 8 byte packets
 #    define RAW_BUFFER_SIZE 32
+#    undef RAW_EPSIZE
 #    define RAW_EPSIZE 8
 
 static uint8_t raw_output_buffer[RAW_BUFFER_SIZE];
@@ -152,6 +154,10 @@ void raw_hid_send(uint8_t *data, uint8_t length) {
     send_report(4, data, 32);
 }
 
+bool raw_hid_send_ready(void) {
+    return usbConfiguration && usbInterruptIsReady4();
+}
+
 __attribute__((weak)) void raw_hid_receive(uint8_t *data, uint8_t length) {
     // Users should #include "raw_hid.h" in their own code
     // and implement this function there. Leave this as weak linkage